@@ -165,6 +165,11 @@ void BenchmarkRunner::RunBenchmark(Benchmark *benchmark) {
 					break;
 				} else {
 					LogResult(std::to_string(profiler.Elapsed()));
+					auto metrics = benchmark->GetMetrics(state.get());
+					if (!metrics.empty()) {
+						Log(metrics);
+						LogOutput(metrics);
+					}
 				}
 			}
 		}
@@ -187,6 +192,8 @@ void print_help() {
 	fprintf(stderr, "              --detailed-profile     Prints detailed query profile information\n");
 	fprintf(stderr, "              --threads=n            Sets the amount of threads to use during execution (default: "
 	                "hardware concurrency)\n");
+	fprintf(stderr, "              --clients=n            Sets the amount of clients in concurrent benchmarks (default:"
+	                " specified by the benchmark)\n");
 	fprintf(stderr, "              --out=[file]           Move benchmark output to file\n");
 	fprintf(stderr, "              --log=[file]           Move log output to file\n");
 	fprintf(stderr, "              --info                 Prints info about the benchmark\n");
@@ -235,6 +242,9 @@ void parse_arguments(const int arg_counter, char const *const *arg_values) {
 			// write info of benchmark
 			auto splits = StringUtil::Split(arg, '=');
 			instance.threads = Value(splits[1]).CastAs(LogicalType::UINTEGER).GetValue<uint32_t>();
+		} else if (StringUtil::StartsWith(arg, "--clients=")) {
+			auto splits = StringUtil::Split(arg, '=');
+			instance.clients = Value(splits[1]).CastAs(LogicalType::UINTEGER).GetValue<uint32_t>();
 		} else if (arg == "--query") {
 			// write group of benchmark
 			instance.configuration.meta = BenchmarkMetaType::QUERY;
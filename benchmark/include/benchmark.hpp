@@ -78,6 +78,10 @@ public:
 	}
 
 	virtual string GetLogOutput(BenchmarkState *state) = 0;
+	//! Returns additional metrics of the last run (if any), one tab-separated line per metric group
+	virtual string GetMetrics(BenchmarkState *state) {
+		return string();
+	}
 
 	//! Whether or not Initialize() should be called once for every run or just
 	//! once
@@ -53,6 +53,8 @@ public:
 	ofstream out_file;
 	ofstream log_file;
 	uint32_t threads = std::thread::hardware_concurrency();
+	//! The amount of clients used by concurrent benchmarks (0 = the amount specified by the benchmark)
+	uint32_t clients = 0;
 };
 
 } // namespace duckdb
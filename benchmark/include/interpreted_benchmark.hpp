@@ -12,6 +12,7 @@
 #include <unordered_set>
 
 namespace duckdb {
+struct InterpretedBenchmarkState;
 
 //! Interpreted benchmarks read the benchmark from a file
 class InterpretedBenchmark : public Benchmark {
@@ -35,6 +36,9 @@ public:
 	string BenchmarkInfo() override;
 
 	string GetLogOutput(BenchmarkState *state) override;
+	//! Returns the throughput and latency percentiles per query class of a concurrent benchmark, and the spilled
+	//! bytes and peak memory of a benchmark with a memory limit
+	string GetMetrics(BenchmarkState *state) override;
 
 	string DisplayName() override;
 	string Group() override;
@@ -50,12 +54,27 @@ public:
 		return require_reinit;
 	}
 
+	//! Whether or not this benchmark runs a mix of query classes on multiple concurrent clients
+	bool IsConcurrent() {
+		return !query_classes.empty();
+	}
+
+private:
+	//! Runs the query classes of a concurrent benchmark on all clients
+	void RunConcurrent(InterpretedBenchmarkState &state);
+
 private:
 	bool is_loaded = false;
 	std::unordered_map<string, string> replacement_mapping;
 
 	std::unordered_map<string, string> queries;
 	string run_query;
+	//! The query classes of a concurrent benchmark (name, query), in order of definition
+	vector<std::pair<string, string>> query_classes;
+	//! The amount of concurrent clients of a concurrent benchmark
+	size_t client_count = 4;
+	//! The amount of queries every client runs in a single run of a concurrent benchmark
+	size_t client_iterations = 10;
 
 	string benchmark_path;
 	string data_cache;
@@ -69,6 +88,8 @@ private:
 
 	bool in_memory = true;
 	bool require_reinit = false;
+	//! The memory limit the benchmark runs under (if any), set after the data is loaded
+	string memory_limit;
 };
 
 } // namespace duckdb
@@ -2,14 +2,17 @@
 
 #include "benchmark_runner.hpp"
 #include "duckdb.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/extension_helper.hpp"
 #include "duckdb/main/query_profiler.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 #include "test_helpers.hpp"
 
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 namespace duckdb {
 
@@ -38,6 +41,18 @@ struct InterpretedBenchmarkState : public BenchmarkState {
 	DuckDB db;
 	Connection con;
 	unique_ptr<MaterializedQueryResult> result;
+	//! The connections of the clients of a concurrent benchmark
+	vector<unique_ptr<Connection>> clients;
+	//! The latencies (in seconds) of the queries of every query class in the last run of a concurrent benchmark
+	vector<vector<double>> latencies;
+	//! The wall time of the last run of a concurrent benchmark
+	double elapsed = 0;
+	//! The first error encountered by any of the clients in the last run of a concurrent benchmark
+	string error;
+	//! The bytes written to and read from temporary files and the peak memory in the last run
+	idx_t temporary_bytes_written = 0;
+	idx_t temporary_bytes_read = 0;
+	idx_t peak_memory = 0;
 
 	explicit InterpretedBenchmarkState(string path)
 	    : benchmark_config(GetBenchmarkConfig()), db(path.empty() ? nullptr : path.c_str(), benchmark_config.get()),
@@ -88,6 +103,40 @@ private:
 	unordered_map<std::string, std::string> replacements;
 };
 
+//! Reads the query of a command: either the lines following the command up to a blank line, or the given file
+static string ReadQuery(BenchmarkFileReader &reader, const string &command, const string &file_path) {
+	// keep reading until we find a blank line or EOF
+	string query;
+	string line;
+	while (reader.ReadLine(line)) {
+		if (line.empty()) {
+			break;
+		} else {
+			query += line + " ";
+		}
+	}
+	if (!file_path.empty()) {
+		// read entire file into query
+		std::ifstream file(file_path, std::ios::ate);
+		std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+		if (size < 0) {
+			throw std::runtime_error("Failed to read " + command + " from file " + file_path);
+		}
+
+		auto buffer = unique_ptr<char[]>(new char[size]);
+		if (!file.read(buffer.get(), size)) {
+			throw std::runtime_error("Failed to read " + command + " from file " + file_path);
+		}
+		query = string(buffer.get(), size);
+	}
+	StringUtil::Trim(query);
+	if (query.empty()) {
+		throw std::runtime_error("Encountered an empty " + command + " node!");
+	}
+	return query;
+}
+
 InterpretedBenchmark::InterpretedBenchmark(string full_path)
     : Benchmark(true, full_path, ParseGroupFromPath(full_path)), benchmark_path(full_path) {
 	replacement_mapping["BENCHMARK_DIR"] = BenchmarkRunner::DUCKDB_BENCHMARK_DIRECTORY;
@@ -110,35 +159,37 @@ void InterpretedBenchmark::LoadBenchmark() {
 			if (queries.find(splits[0]) != queries.end()) {
 				throw std::runtime_error("Multiple calls to " + splits[0] + " in the same benchmark file");
 			}
-			// load command: keep reading until we find a blank line or EOF
-			string query;
-			while (reader.ReadLine(line)) {
-				if (line.empty()) {
-					break;
-				} else {
-					query += line + " ";
-				}
+			queries[splits[0]] = ReadQuery(reader, splits[0], splits.size() > 1 ? splits[1] : string());
+		} else if (splits[0] == "query") {
+			// query class of a concurrent benchmark: query [class_name] [optional file]
+			if (splits.size() < 2 || splits.size() > 3 || splits[1].empty()) {
+				throw std::runtime_error(reader.FormatException("query requires a class name and an optional file"));
 			}
-			if (splits.size() > 1 && !splits[1].empty()) {
-				// read entire file into query
-				std::ifstream file(splits[1], std::ios::ate);
-				std::streamsize size = file.tellg();
-				file.seekg(0, std::ios::beg);
-				if (size < 0) {
-					throw std::runtime_error("Failed to read " + splits[0] + " from file " + splits[1]);
-				}
-
-				auto buffer = unique_ptr<char[]>(new char[size]);
-				if (!file.read(buffer.get(), size)) {
-					throw std::runtime_error("Failed to read " + splits[0] + " from file " + splits[1]);
+			for (auto &query_class : query_classes) {
+				if (query_class.first == splits[1]) {
+					throw std::runtime_error(reader.FormatException("duplicate query class " + splits[1]));
 				}
-				query = string(buffer.get(), size);
 			}
-			StringUtil::Trim(query);
-			if (query.empty()) {
-				throw std::runtime_error("Encountered an empty " + splits[0] + " node!");
+			auto query = ReadQuery(reader, splits[0], splits.size() > 2 ? splits[2] : string());
+			query_classes.push_back(make_pair(splits[1], move(query)));
+		} else if (splits[0] == "clients" || splits[0] == "iterations") {
+			if (splits.size() != 2) {
+				throw std::runtime_error(reader.FormatException(splits[0] + " requires a single parameter"));
 			}
-			queries[splits[0]] = query;
+			auto count = std::stoull(splits[1]);
+			if (count == 0) {
+				throw std::runtime_error(reader.FormatException(splits[0] + " must be bigger than 0"));
+			}
+			if (splits[0] == "clients") {
+				client_count = count;
+			} else {
+				client_iterations = count;
+			}
+		} else if (splits[0] == "memory_limit") {
+			if (splits.size() != 2) {
+				throw std::runtime_error(reader.FormatException("memory_limit requires a single parameter"));
+			}
+			memory_limit = splits[1];
 		} else if (splits[0] == "require") {
 			if (splits.size() != 2) {
 				throw std::runtime_error(reader.FormatException("require requires a single parameter"));
@@ -265,7 +316,18 @@ void InterpretedBenchmark::LoadBenchmark() {
 			throw std::runtime_error(reader.FormatException("unrecognized command " + splits[0]));
 		}
 	}
+	if (!memory_limit.empty() && in_memory) {
+		throw Exception("Invalid benchmark file: memory_limit requires persistent storage, transient storage cannot "
+		                "spill to disk");
+	}
 	// set up the queries
+	if (IsConcurrent()) {
+		if (queries.find("run") != queries.end() || result_column_count != 0) {
+			throw Exception("Invalid benchmark file: query classes cannot be combined with \"run\" or \"result\"");
+		}
+		is_loaded = true;
+		return;
+	}
 	if (queries.find("run") == queries.end()) {
 		throw Exception("Invalid benchmark file: no \"run\" query specified");
 	}
@@ -320,6 +382,20 @@ unique_ptr<BenchmarkState> InterpretedBenchmark::Initialize(BenchmarkConfigurati
 		}
 		result = move(result->next);
 	}
+	if (!memory_limit.empty()) {
+		// the data is loaded without limit, only the benchmark queries run under the memory limit
+		result = state->con.Query("PRAGMA memory_limit='" + memory_limit + "'");
+		if (!result->success) {
+			throw Exception(result->error);
+		}
+	}
+	if (IsConcurrent()) {
+		auto &instance = BenchmarkRunner::GetInstance();
+		idx_t clients = instance.clients > 0 ? instance.clients : client_count;
+		for (idx_t i = 0; i < clients; i++) {
+			state->clients.push_back(make_unique<Connection>(state->db));
+		}
+	}
 	if (config.profile_info == BenchmarkProfileInfo::NORMAL) {
 		state->con.Query("PRAGMA enable_profiling");
 	} else if (config.profile_info == BenchmarkProfileInfo::DETAILED) {
@@ -331,12 +407,90 @@ unique_ptr<BenchmarkState> InterpretedBenchmark::Initialize(BenchmarkConfigurati
 
 string InterpretedBenchmark::GetQuery() {
 	LoadBenchmark();
+	if (IsConcurrent()) {
+		string result;
+		for (auto &query_class : query_classes) {
+			result += "-- " + query_class.first + "\n" + query_class.second + "\n";
+		}
+		return result;
+	}
 	return run_query;
 }
 
+//! Runs the given query and all statements following it, returns the first error (if any)
+static string RunClientQuery(Connection &con, const string &query) {
+	unique_ptr<QueryResult> result = con.Query(query);
+	while (result) {
+		if (!result->success) {
+			return result->error;
+		}
+		result = move(result->next);
+	}
+	return string();
+}
+
 void InterpretedBenchmark::Run(BenchmarkState *state_p) {
 	auto &state = (InterpretedBenchmarkState &)*state_p;
-	state.result = state.con.Query(run_query);
+	auto &buffer_manager = BufferManager::GetBufferManager(*state.db.instance);
+	auto bytes_written = buffer_manager.GetTemporaryBytesWritten();
+	auto bytes_read = buffer_manager.GetTemporaryBytesRead();
+	buffer_manager.ResetPeakMemory();
+	if (IsConcurrent()) {
+		RunConcurrent(state);
+	} else {
+		state.result = state.con.Query(run_query);
+	}
+	state.temporary_bytes_written = buffer_manager.GetTemporaryBytesWritten() - bytes_written;
+	state.temporary_bytes_read = buffer_manager.GetTemporaryBytesRead() - bytes_read;
+	state.peak_memory = buffer_manager.GetPeakMemory();
+}
+
+void InterpretedBenchmark::RunConcurrent(InterpretedBenchmarkState &state) {
+	// every client runs client_iterations queries, cycling through the query classes starting at its own offset
+	// this way all query classes run concurrently with each other
+	auto class_count = query_classes.size();
+	auto connection_count = state.clients.size();
+	vector<vector<vector<double>>> client_latencies(connection_count, vector<vector<double>>(class_count));
+	vector<string> client_errors(connection_count);
+	vector<std::thread> threads;
+
+	Profiler profiler;
+	profiler.Start();
+	for (idx_t client_idx = 0; client_idx < connection_count; client_idx++) {
+		threads.emplace_back([&, client_idx]() {
+			auto &con = *state.clients[client_idx];
+			for (idx_t i = 0; i < client_iterations; i++) {
+				auto class_idx = (client_idx + i) % class_count;
+				Profiler query_profiler;
+				query_profiler.Start();
+				auto error = RunClientQuery(con, query_classes[class_idx].second);
+				query_profiler.End();
+				if (!error.empty()) {
+					client_errors[client_idx] = query_classes[class_idx].first + ": " + error;
+					return;
+				}
+				client_latencies[client_idx][class_idx].push_back(query_profiler.Elapsed());
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	profiler.End();
+
+	state.elapsed = profiler.Elapsed();
+	state.error = string();
+	state.latencies.clear();
+	state.latencies.resize(class_count);
+	for (idx_t client_idx = 0; client_idx < connection_count; client_idx++) {
+		if (state.error.empty()) {
+			state.error = client_errors[client_idx];
+		}
+		for (idx_t class_idx = 0; class_idx < class_count; class_idx++) {
+			auto &latencies = client_latencies[client_idx][class_idx];
+			state.latencies[class_idx].insert(state.latencies[class_idx].end(), latencies.begin(), latencies.end());
+		}
+	}
 }
 
 void InterpretedBenchmark::Cleanup(BenchmarkState *state_p) {
@@ -366,6 +520,9 @@ string InterpretedBenchmark::GetDatabasePath() {
 
 string InterpretedBenchmark::Verify(BenchmarkState *state_p) {
 	auto &state = (InterpretedBenchmarkState &)*state_p;
+	if (IsConcurrent()) {
+		return state.error;
+	}
 	if (!state.result->success) {
 		return state.result->error;
 	}
@@ -417,6 +574,9 @@ string InterpretedBenchmark::Verify(BenchmarkState *state_p) {
 void InterpretedBenchmark::Interrupt(BenchmarkState *state_p) {
 	auto &state = (InterpretedBenchmarkState &)*state_p;
 	state.con.Interrupt();
+	for (auto &client : state.clients) {
+		client->Interrupt();
+	}
 }
 
 string InterpretedBenchmark::BenchmarkInfo() {
@@ -425,10 +585,58 @@ string InterpretedBenchmark::BenchmarkInfo() {
 
 string InterpretedBenchmark::GetLogOutput(BenchmarkState *state_p) {
 	auto &state = (InterpretedBenchmarkState &)*state_p;
+	if (IsConcurrent()) {
+		return string();
+	}
 	auto &profiler = QueryProfiler::Get(*state.con.context);
 	return profiler.ToJSON();
 }
 
+//! The amount of latencies of a query class that are required to report their 99th percentile
+static constexpr idx_t MINIMUM_P99_SAMPLES = 100;
+
+//! Returns the given percentile of a sorted list of latencies (nearest-rank)
+static double LatencyPercentile(const vector<double> &sorted_latencies, idx_t percentile) {
+	D_ASSERT(!sorted_latencies.empty());
+	idx_t rank = (percentile * sorted_latencies.size() + 99) / 100;
+	return sorted_latencies[MaxValue<idx_t>(rank, 1) - 1];
+}
+
+string InterpretedBenchmark::GetMetrics(BenchmarkState *state_p) {
+	auto &state = (InterpretedBenchmarkState &)*state_p;
+	string result;
+	if (!memory_limit.empty()) {
+		result += StringUtil::Format("%s\tmemory_limit=%s\tpeak_memory=%llu\ttemp_written=%llu\ttemp_read=%llu\n", name,
+		                             memory_limit, (uint64_t)state.peak_memory,
+		                             (uint64_t)state.temporary_bytes_written, (uint64_t)state.temporary_bytes_read);
+	}
+	if (!IsConcurrent() || state.elapsed <= 0) {
+		return result;
+	}
+	idx_t total_count = 0;
+	for (idx_t class_idx = 0; class_idx < query_classes.size(); class_idx++) {
+		auto latencies = state.latencies[class_idx];
+		if (latencies.empty()) {
+			continue;
+		}
+		std::sort(latencies.begin(), latencies.end());
+		total_count += latencies.size();
+		result += StringUtil::Format("%s\tclass=%s\tclients=%llu\tqueries=%llu\tthroughput=%f\tp50=%f", name,
+		                             query_classes[class_idx].first, (uint64_t)state.clients.size(),
+		                             (uint64_t)latencies.size(), double(latencies.size()) / state.elapsed,
+		                             LatencyPercentile(latencies, 50));
+		// with fewer samples, the 99th percentile is just the maximum
+		if (latencies.size() >= MINIMUM_P99_SAMPLES) {
+			result += StringUtil::Format("\tp99=%f", LatencyPercentile(latencies, 99));
+		}
+		result += StringUtil::Format("\tmax=%f\n", latencies.back());
+	}
+	result += StringUtil::Format("%s\tclass=total\tclients=%llu\tqueries=%llu\tthroughput=%f\n", name,
+	                             (uint64_t)state.clients.size(), (uint64_t)total_count,
+	                             double(total_count) / state.elapsed);
+	return result;
+}
+
 string InterpretedBenchmark::DisplayName() {
 	LoadBenchmark();
 	return display_name.empty() ? name : display_name;
@@ -0,0 +1,5 @@
+DROP TABLE IF EXISTS facts;
+DROP TABLE IF EXISTS dimension;
+CREATE TABLE facts AS SELECT i, (i * 7919) % 10000000 AS k, i % 1000 AS g, i % 1000000 AS d, 'payload-' || (i % 100000) AS s FROM range(0, 20000000) tbl(i);
+CREATE TABLE dimension AS SELECT i AS d, i % 10 AS category, 'dimension-' || i AS name FROM range(0, 1000000) tbl(i);
+CHECKPOINT;
@@ -0,0 +1,353 @@
+#include "http_block_cache.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+namespace duckdb {
+
+HTTPBlockCache::HTTPBlockCache()
+    : memory_hits(0), disk_hits(0), misses(0), local_fs(FileSystem::CreateLocal()), memory_usage(0), disk_usage(0),
+      temporary_file_count(0) {
+}
+
+shared_ptr<HTTPBlockCache> HTTPBlockCache::Get(ClientContext &context) {
+	auto cache = ObjectCache::GetObjectCache(context).Get<HTTPBlockCache>(ObjectType());
+	if (!cache) {
+		throw InternalException("The HTTP block cache was not registered by the httpfs extension");
+	}
+	return cache;
+}
+
+static HTTPBlockCache &GetCacheForSetting(ClientContext &context, SetScope scope, const string &name) {
+	if (scope == SetScope::SESSION) {
+		throw InvalidInputException("The HTTP block cache is shared by all connections: use SET GLOBAL %s", name);
+	}
+	return *HTTPBlockCache::Get(context);
+}
+
+void HTTPBlockCache::SetMemoryLimit(ClientContext &context, SetScope scope, Value &parameter) {
+	auto &cache = GetCacheForSetting(context, scope, "http_block_cache_size");
+	auto new_params = cache.GetParams();
+	new_params.memory_limit = parameter.IsNull() ? 0 : DBConfig::ParseMemoryLimit(parameter.GetValue<string>());
+	cache.Configure(new_params);
+}
+
+void HTTPBlockCache::SetDirectory(ClientContext &context, SetScope scope, Value &parameter) {
+	auto &cache = GetCacheForSetting(context, scope, "http_block_cache_directory");
+	auto new_params = cache.GetParams();
+	new_params.directory = parameter.IsNull() ? string() : parameter.GetValue<string>();
+	cache.Configure(new_params);
+}
+
+void HTTPBlockCache::SetDiskLimit(ClientContext &context, SetScope scope, Value &parameter) {
+	auto &cache = GetCacheForSetting(context, scope, "http_block_cache_disk_size");
+	auto new_params = cache.GetParams();
+	new_params.disk_limit = parameter.IsNull() ? HTTPBlockCacheParams::DEFAULT_DISK_CACHE_SIZE
+	                                           : DBConfig::ParseMemoryLimit(parameter.GetValue<string>());
+	cache.Configure(new_params);
+}
+
+struct HTTPBlockCacheStatsData : public FunctionOperatorData {
+	HTTPBlockCacheStatsData() : finished(false) {
+	}
+
+	bool finished;
+};
+
+static unique_ptr<FunctionData> HTTPBlockCacheStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                        vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("memory_hits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("disk_hits");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("misses");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("memory_usage");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("disk_usage");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	return nullptr;
+}
+
+static unique_ptr<FunctionOperatorData> HTTPBlockCacheStatsInit(ClientContext &context, const FunctionData *bind_data,
+                                                                const vector<column_t> &column_ids,
+                                                                TableFilterCollection *filters) {
+	return make_unique<HTTPBlockCacheStatsData>();
+}
+
+static void HTTPBlockCacheStatsFunction(ClientContext &context, const FunctionData *bind_data,
+                                        FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &data = (HTTPBlockCacheStatsData &)*operator_state;
+	if (data.finished) {
+		return;
+	}
+	auto cache = HTTPBlockCache::Get(context);
+	output.SetCardinality(1);
+	output.data[0].SetValue(0, Value::UBIGINT(cache->memory_hits));
+	output.data[1].SetValue(0, Value::UBIGINT(cache->disk_hits));
+	output.data[2].SetValue(0, Value::UBIGINT(cache->misses));
+	output.data[3].SetValue(0, Value::UBIGINT(cache->MemoryUsage()));
+	output.data[4].SetValue(0, Value::UBIGINT(cache->DiskUsage()));
+	data.finished = true;
+}
+
+TableFunction HTTPBlockCache::GetStatsFunction() {
+	return TableFunction("http_block_cache_stats", {}, HTTPBlockCacheStatsFunction, HTTPBlockCacheStatsBind,
+	                     HTTPBlockCacheStatsInit);
+}
+
+HTTPBlockCacheParams HTTPBlockCache::GetParams() {
+	lock_guard<mutex> glock(lock);
+	return params;
+}
+
+void HTTPBlockCache::Configure(const HTTPBlockCacheParams &new_params) {
+	DiskWork work;
+	{
+		lock_guard<mutex> glock(lock);
+		if (new_params.directory != params.directory) {
+			// the disk cache moved: forget about the blocks in the old directory (but leave them on disk)
+			disk_blocks.clear();
+			disk_lru.clear();
+			disk_usage = 0;
+			if (!new_params.directory.empty() && !local_fs->DirectoryExists(new_params.directory)) {
+				local_fs->CreateDirectory(new_params.directory);
+			}
+		}
+		params = new_params;
+		work.directory = params.directory;
+		EvictMemory(params.memory_limit, work);
+		EvictDisk(params.directory.empty() ? 0 : params.disk_limit, work);
+	}
+	PerformDiskWork(work);
+}
+
+bool HTTPBlockCache::Enabled() {
+	lock_guard<mutex> glock(lock);
+	return params.memory_limit > 0;
+}
+
+string HTTPBlockCache::GetKey(const string &url, const string &validator, idx_t block_offset) {
+	return url + '\0' + validator + '\0' + std::to_string(block_offset);
+}
+
+string HTTPBlockCache::GetDiskPath(const string &directory, const string &key) {
+	auto hash = Hash(key.c_str(), key.size());
+	return local_fs->JoinPath(directory, std::to_string(hash) + ".block");
+}
+
+shared_ptr<HTTPCachedBlock> HTTPBlockCache::Get(const string &url, const string &validator, idx_t block_offset) {
+	auto key = GetKey(url, validator, block_offset);
+	string directory;
+	{
+		lock_guard<mutex> glock(lock);
+		auto entry = memory_blocks.find(key);
+		if (entry != memory_blocks.end()) {
+			// move the block to the front of the LRU list
+			memory_lru.splice(memory_lru.begin(), memory_lru, entry->second.lru_position);
+			memory_hits++;
+			return entry->second.block;
+		}
+		directory = params.directory;
+	}
+	if (directory.empty()) {
+		misses++;
+		return nullptr;
+	}
+	// the block is read without holding the lock, so reads of other blocks are not held up by the disk
+	idx_t file_size;
+	auto block = ReadFromDisk(directory, key, file_size);
+	if (!block) {
+		misses++;
+		return nullptr;
+	}
+	disk_hits++;
+	DiskWork work;
+	{
+		lock_guard<mutex> glock(lock);
+		if (directory != params.directory) {
+			// the cache was reconfigured while we were reading
+			return block;
+		}
+		work.directory = directory;
+		TrackDiskBlock(key, file_size, work);
+		if (params.memory_limit > 0 && memory_blocks.find(key) == memory_blocks.end()) {
+			// promote the block back into memory
+			memory_lru.push_front(key);
+			memory_blocks[key] = MemoryEntry {block, memory_lru.begin()};
+			memory_usage += block->size;
+			EvictMemory(params.memory_limit, work);
+		}
+	}
+	PerformDiskWork(work);
+	return block;
+}
+
+void HTTPBlockCache::Put(const string &url, const string &validator, idx_t block_offset,
+                         shared_ptr<HTTPCachedBlock> block) {
+	auto key = GetKey(url, validator, block_offset);
+	DiskWork work;
+	{
+		lock_guard<mutex> glock(lock);
+		if (params.memory_limit == 0 || memory_blocks.find(key) != memory_blocks.end()) {
+			return;
+		}
+		memory_usage += block->size;
+		memory_lru.push_front(key);
+		memory_blocks[key] = MemoryEntry {move(block), memory_lru.begin()};
+		work.directory = params.directory;
+		EvictMemory(params.memory_limit, work);
+	}
+	PerformDiskWork(work);
+}
+
+idx_t HTTPBlockCache::MemoryUsage() {
+	lock_guard<mutex> glock(lock);
+	return memory_usage;
+}
+
+idx_t HTTPBlockCache::DiskUsage() {
+	lock_guard<mutex> glock(lock);
+	return disk_usage;
+}
+
+void HTTPBlockCache::EvictMemory(idx_t limit, DiskWork &work) {
+	while (memory_usage > limit && !memory_lru.empty()) {
+		auto &key = memory_lru.back();
+		auto entry = memory_blocks.find(key);
+		D_ASSERT(entry != memory_blocks.end());
+		auto &block = entry->second.block;
+		idx_t file_size = sizeof(idx_t) + key.size() + block->size;
+		if (!params.directory.empty() && file_size <= params.disk_limit &&
+		    disk_blocks.find(key) == disk_blocks.end()) {
+			work.writes.emplace_back(key, block);
+		}
+		memory_usage -= block->size;
+		memory_blocks.erase(entry);
+		memory_lru.pop_back();
+	}
+}
+
+void HTTPBlockCache::EvictDisk(idx_t limit, DiskWork &work) {
+	while (disk_usage > limit && !disk_lru.empty()) {
+		auto entry = disk_blocks.find(disk_lru.back());
+		D_ASSERT(entry != disk_blocks.end());
+		work.removals.push_back(GetDiskPath(params.directory, entry->first));
+		disk_usage -= entry->second.size;
+		disk_lru.pop_back();
+		disk_blocks.erase(entry);
+	}
+}
+
+void HTTPBlockCache::TrackDiskBlock(const string &key, idx_t file_size, DiskWork &work) {
+	auto entry = disk_blocks.find(key);
+	if (entry != disk_blocks.end()) {
+		disk_lru.splice(disk_lru.begin(), disk_lru, entry->second.lru_position);
+		return;
+	}
+	// the block was just written, or it was written by an earlier process: start tracking it
+	disk_lru.push_front(key);
+	disk_blocks[key] = DiskEntry {file_size, disk_lru.begin()};
+	disk_usage += file_size;
+	EvictDisk(params.disk_limit, work);
+}
+
+void HTTPBlockCache::PerformDiskWork(DiskWork &work) {
+	while (!work.removals.empty() || !work.writes.empty()) {
+		for (auto &path : work.removals) {
+			try {
+				local_fs->RemoveFile(path);
+			} catch (std::exception &ex) {
+				// the file was already removed externally
+			}
+		}
+		work.removals.clear();
+		auto writes = move(work.writes);
+		work.writes.clear();
+		for (auto &write : writes) {
+			auto file_size = WriteToDisk(work.directory, write.first, *write.second);
+			if (file_size == 0) {
+				continue;
+			}
+			// tracking the block can evict other blocks from the disk cache: their removal is handled by the next
+			// iteration
+			lock_guard<mutex> glock(lock);
+			if (work.directory == params.directory) {
+				TrackDiskBlock(write.first, file_size, work);
+			}
+		}
+	}
+}
+
+// Every block file starts with the key it belongs to, so hash collisions and foreign files are detected on read
+shared_ptr<HTTPCachedBlock> HTTPBlockCache::ReadFromDisk(const string &directory, const string &key,
+                                                         idx_t &file_size) {
+	auto path = GetDiskPath(directory, key);
+	if (!local_fs->FileExists(path)) {
+		return nullptr;
+	}
+	try {
+		auto handle = local_fs->OpenFile(path, FileFlags::FILE_FLAGS_READ);
+		auto size = local_fs->GetFileSize(*handle);
+		idx_t key_size;
+		if (size < (int64_t)sizeof(idx_t)) {
+			return nullptr;
+		}
+		file_size = size;
+		local_fs->Read(*handle, &key_size, sizeof(idx_t), 0);
+		// the key size is read from the file: check it before using it, a corrupt file is a cache miss
+		if (key_size != key.size() || key_size > file_size - sizeof(idx_t)) {
+			return nullptr;
+		}
+		idx_t header_size = sizeof(idx_t) + key_size;
+		if (file_size < header_size || file_size - header_size > BLOCK_SIZE) {
+			return nullptr;
+		}
+		string stored_key(key_size, '\0');
+		local_fs->Read(*handle, (void *)stored_key.data(), key_size, sizeof(idx_t));
+		if (stored_key != key) {
+			return nullptr;
+		}
+		idx_t block_size = file_size - header_size;
+		auto data = unique_ptr<data_t[]>(new data_t[block_size]);
+		local_fs->Read(*handle, data.get(), block_size, header_size);
+		return make_shared<HTTPCachedBlock>(move(data), block_size);
+	} catch (std::exception &ex) {
+		// the disk cache is best-effort: treat unreadable blocks as cache misses
+		return nullptr;
+	}
+}
+
+idx_t HTTPBlockCache::WriteToDisk(const string &directory, const string &key, HTTPCachedBlock &block) {
+	auto path = GetDiskPath(directory, key);
+	idx_t key_size = key.size();
+	idx_t file_size = sizeof(idx_t) + key_size + block.size;
+	// the block is written to a temporary file first, so that concurrent readers never see a partially written block
+	auto temporary_path = path + ".tmp" + std::to_string(temporary_file_count++);
+	try {
+		{
+			auto handle = local_fs->OpenFile(temporary_path,
+			                                 FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+			local_fs->Write(*handle, &key_size, sizeof(idx_t), 0);
+			local_fs->Write(*handle, (void *)key.data(), key_size, sizeof(idx_t));
+			local_fs->Write(*handle, block.data.get(), block.size, sizeof(idx_t) + key_size);
+		}
+		local_fs->MoveFile(temporary_path, path);
+	} catch (std::exception &ex) {
+		// e.g. the disk is full: drop the block
+		try {
+			local_fs->RemoveFile(temporary_path);
+		} catch (std::exception &remove_ex) {
+		}
+		return 0;
+	}
+	return file_size;
+}
+
+} // namespace duckdb
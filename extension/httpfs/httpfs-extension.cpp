@@ -4,6 +4,8 @@
 #include "httpfs-extension.hpp"
 
 #include "s3fs.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
 namespace duckdb {
 
@@ -11,8 +13,14 @@ static void LoadInternal(DatabaseInstance &instance) {
 	S3FileSystem::Verify(); // run some tests to see if all the hashes work out
 	auto &fs = instance.GetFileSystem();
 
-	fs.RegisterSubSystem(make_unique<HTTPFileSystem>());
-	fs.RegisterSubSystem(make_unique<S3FileSystem>(BufferManager::GetBufferManager(instance)));
+	auto http_fs = make_unique<HTTPFileSystem>();
+	auto s3_fs = make_unique<S3FileSystem>(BufferManager::GetBufferManager(instance));
+	// HTTP and S3 files share one block cache (and therefore one memory budget)
+	s3_fs->block_cache = http_fs->block_cache;
+	// the block cache is configured through global settings, which reach it through the object cache
+	instance.GetObjectCache().Put(HTTPBlockCache::ObjectType(), http_fs->block_cache);
+	fs.RegisterSubSystem(move(http_fs));
+	fs.RegisterSubSystem(move(s3_fs));
 
 	auto &config = DBConfig::GetConfig(instance);
 
@@ -20,6 +28,20 @@ static void LoadInternal(DatabaseInstance &instance) {
 	// Single timeout value is used for all 4 types of timeouts, we could split it into 4 if users need that
 	config.AddExtensionOption("httpfs_timeout", "HTTP timeout read/write/connection/retry (default 30000ms)",
 	                          LogicalType::UBIGINT);
+	config.AddExtensionOption("http_max_parallel_requests",
+	                          "Maximum number of concurrent range requests used to serve large reads (default 8)",
+	                          LogicalType::UBIGINT);
+
+	// Block cache config
+	config.AddExtensionOption("http_block_cache_size",
+	                          "Maximum memory used to cache blocks of remote files across queries (default 0, disabled)",
+	                          LogicalType::VARCHAR, HTTPBlockCache::SetMemoryLimit);
+	config.AddExtensionOption("http_block_cache_directory",
+	                          "Local directory to which cached blocks of remote files are spilled (default none)",
+	                          LogicalType::VARCHAR, HTTPBlockCache::SetDirectory);
+	config.AddExtensionOption("http_block_cache_disk_size",
+	                          "Maximum disk space used by the block cache directory (default 4GB)", LogicalType::VARCHAR,
+	                          HTTPBlockCache::SetDiskLimit);
 
 	// Global S3 config
 	config.AddExtensionOption("s3_region", "S3 Region", LogicalType::VARCHAR);
@@ -37,6 +59,13 @@ static void LoadInternal(DatabaseInstance &instance) {
 	                          LogicalType::UBIGINT);
 	config.AddExtensionOption("s3_uploader_thread_limit", "S3 Uploader global thread limit (default 50)",
 	                          LogicalType::UBIGINT);
+
+	Connection con(instance);
+	con.BeginTransaction();
+	auto &catalog = Catalog::GetCatalog(*con.context);
+	CreateTableFunctionInfo stats_info(HTTPBlockCache::GetStatsFunction());
+	catalog.CreateTableFunction(*con.context, &stats_info);
+	con.Commit();
 }
 
 void HTTPFsExtension::Load(DuckDB &db) {
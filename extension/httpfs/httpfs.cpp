@@ -2,7 +2,9 @@
 
 #include "duckdb/common/atomic.hpp"
 #include "duckdb/common/file_opener.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/thread.hpp"
+#include "duckdb/common/thread_metrics.hpp"
 #include "duckdb/function/scalar/strftime.hpp"
 
 #define CPPHTTPLIB_OPENSSL_SUPPORT
@@ -22,6 +24,7 @@ static unique_ptr<duckdb_httplib_openssl::Headers> initialize_http_headers(Heade
 
 HTTPParams HTTPParams::ReadFrom(FileOpener *opener) {
 	uint64_t timeout;
+	uint64_t max_parallel_requests;
 	Value value;
 
 	if (opener->TryGetCurrentSetting("http_timeout", value)) {
@@ -30,7 +33,13 @@ HTTPParams HTTPParams::ReadFrom(FileOpener *opener) {
 		timeout = DEFAULT_TIMEOUT;
 	}
 
-	return {timeout};
+	if (opener->TryGetCurrentSetting("http_max_parallel_requests", value)) {
+		max_parallel_requests = value.GetValue<uint64_t>();
+	} else {
+		max_parallel_requests = DEFAULT_MAX_PARALLEL_REQUESTS;
+	}
+
+	return {timeout, max_parallel_requests};
 }
 
 void HTTPFileSystem::ParseUrl(string &url, string &path_out, string &proto_host_port_out) {
@@ -122,11 +131,13 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::HeadRequest(FileHandle &handle, stri
 	ParseUrl(url, path, proto_host_port);
 	auto headers = initialize_http_headers(header_map);
 
-	auto res = hfs.http_client->Head(path.c_str(), *headers);
+	auto client = hfs.GetClient();
+	auto res = client->Head(path.c_str(), *headers);
 	if (res.error() != duckdb_httplib_openssl::Error::Success) {
 		throw std::runtime_error("HTTP HEAD error on '" + url + "' (Error code " + std::to_string((int)res.error()) +
 		                         ")");
 	}
+	hfs.StoreClient(move(client));
 	return make_unique<ResponseWrapper>(res.value());
 }
 
@@ -144,7 +155,8 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 
 	idx_t out_offset = 0;
 
-	auto res = hfs.http_client->Get(
+	auto client = hfs.GetClient();
+	auto res = client->Get(
 	    path.c_str(), *headers,
 	    [&](const duckdb_httplib_openssl::Response &response) {
 		    if (response.status >= 400) {
@@ -169,12 +181,161 @@ unique_ptr<ResponseWrapper> HTTPFileSystem::GetRangeRequest(FileHandle &handle,
 		throw std::runtime_error("HTTP GET error on '" + url + "' (Error code " + std::to_string((int)res.error()) +
 		                         ")");
 	}
+	hfs.StoreClient(move(client));
 	return make_unique<ResponseWrapper>(res.value());
 }
 
+HTTPRequestPool::HTTPRequestPool() : shutdown(false) {
+}
+
+HTTPRequestPool::~HTTPRequestPool() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	jobs_available.notify_all();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+}
+
+void HTTPRequestPool::Schedule(std::function<void()> job, idx_t thread_count) {
+	{
+		lock_guard<mutex> guard(lock);
+		jobs.push(move(job));
+		thread_count = MinValue<idx_t>(thread_count, MAX_THREADS);
+		if (threads.size() < thread_count) {
+			threads.emplace_back(&HTTPRequestPool::Work, this);
+		}
+	}
+	jobs_available.notify_one();
+}
+
+void HTTPRequestPool::Work() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<mutex> guard(lock);
+			jobs_available.wait(guard, [&]() { return shutdown || !jobs.empty(); });
+			if (shutdown) {
+				return;
+			}
+			job = move(jobs.front());
+			jobs.pop();
+		}
+		job();
+	}
+}
+
+//! The ranges of a parallel read, shared by the reading thread and the jobs that it scheduled on the request pool
+struct ParallelRangeState {
+	ParallelRangeState(HTTPFileSystem &hfs, HTTPFileHandle &hfh, vector<HTTPRange> &ranges)
+	    : hfs(hfs), hfh(hfh), ranges(ranges), next_range(0), finished(false), active_jobs(0) {
+	}
+
+	HTTPFileSystem &hfs;
+	HTTPFileHandle &hfh;
+	vector<HTTPRange> &ranges;
+	atomic<idx_t> next_range;
+	mutex lock;
+	std::condition_variable jobs_done;
+	//! Set when the reading thread no longer waits for the ranges: jobs that have not started yet do nothing
+	bool finished;
+	idx_t active_jobs;
+	string error;
+
+	void FetchRanges() {
+		while (true) {
+			auto range_idx = next_range++;
+			if (range_idx >= ranges.size()) {
+				return;
+			}
+			auto &range = ranges[range_idx];
+			try {
+				hfs.GetRangeRequest(hfh, hfh.path, {}, range.file_offset, range.buffer, range.length);
+			} catch (std::exception &ex) {
+				lock_guard<mutex> guard(lock);
+				error = ex.what();
+				// skip the remaining ranges
+				next_range = ranges.size();
+				return;
+			}
+		}
+	}
+};
+
+void HTTPFileSystem::ParallelGetRangeRequests(HTTPFileHandle &hfh, vector<HTTPRange> &ranges) {
+	if (ranges.empty()) {
+		return;
+	}
+	auto max_requests = MaxValue<idx_t>(hfh.http_params.max_parallel_requests, 1);
+	// the calling thread fetches ranges as well, so it needs one less job on the request pool
+	idx_t job_count = MinValue<idx_t>(max_requests, ranges.size()) - 1;
+	// cap the range requests that the pool runs for this file, also when multiple threads read from it
+	idx_t pool_requests = hfh.pool_requests;
+	while (true) {
+		auto available = pool_requests < max_requests - 1 ? max_requests - 1 - pool_requests : 0;
+		job_count = MinValue<idx_t>(job_count, available);
+		if (hfh.pool_requests.compare_exchange_weak(pool_requests, pool_requests + job_count)) {
+			break;
+		}
+	}
+	if (job_count == 0) {
+		for (auto &range : ranges) {
+			GetRangeRequest(hfh, hfh.path, {}, range.file_offset, range.buffer, range.length);
+		}
+		return;
+	}
+
+	auto state = make_shared<ParallelRangeState>(*this, hfh, ranges);
+	for (idx_t i = 0; i < job_count; i++) {
+		request_pool.Schedule(
+		    [state]() {
+			    {
+				    lock_guard<mutex> guard(state->lock);
+				    if (state->finished) {
+					    return;
+				    }
+				    state->active_jobs++;
+			    }
+			    state->FetchRanges();
+			    lock_guard<mutex> guard(state->lock);
+			    state->active_jobs--;
+			    state->jobs_done.notify_one();
+		    },
+		    max_requests - 1);
+	}
+	state->FetchRanges();
+	// wait for the jobs that are still fetching a range, the jobs that did not start yet are skipped
+	string error;
+	{
+		std::unique_lock<mutex> guard(state->lock);
+		state->finished = true;
+		state->jobs_done.wait(guard, [&]() { return state->active_jobs == 0; });
+		error = state->error;
+	}
+	hfh.pool_requests -= job_count;
+	if (!error.empty()) {
+		throw std::runtime_error(error);
+	}
+}
+
+void HTTPFileSystem::ReadRangeParallel(HTTPFileHandle &hfh, idx_t file_offset, char *buffer, idx_t length) {
+	vector<HTTPRange> ranges;
+	for (idx_t part_offset = 0; part_offset < length; part_offset += PARALLEL_PART_SIZE) {
+		auto part_length = MinValue<idx_t>(PARALLEL_PART_SIZE, length - part_offset);
+		ranges.push_back({file_offset + part_offset, buffer + part_offset, part_length});
+	}
+	ParallelGetRangeRequests(hfh, ranges);
+}
+
 HTTPFileHandle::HTTPFileHandle(FileSystem &fs, std::string path, uint8_t flags, const HTTPParams &http_params)
-    : FileHandle(fs, path), http_params(http_params), flags(flags), length(0), buffer_available(0), buffer_idx(0),
-      file_offset(0), buffer_start(0), buffer_end(0) {
+    : FileHandle(fs, path), http_params(http_params), flags(flags), length(0), use_block_cache(false),
+      buffer_available(0), buffer_idx(0), file_offset(0), buffer_start(0), buffer_end(0), read_buffer_capacity(0),
+      read_ahead_len(READ_BUFFER_LEN), pool_requests(0) {
+}
+
+HTTPFileSystem::HTTPFileSystem() : block_cache(make_shared<HTTPBlockCache>()) {
 }
 
 std::unique_ptr<HTTPFileHandle> HTTPFileSystem::CreateHandle(const string &path, uint8_t flags, FileLockType lock,
@@ -189,6 +350,8 @@ std::unique_ptr<FileHandle> HTTPFileSystem::OpenFile(const string &path, uint8_t
 	D_ASSERT(compression == FileCompressionType::UNCOMPRESSED);
 	auto handle = CreateHandle(path, flags, lock, compression, opener);
 	handle->Initialize();
+	handle->use_block_cache =
+	    (flags & FileFlags::FILE_FLAGS_READ) && !handle->cache_validator.empty() && block_cache->Enabled();
 	return move(handle);
 }
 
@@ -199,6 +362,7 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 	if (location + nr_bytes > hfh.length) {
 		throw std::runtime_error("out of file");
 	}
+	ThreadMetrics::Get().bytes_read += nr_bytes;
 
 	if (location >= hfh.buffer_start && location < hfh.buffer_end) {
 		hfh.file_offset = location;
@@ -215,7 +379,8 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 		auto buffer_read_len = MinValue<idx_t>(hfh.buffer_available, to_read);
 		if (buffer_read_len > 0) {
 			D_ASSERT(hfh.buffer_start + hfh.buffer_idx + buffer_read_len <= hfh.buffer_end);
-			memcpy((char *)buffer + buffer_offset, hfh.read_buffer.get() + hfh.buffer_idx, buffer_read_len);
+			auto read_buffer = hfh.use_block_cache ? hfh.cached_block->data.get() : hfh.read_buffer.get();
+			memcpy((char *)buffer + buffer_offset, read_buffer + hfh.buffer_idx, buffer_read_len);
 
 			buffer_offset += buffer_read_len;
 			to_read -= buffer_read_len;
@@ -225,17 +390,73 @@ void HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, id
 			hfh.file_offset += buffer_read_len;
 		}
 
-		if (to_read > 0 && hfh.buffer_available == 0) {
-			auto new_buffer_available = MinValue<idx_t>(hfh.READ_BUFFER_LEN, hfh.length - hfh.file_offset);
-			GetRangeRequest(hfh, hfh.path, {}, hfh.file_offset, (char *)hfh.read_buffer.get(), new_buffer_available);
-			hfh.buffer_available = new_buffer_available;
+		if (to_read == 0 || hfh.buffer_available > 0) {
+			continue;
+		}
+		// grow the read-ahead while the file is read sequentially, and reset it on a random read
+		if (hfh.buffer_end > 0 && hfh.file_offset == hfh.buffer_end) {
+			hfh.read_ahead_len = MinValue<idx_t>(hfh.read_ahead_len * 2, hfh.MAX_READ_AHEAD_LEN);
+		} else {
+			hfh.read_ahead_len = hfh.READ_BUFFER_LEN;
+		}
+		auto fetch_len = MinValue<idx_t>(MaxValue<idx_t>(hfh.read_ahead_len, to_read), hfh.length - hfh.file_offset);
+
+		if (hfh.use_block_cache) {
+			auto block_offset = hfh.file_offset - hfh.file_offset % HTTPBlockCache::BLOCK_SIZE;
+			hfh.cached_block = GetCachedBlock(hfh, block_offset, hfh.file_offset + fetch_len);
+			hfh.buffer_start = block_offset;
+			hfh.buffer_end = block_offset + hfh.cached_block->size;
+			hfh.buffer_idx = hfh.file_offset - block_offset;
+			hfh.buffer_available = hfh.cached_block->size - hfh.buffer_idx;
+		} else if (to_read >= 2 * PARALLEL_PART_SIZE) {
+			// large reads bypass the read buffer and are fetched straight into the output buffer
+			ReadRangeParallel(hfh, hfh.file_offset, (char *)buffer + buffer_offset, to_read);
+			hfh.file_offset += to_read;
+			hfh.buffer_start = hfh.file_offset;
+			hfh.buffer_end = hfh.file_offset;
+			return;
+		} else {
+			if (fetch_len > hfh.read_buffer_capacity) {
+				hfh.read_buffer = std::unique_ptr<data_t[]>(new data_t[fetch_len]);
+				hfh.read_buffer_capacity = fetch_len;
+			}
+			ReadRangeParallel(hfh, hfh.file_offset, (char *)hfh.read_buffer.get(), fetch_len);
+			hfh.buffer_available = fetch_len;
 			hfh.buffer_idx = 0;
 			hfh.buffer_start = hfh.file_offset;
-			hfh.buffer_end = hfh.buffer_start + new_buffer_available;
+			hfh.buffer_end = hfh.buffer_start + fetch_len;
 		}
 	}
 }
 
+shared_ptr<HTTPCachedBlock> HTTPFileSystem::GetCachedBlock(HTTPFileHandle &hfh, idx_t block_offset,
+                                                           idx_t prefetch_end) {
+	auto block = block_cache->Get(hfh.path, hfh.cache_validator, block_offset);
+	if (block) {
+		return block;
+	}
+	// fetch the requested block together with the uncached blocks that follow it
+	vector<idx_t> missing_blocks;
+	vector<shared_ptr<HTTPCachedBlock>> fetched_blocks;
+	vector<HTTPRange> ranges;
+	for (idx_t offset = block_offset; offset < MaxValue<idx_t>(prefetch_end, block_offset + 1);
+	     offset += HTTPBlockCache::BLOCK_SIZE) {
+		if (offset != block_offset && block_cache->Get(hfh.path, hfh.cache_validator, offset)) {
+			continue;
+		}
+		auto block_size = MinValue<idx_t>(HTTPBlockCache::BLOCK_SIZE, hfh.length - offset);
+		auto fetched_block = make_shared<HTTPCachedBlock>(unique_ptr<data_t[]>(new data_t[block_size]), block_size);
+		ranges.push_back({offset, (char *)fetched_block->data.get(), block_size});
+		missing_blocks.push_back(offset);
+		fetched_blocks.push_back(move(fetched_block));
+	}
+	ParallelGetRangeRequests(hfh, ranges);
+	for (idx_t i = 0; i < fetched_blocks.size(); i++) {
+		block_cache->Put(hfh.path, hfh.cache_validator, missing_blocks[i], fetched_blocks[i]);
+	}
+	return fetched_blocks[0];
+}
+
 int64_t HTTPFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	auto &hfh = (HTTPFileHandle &)handle;
 	idx_t max_read = hfh.length - hfh.file_offset;
@@ -291,8 +512,6 @@ void HTTPFileSystem::Seek(FileHandle &handle, idx_t location) {
 }
 
 unique_ptr<ResponseWrapper> HTTPFileHandle::Initialize() {
-	InitializeClient();
-
 	auto &hfs = (HTTPFileSystem &)file_system;
 	auto res = hfs.HeadRequest(*this, path, {});
 
@@ -313,10 +532,22 @@ unique_ptr<ResponseWrapper> HTTPFileHandle::Initialize() {
 	// Initialize the read buffer now that we know the file exists
 	if (flags & FileFlags::FILE_FLAGS_READ) {
 		read_buffer = std::unique_ptr<data_t[]>(new data_t[READ_BUFFER_LEN]);
+		read_buffer_capacity = READ_BUFFER_LEN;
 	}
 
 	length = std::atoll(res->headers["Content-Length"].c_str());
 
+	// blocks of this file are only shared with handles that see the same version of the file
+	for (auto &header : res->headers) {
+		auto header_name = StringUtil::Lower(header.first);
+		if (header_name == "etag") {
+			cache_validator = "etag:" + header.second;
+			break;
+		} else if (header_name == "last-modified" && !header.second.empty()) {
+			cache_validator = "modified:" + header.second + ":" + std::to_string(length);
+		}
+	}
+
 	auto last_modified = res->headers["Last-Modified"];
 	if (last_modified.empty()) {
 		return res;
@@ -335,10 +566,27 @@ unique_ptr<ResponseWrapper> HTTPFileHandle::Initialize() {
 	return res;
 }
 
-void HTTPFileHandle::InitializeClient() {
+unique_ptr<duckdb_httplib_openssl::Client> HTTPFileHandle::CreateClient() {
 	string path_out, proto_host_port;
 	HTTPFileSystem::ParseUrl(path, path_out, proto_host_port);
-	http_client = HTTPFileSystem::GetClient(this->http_params, proto_host_port.c_str());
+	return HTTPFileSystem::GetClient(this->http_params, proto_host_port.c_str());
+}
+
+unique_ptr<duckdb_httplib_openssl::Client> HTTPFileHandle::GetClient() {
+	{
+		lock_guard<mutex> guard(client_pool_lock);
+		if (!client_pool.empty()) {
+			auto client = move(client_pool.back());
+			client_pool.pop_back();
+			return client;
+		}
+	}
+	return CreateClient();
+}
+
+void HTTPFileHandle::StoreClient(unique_ptr<duckdb_httplib_openssl::Client> client) {
+	lock_guard<mutex> guard(client_pool_lock);
+	client_pool.push_back(move(client));
 }
 
 ResponseWrapper::ResponseWrapper(duckdb_httplib_openssl::Response &res) {
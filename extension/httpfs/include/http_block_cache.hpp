@@ -0,0 +1,139 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/enums/set_scope.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <list>
+
+namespace duckdb {
+
+//! A fixed-size block of a remote file that is held by the HTTPBlockCache
+struct HTTPCachedBlock {
+	HTTPCachedBlock(unique_ptr<data_t[]> data_p, idx_t size_p) : data(move(data_p)), size(size_p) {
+	}
+
+	unique_ptr<data_t[]> data;
+	idx_t size;
+};
+
+struct HTTPBlockCacheParams {
+	static constexpr uint64_t DEFAULT_DISK_CACHE_SIZE = 4294967296; // 4GB
+
+	//! The maximum amount of memory used by cached blocks, 0 disables the cache
+	uint64_t memory_limit = 0;
+	//! The directory in which blocks evicted from memory are kept, empty disables the disk cache
+	string directory;
+	//! The maximum amount of disk space used by the disk cache
+	uint64_t disk_limit = DEFAULT_DISK_CACHE_SIZE;
+};
+
+//! The HTTPBlockCache is a size-bounded LRU cache of remote file blocks, shared by all file handles of a file system.
+//! Blocks are keyed by (URL, validator, block offset), where the validator is the ETag (or last modification time and
+//! length) of the remote file, so a changed file is never served from stale blocks. Blocks evicted from memory are
+//! written to an (optional) local cache directory, which has its own LRU bound and survives restarts.
+//! The cache is database-wide: it is kept in the object cache of the database, and configured through global settings.
+class HTTPBlockCache : public ObjectCacheEntry {
+public:
+	//! The size of a cached block; reads are aligned to this size
+	constexpr static idx_t BLOCK_SIZE = 1048576;
+
+	HTTPBlockCache();
+
+	//! Returns the block cache of the database of the client
+	static shared_ptr<HTTPBlockCache> Get(ClientContext &context);
+
+	static string ObjectType() {
+		return "http_block_cache";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	//! The callbacks of the http_block_cache_size, http_block_cache_directory and http_block_cache_disk_size settings
+	static void SetMemoryLimit(ClientContext &context, SetScope scope, Value &parameter);
+	static void SetDirectory(ClientContext &context, SetScope scope, Value &parameter);
+	static void SetDiskLimit(ClientContext &context, SetScope scope, Value &parameter);
+	//! The http_block_cache_stats() table function, which returns the hit counters and the usage of the cache
+	static TableFunction GetStatsFunction();
+
+	HTTPBlockCacheParams GetParams();
+	//! Updates the limits and the disk cache directory of the cache, evicting blocks if required
+	void Configure(const HTTPBlockCacheParams &params);
+	//! Whether or not the cache is enabled
+	bool Enabled();
+
+	//! Looks up a block in memory and then on disk, returns nullptr if the block is not cached
+	shared_ptr<HTTPCachedBlock> Get(const string &url, const string &validator, idx_t block_offset);
+	//! Inserts a block into the cache
+	void Put(const string &url, const string &validator, idx_t block_offset, shared_ptr<HTTPCachedBlock> block);
+
+	idx_t MemoryUsage();
+	idx_t DiskUsage();
+
+	//! The amount of blocks that were served from memory or from the disk cache
+	atomic<idx_t> memory_hits;
+	atomic<idx_t> disk_hits;
+	//! The amount of blocks that were not cached, and had to be fetched from the remote file
+	atomic<idx_t> misses;
+
+private:
+	struct MemoryEntry {
+		shared_ptr<HTTPCachedBlock> block;
+		std::list<string>::iterator lru_position;
+	};
+	struct DiskEntry {
+		idx_t size;
+		std::list<string>::iterator lru_position;
+	};
+
+	//! The disk I/O that is collected while holding the lock, and performed after releasing it
+	struct DiskWork {
+		//! The directory of the disk cache when the work was collected
+		string directory;
+		//! The blocks evicted from memory that are written to the disk cache
+		vector<pair<string, shared_ptr<HTTPCachedBlock>>> writes;
+		//! The paths of the blocks evicted from the disk cache
+		vector<string> removals;
+	};
+
+	static string GetKey(const string &url, const string &validator, idx_t block_offset);
+	string GetDiskPath(const string &directory, const string &key);
+
+	//! Reads a block from the disk cache; does not require the lock
+	shared_ptr<HTTPCachedBlock> ReadFromDisk(const string &directory, const string &key, idx_t &file_size);
+	//! Writes a block to the disk cache; does not require the lock. Returns the size of the file, or 0 on failure.
+	idx_t WriteToDisk(const string &directory, const string &key, HTTPCachedBlock &block);
+	//! Performs the collected disk I/O; must not hold the lock
+	void PerformDiskWork(DiskWork &work);
+	//! Starts tracking (or refreshes) a block in the disk cache; must hold the lock
+	void TrackDiskBlock(const string &key, idx_t file_size, DiskWork &work);
+
+	//! Evict blocks until the limits are respected; must hold the lock
+	void EvictMemory(idx_t limit, DiskWork &work);
+	void EvictDisk(idx_t limit, DiskWork &work);
+
+private:
+	mutex lock;
+	unique_ptr<FileSystem> local_fs;
+	HTTPBlockCacheParams params;
+
+	//! The blocks held in memory, most recently used blocks are at the front of the LRU list
+	unordered_map<string, MemoryEntry> memory_blocks;
+	std::list<string> memory_lru;
+	idx_t memory_usage;
+
+	//! The blocks held in the disk cache directory
+	unordered_map<string, DiskEntry> disk_blocks;
+	std::list<string> disk_lru;
+	idx_t disk_usage;
+	//! Used to give every write to the disk cache its own temporary file
+	atomic<idx_t> temporary_file_count;
+};
+
+} // namespace duckdb
@@ -1,8 +1,16 @@
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/pair.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "http_block_cache.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <thread>
 
 namespace duckdb_httplib_openssl {
 struct Response;
@@ -24,12 +32,45 @@ public:
 
 struct HTTPParams {
 	static constexpr uint64_t DEFAULT_TIMEOUT = 30000; // 30 sec
+	static constexpr uint64_t DEFAULT_MAX_PARALLEL_REQUESTS = 8;
 
 	uint64_t timeout;
+	//! The maximum number of concurrent range requests (and therefore connections) used to serve a single read
+	uint64_t max_parallel_requests;
 
 	static HTTPParams ReadFrom(FileOpener *opener);
 };
 
+//! A byte range of a remote file that is fetched into buffer
+struct HTTPRange {
+	idx_t file_offset;
+	char *buffer;
+	idx_t length;
+};
+
+//! A bounded set of threads that run the range requests of parallel reads. The threads are started on demand,
+//! and are shared by all reads of a file system, so a read does not start threads of its own.
+class HTTPRequestPool {
+public:
+	HTTPRequestPool();
+	~HTTPRequestPool();
+
+	//! Runs the job on a thread of the pool, starting up to thread_count threads
+	void Schedule(std::function<void()> job, idx_t thread_count);
+
+	//! The maximum number of threads of the pool
+	constexpr static idx_t MAX_THREADS = 64;
+
+private:
+	void Work();
+
+	mutex lock;
+	std::condition_variable jobs_available;
+	std::queue<std::function<void()>> jobs;
+	vector<std::thread> threads;
+	bool shutdown;
+};
+
 class HTTPFileHandle : public FileHandle {
 public:
 	HTTPFileHandle(FileSystem &fs, std::string path, uint8_t flags, const HTTPParams &params);
@@ -37,8 +78,10 @@ public:
 	// This two-phase construction allows subclasses more flexible setup.
 	virtual unique_ptr<ResponseWrapper> Initialize();
 
-	// We keep an http client stored for connection reuse with keep-alive headers
-	unique_ptr<duckdb_httplib_openssl::Client> http_client;
+	// Acquire a client from the connection pool of this handle, creating a new connection if none is idle
+	unique_ptr<duckdb_httplib_openssl::Client> GetClient();
+	// Return a client to the connection pool, so its connection can be reused with keep-alive headers
+	void StoreClient(unique_ptr<duckdb_httplib_openssl::Client> client);
 
 	const HTTPParams http_params;
 
@@ -46,6 +89,10 @@ public:
 	uint8_t flags;
 	idx_t length;
 	time_t last_modified;
+	//! Identifies the version of the remote file in the block cache (ETag, or last modification time and length)
+	string cache_validator;
+	//! Whether or not reads of this handle go through the block cache of the file system
+	bool use_block_cache;
 
 	// Read info
 	idx_t buffer_available;
@@ -56,18 +103,32 @@ public:
 
 	// Read buffer
 	std::unique_ptr<data_t[]> read_buffer;
+	idx_t read_buffer_capacity;
 	constexpr static idx_t READ_BUFFER_LEN = 1000000;
+	// Sequential reads double the amount of data fetched per buffer refill up to this size
+	constexpr static idx_t MAX_READ_AHEAD_LEN = 32000000;
+	idx_t read_ahead_len;
+	//! The block cache entry that is used as read buffer if use_block_cache is set
+	shared_ptr<HTTPCachedBlock> cached_block;
+	//! The number of range requests that the request pool currently runs for this handle
+	atomic<idx_t> pool_requests;
 
 public:
 	void Close() override {
 	}
 
 protected:
-	virtual void InitializeClient();
+	virtual unique_ptr<duckdb_httplib_openssl::Client> CreateClient();
+
+	// Idle connections of this handle, parallel range requests each take their own connection
+	mutex client_pool_lock;
+	vector<unique_ptr<duckdb_httplib_openssl::Client>> client_pool;
 };
 
 class HTTPFileSystem : public FileSystem {
 public:
+	HTTPFileSystem();
+
 	static unique_ptr<duckdb_httplib_openssl::Client> GetClient(const HTTPParams &http_params,
 	                                                            const char *proto_host_port);
 	static void ParseUrl(string &url, string &path_out, string &proto_host_port_out);
@@ -86,6 +147,9 @@ public:
 	// Get Request with range parameter that GETs exactly buffer_out_len bytes from the url
 	virtual unique_ptr<ResponseWrapper> GetRangeRequest(FileHandle &handle, string url, HeaderMap header_map,
 	                                                    idx_t file_offset, char *buffer_out, idx_t buffer_out_len);
+	// Runs the range requests concurrently on up to max_parallel_requests connections of the handle: the calling
+	// thread and the request pool fetch the ranges together
+	void ParallelGetRangeRequests(HTTPFileHandle &handle, vector<HTTPRange> &ranges);
 	// Post Request that can handle variable sized responses without a content-length header (needed for s3 multipart)
 	virtual unique_ptr<ResponseWrapper> PostRequest(FileHandle &handle, string url, HeaderMap header_map,
 	                                                unique_ptr<char[]> &buffer_out, idx_t &buffer_out_len,
@@ -114,9 +178,23 @@ public:
 
 	static void Verify();
 
+	//! Cache of remote file blocks, shared across handles and queries (and with the S3FileSystem)
+	shared_ptr<HTTPBlockCache> block_cache;
+	//! The threads that run the range requests of parallel reads
+	HTTPRequestPool request_pool;
+
 protected:
 	virtual std::unique_ptr<HTTPFileHandle> CreateHandle(const string &path, uint8_t flags, FileLockType lock,
 	                                                     FileCompressionType compression, FileOpener *opener);
+
+	//! Returns the block at block_offset from the block cache. On a cache miss, all uncached blocks up to
+	//! prefetch_end are fetched (in parallel) and cached.
+	shared_ptr<HTTPCachedBlock> GetCachedBlock(HTTPFileHandle &handle, idx_t block_offset, idx_t prefetch_end);
+	//! Splits [file_offset, file_offset + length) into parts that are fetched in parallel
+	void ReadRangeParallel(HTTPFileHandle &handle, idx_t file_offset, char *buffer, idx_t length);
+
+	// Reads larger than this are split into multiple parallel range requests
+	constexpr static idx_t PARALLEL_PART_SIZE = 4000000;
 };
 
 } // namespace duckdb
@@ -101,7 +101,7 @@ protected:
 	std::atomic<uint16_t> parts_uploaded;
 	bool upload_finalized;
 
-	void InitializeClient() override;
+	unique_ptr<duckdb_httplib_openssl::Client> CreateClient() override;
 };
 
 class S3FileSystem : public HTTPFileSystem {
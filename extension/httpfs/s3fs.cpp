@@ -195,13 +195,13 @@ void S3FileHandle::Close() {
 	}
 }
 
-void S3FileHandle::InitializeClient() {
+unique_ptr<duckdb_httplib_openssl::Client> S3FileHandle::CreateClient() {
 	string host, http_proto, path_parsed, query_param;
 	S3FileSystem::S3UrlParse(path, this->auth_params.endpoint, this->auth_params.use_ssl, host, http_proto, path_parsed,
 	                         query_param);
 
 	string proto_host_port = http_proto + host;
-	http_client = HTTPFileSystem::GetClient(this->http_params, proto_host_port.c_str());
+	return HTTPFileSystem::GetClient(this->http_params, proto_host_port.c_str());
 }
 
 // Opens the multipart upload and returns the ID
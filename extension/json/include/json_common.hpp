@@ -552,4 +552,23 @@ inline yyjson_type JSONCommon::GetTag(yyjson_mut_val *val) {
 	return yyjson_mut_get_tag(val);
 }
 
+//! Structure detection (json_structure), reused by the schema inference of read_json
+struct JSONStructure {
+	//! Build the structure of a JSON value
+	static yyjson_mut_val *BuildStructure(yyjson_val *val, yyjson_mut_doc *structure_doc);
+	//! Merge the structures of multiple values into one structure (throws if the structures are inconsistent)
+	static yyjson_mut_val *MergeStructures(const vector<yyjson_mut_val *> &structures, yyjson_mut_doc *structure_doc);
+	//! Convert a structure to the type that json_transform would convert it to
+	static LogicalType StructureToType(yyjson_mut_val *structure);
+};
+
+//! Value conversion (json_transform), reused by read_json
+struct JSONTransform {
+	//! Convert a structure that contains type strings to a LogicalType
+	static LogicalType StructureToType(yyjson_val *val);
+	//! Transform the given values to the type of result. If null_objects is set, null or missing objects become NULL
+	//! structs (as in read_json), otherwise they become structs with NULL fields (as in json_transform)
+	static void TransformValues(yyjson_val *vals[], Vector &result, const idx_t count, bool strict, bool null_objects);
+};
+
 } // namespace duckdb
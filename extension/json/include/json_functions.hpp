@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 
 namespace duckdb {
 
@@ -41,6 +42,16 @@ public:
 		return functions;
 	}
 
+	static vector<CreateTableFunctionInfo> GetTableFunctions() {
+		vector<CreateTableFunctionInfo> functions;
+
+		// Scan functions
+		functions.push_back(GetReadJSONFunction());
+		functions.push_back(GetReadNDJSONFunction());
+
+		return functions;
+	}
+
 private:
 	static CreateScalarFunctionInfo GetExtractFunction();
 	static CreateScalarFunctionInfo GetExtractStringFunction();
@@ -59,6 +70,9 @@ private:
 	static CreateScalarFunctionInfo GetTypeFunction();
 	static CreateScalarFunctionInfo GetValidFunction();
 
+	static CreateTableFunctionInfo GetReadJSONFunction();
+	static CreateTableFunctionInfo GetReadNDJSONFunction();
+
 	static void AddAliases(vector<string> names, CreateScalarFunctionInfo fun,
 	                       vector<CreateScalarFunctionInfo> &functions) {
 		for (auto &name : names) {
@@ -34,6 +34,9 @@ void JSONExtension::Load(DuckDB &db) {
 	for (auto &fun : JSONFunctions::GetFunctions()) {
 		catalog.CreateFunction(*con.context, &fun);
 	}
+	for (auto &fun : JSONFunctions::GetTableFunctions()) {
+		catalog.CreateTableFunction(*con.context, &fun);
+	}
 
 	for (idx_t index = 0; json_macros[index].name != nullptr; index++) {
 		auto info = DefaultFunctionGenerator::CreateInternalMacroInfo(json_macros[index]);
@@ -196,6 +196,25 @@ static inline yyjson_mut_val *ConvertStructure(yyjson_mut_val *val, yyjson_mut_d
 	}
 }
 
+yyjson_mut_val *JSONStructure::BuildStructure(yyjson_val *val, yyjson_mut_doc *structure_doc) {
+	return duckdb::BuildStructure(val, structure_doc);
+}
+
+yyjson_mut_val *JSONStructure::MergeStructures(const vector<yyjson_mut_val *> &structures,
+                                               yyjson_mut_doc *structure_doc) {
+	return GetConsistentArrayStructure(structures, structure_doc);
+}
+
+LogicalType JSONStructure::StructureToType(yyjson_mut_val *structure) {
+	// Write the type string structure and read it back, just like json_transform(x, json_structure(x))
+	auto structure_doc = JSONCommon::CreateDocument();
+	yyjson_mut_doc_set_root(*structure_doc, ConvertStructure(structure, *structure_doc));
+	idx_t len;
+	auto data = JSONCommon::MutWrite(*structure_doc, len);
+	auto doc = JSONCommon::ReadDocument(string_t(data.get(), len));
+	return JSONTransform::StructureToType(doc->root);
+}
+
 static inline string_t Structure(yyjson_val *val, Vector &result) {
 	auto structure_doc = JSONCommon::CreateDocument();
 	auto structure = ConvertStructure(BuildStructure(val, *structure_doc), *structure_doc);
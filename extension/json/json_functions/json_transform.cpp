@@ -173,7 +173,7 @@ static inline bool GetValueString(yyjson_val *val, string_t &result, Vector &vec
 }
 
 //! Forward declaration for recursion
-static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict);
+static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict, bool null_objects);
 
 template <class T>
 static void TransformNumerical(yyjson_val *vals[], Vector &result, const idx_t count, const bool strict) {
@@ -235,7 +235,16 @@ static void TransformToString(yyjson_val *vals[], Vector &result, const idx_t co
 }
 
 static void TransformObject(yyjson_val *vals[], Vector &result, const idx_t count, const LogicalType &type,
-                            bool strict) {
+                            bool strict, bool null_objects) {
+	if (null_objects) {
+		// Null or missing objects become a NULL struct, rather than a struct with NULL fields
+		auto &validity = FlatVector::Validity(result);
+		for (idx_t i = 0; i < count; i++) {
+			if (!vals[i] || yyjson_is_null(vals[i])) {
+				validity.SetInvalid(i);
+			}
+		}
+	}
 	// Initialize array for the nested values
 	auto nested_vals_ptr = unique_ptr<yyjson_val *[]>(new yyjson_val *[count]);
 	auto nested_vals = nested_vals_ptr.get();
@@ -249,11 +258,11 @@ static void TransformObject(yyjson_val *vals[], Vector &result, const idx_t coun
 			nested_vals[i] = yyjson_obj_getn(vals[i], name_ptr, name_len);
 		}
 		// Transform child values
-		Transform(nested_vals, *child_vs[child_i], count, strict);
+		Transform(nested_vals, *child_vs[child_i], count, strict, null_objects);
 	}
 }
 
-static void TransformArray(yyjson_val *vals[], Vector &result, const idx_t count, bool strict) {
+static void TransformArray(yyjson_val *vals[], Vector &result, const idx_t count, bool strict, bool null_objects) {
 	// Initialize list vector
 	auto list_entries = FlatVector::GetData<list_entry_t>(result);
 	auto &list_validity = FlatVector::Validity(result);
@@ -288,10 +297,10 @@ static void TransformArray(yyjson_val *vals[], Vector &result, const idx_t count
 	}
 	D_ASSERT(list_i == offset);
 	// Transform array values
-	Transform(nested_vals, ListVector::GetEntry(result), offset, strict);
+	Transform(nested_vals, ListVector::GetEntry(result), offset, strict, null_objects);
 }
 
-static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict) {
+static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, bool strict, bool null_objects) {
 	auto result_type = result.GetType();
 	switch (result_type.id()) {
 	case LogicalTypeId::SQLNULL:
@@ -354,9 +363,9 @@ static void Transform(yyjson_val *vals[], Vector &result, const idx_t count, boo
 	case LogicalTypeId::BLOB:
 		return TransformToString(vals, result, count);
 	case LogicalTypeId::STRUCT:
-		return TransformObject(vals, result, count, result_type, strict);
+		return TransformObject(vals, result, count, result_type, strict, null_objects);
 	case LogicalTypeId::LIST:
-		return TransformArray(vals, result, count, strict);
+		return TransformArray(vals, result, count, strict, null_objects);
 	default:
 		throw InternalException("Unexpected type at JSON Transform %s", LogicalTypeIdToString(result_type.id()));
 	}
@@ -386,7 +395,16 @@ static void TransformFunction(DataChunk &args, ExpressionState &state, Vector &r
 		}
 	}
 	// Transform
-	Transform(vals, result, count, strict);
+	Transform(vals, result, count, strict, false);
+}
+
+LogicalType JSONTransform::StructureToType(yyjson_val *val) {
+	return duckdb::StructureToType(val);
+}
+
+void JSONTransform::TransformValues(yyjson_val *vals[], Vector &result, const idx_t count, bool strict,
+                                    bool null_objects) {
+	Transform(vals, result, count, strict, null_objects);
 }
 
 CreateScalarFunctionInfo JSONFunctions::GetTransformFunction() {
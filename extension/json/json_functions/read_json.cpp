@@ -0,0 +1,540 @@
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parallel/parallel_state.hpp"
+#include "json_common.hpp"
+#include "json_functions.hpp"
+
+namespace duckdb {
+
+//! Newline-delimited files are split into ranges of this size that are parsed in parallel
+static constexpr idx_t JSON_RANGE_SIZE = 8388608;
+//! Lines that cross the end of a range (or of a streaming buffer) are completed in steps of this size
+static constexpr idx_t JSON_READ_STEP_SIZE = 65536;
+static constexpr idx_t JSON_DEFAULT_SAMPLE_SIZE = 2048;
+
+//! The column name if the records are not objects
+static constexpr auto JSON_DEFAULT_COLUMN_NAME = "json";
+
+struct JSONScanRange {
+	idx_t file_index;
+	idx_t start;
+	//! DConstants::INVALID_INDEX if the file cannot be split and is read sequentially up to the end
+	idx_t end;
+};
+
+struct ReadJSONBindData : public TableFunctionData {
+	vector<string> files;
+	//! The size of every file, or DConstants::INVALID_INDEX if the file cannot be split (e.g. compressed files)
+	vector<idx_t> file_sizes;
+	FileCompressionType compression = FileCompressionType::AUTO_DETECT;
+	bool ignore_errors = false;
+	//! Whether the records are objects whose fields are the columns, or whether every record is a single value
+	bool records_are_objects = true;
+	vector<string> names;
+	vector<LogicalType> types;
+};
+
+//! Hands out ranges of the files to the threads that scan them
+struct ReadJSONParallelState : public ParallelState {
+	mutex lock;
+	idx_t file_index = 0;
+	idx_t file_offset = 0;
+
+	bool NextRange(const ReadJSONBindData &bind_data, JSONScanRange &range) {
+		lock_guard<mutex> parallel_lock(lock);
+		while (file_index < bind_data.files.size()) {
+			auto file_size = bind_data.file_sizes[file_index];
+			if (file_size == DConstants::INVALID_INDEX) {
+				// this file cannot be split: one thread reads all of it
+				range = {file_index++, 0, DConstants::INVALID_INDEX};
+				file_offset = 0;
+				return true;
+			}
+			if (file_offset < file_size) {
+				range = {file_index, file_offset, MinValue<idx_t>(file_offset + JSON_RANGE_SIZE, file_size)};
+				file_offset = range.end;
+				return true;
+			}
+			file_index++;
+			file_offset = 0;
+		}
+		return false;
+	}
+};
+
+//! Reads the lines of a single range of a newline-delimited JSON file
+class JSONLineReader {
+public:
+	JSONLineReader() : handle_file_index(DConstants::INVALID_INDEX), buffer_capacity(0) {
+		Reset();
+	}
+
+	void Initialize(ClientContext &context, const ReadJSONBindData &bind_data, const JSONScanRange &range) {
+		Reset();
+		if (!handle || handle_file_index != range.file_index) {
+			auto &fs = FileSystem::GetFileSystem(context);
+			handle = fs.OpenFile(bind_data.files[range.file_index], FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK,
+			                     bind_data.compression, FileSystem::GetFileOpener(context));
+			handle_file_index = range.file_index;
+		}
+		file_name = bind_data.files[range.file_index];
+		if (range.end == DConstants::INVALID_INDEX) {
+			streaming = true;
+			return;
+		}
+		LoadRange(range, bind_data.file_sizes[range.file_index]);
+	}
+
+	//! Returns the next line (without the newline), or false if the range has been exhausted
+	bool NextLine(const char *&line, idx_t &line_len) {
+		while (true) {
+			auto remaining = buffer_size - buffer_pos;
+			auto line_start = buffer.get() + buffer_pos;
+			auto newline = remaining == 0 ? nullptr : (const char *)memchr(line_start, '\n', remaining);
+			if (newline) {
+				line = line_start;
+				line_len = newline - line_start;
+				buffer_pos += line_len + 1;
+				break;
+			}
+			if (streaming && !eof) {
+				Refill();
+				continue;
+			}
+			if (remaining == 0) {
+				return false;
+			}
+			// the last line of the file has no trailing newline
+			line = line_start;
+			line_len = remaining;
+			buffer_pos = buffer_size;
+			break;
+		}
+		line_offset = buffer_file_offset + (line - buffer.get());
+		if (line_len > 0 && line[line_len - 1] == '\r') {
+			line_len--;
+		}
+		return true;
+	}
+
+	//! The file and the byte offset of the last line that was returned, for error messages
+	string file_name;
+	idx_t line_offset;
+
+private:
+	void Reset() {
+		buffer_size = 0;
+		buffer_pos = 0;
+		buffer_file_offset = 0;
+		line_offset = 0;
+		streaming = false;
+		eof = false;
+	}
+
+	void Reserve(idx_t capacity) {
+		if (capacity <= buffer_capacity) {
+			return;
+		}
+		auto new_buffer = unique_ptr<char[]>(new char[capacity]);
+		if (buffer_size > 0) {
+			memcpy(new_buffer.get(), buffer.get(), buffer_size);
+		}
+		buffer = move(new_buffer);
+		buffer_capacity = capacity;
+	}
+
+	//! A line belongs to the range in which it starts: skip the line that started in the previous range, and
+	//! complete the last line, which may extend beyond the end of the range
+	void LoadRange(const JSONScanRange &range, idx_t file_size) {
+		auto read_start = range.start == 0 ? 0 : range.start - 1;
+		auto read_size = range.end - read_start;
+		Reserve(read_size);
+		handle->Read(buffer.get(), read_size, read_start);
+		buffer_size = read_size;
+		buffer_file_offset = read_start;
+		if (range.start > 0) {
+			// a line starts in this range if it is preceded by a newline in [start - 1, end - 1)
+			auto newline = (const char *)memchr(buffer.get(), '\n', read_size - 1);
+			if (!newline) {
+				buffer_size = 0;
+				return;
+			}
+			buffer_pos = newline - buffer.get() + 1;
+		}
+		if (buffer[buffer_size - 1] == '\n') {
+			return;
+		}
+		while (read_start + buffer_size < file_size) {
+			auto step_size = MinValue<idx_t>(JSON_READ_STEP_SIZE, file_size - (read_start + buffer_size));
+			Reserve(MaxValue<idx_t>(buffer_size + step_size, buffer_capacity * 2));
+			auto step_start = buffer.get() + buffer_size;
+			handle->Read(step_start, step_size, read_start + buffer_size);
+			auto newline = (const char *)memchr(step_start, '\n', step_size);
+			if (newline) {
+				buffer_size = newline - buffer.get() + 1;
+				return;
+			}
+			buffer_size += step_size;
+		}
+	}
+
+	//! Move the incomplete last line to the front of the buffer and read more of the stream
+	void Refill() {
+		auto remaining = buffer_size - buffer_pos;
+		if (buffer_pos > 0) {
+			memmove(buffer.get(), buffer.get() + buffer_pos, remaining);
+			buffer_file_offset += buffer_pos;
+			buffer_pos = 0;
+			buffer_size = remaining;
+		}
+		if (buffer_capacity == 0) {
+			Reserve(JSON_RANGE_SIZE);
+		} else if (buffer_size == buffer_capacity) {
+			// the line does not fit in the buffer
+			Reserve(buffer_capacity * 2);
+		}
+		auto bytes_read = handle->Read(buffer.get() + buffer_size, buffer_capacity - buffer_size);
+		if (bytes_read == 0) {
+			eof = true;
+		}
+		buffer_size += bytes_read;
+	}
+
+private:
+	unique_ptr<FileHandle> handle;
+	idx_t handle_file_index;
+
+	unique_ptr<char[]> buffer;
+	idx_t buffer_capacity;
+	idx_t buffer_size;
+	idx_t buffer_pos;
+	//! The offset in the file of the first byte in the buffer
+	idx_t buffer_file_offset;
+
+	bool streaming;
+	bool eof;
+};
+
+struct ReadJSONOperatorData : public FunctionOperatorData {
+	vector<column_t> column_ids;
+	bool is_parallel;
+	//! The range state of a sequential scan
+	ReadJSONParallelState sequential_state;
+	JSONLineReader reader;
+};
+
+static bool IsWhitespaceLine(const char *line, idx_t line_len) {
+	for (idx_t i = 0; i < line_len; i++) {
+		if (!StringUtil::CharacterIsSpace(line[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Parse the next line into a document, returns false if the line should be skipped
+static bool ReadJSONLine(const ReadJSONBindData &bind_data, JSONLineReader &reader, const char *line, idx_t line_len,
+                         vector<DocPointer<yyjson_doc>> &docs) {
+	if (IsWhitespaceLine(line, line_len)) {
+		return false;
+	}
+	auto doc = JSONCommon::ReadDocumentUnsafe(string_t(line, line_len));
+	if (doc.IsNull()) {
+		if (bind_data.ignore_errors) {
+			return false;
+		}
+		throw InvalidInputException("Malformed JSON in file \"%s\" at byte offset %llu", reader.file_name,
+		                            reader.line_offset);
+	}
+	docs.push_back(move(doc));
+	return true;
+}
+
+//! Replace types that could not be inferred (only NULL values were seen) with JSON
+static LogicalType ReplaceNullType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::SQLNULL:
+		return LogicalType::JSON;
+	case LogicalTypeId::LIST:
+		return LogicalType::LIST(ReplaceNullType(ListType::GetChildType(type)));
+	case LogicalTypeId::STRUCT: {
+		child_list_t<LogicalType> child_types;
+		for (auto &child : StructType::GetChildTypes(type)) {
+			child_types.emplace_back(child.first, ReplaceNullType(child.second));
+		}
+		return LogicalType::STRUCT(move(child_types));
+	}
+	default:
+		return type;
+	}
+}
+
+static LogicalType InferType(const vector<yyjson_mut_val *> &structures, yyjson_mut_doc *structure_doc) {
+	try {
+		auto structure = JSONStructure::MergeStructures(structures, structure_doc);
+		return ReplaceNullType(JSONStructure::StructureToType(structure));
+	} catch (InvalidInputException &ex) {
+		// inconsistent structure, e.g. an array in one record and an object in another
+		return LogicalType::JSON;
+	}
+}
+
+//! Infer the columns from the structure of the first sample_size records of the first file
+static void InferSchema(ClientContext &context, ReadJSONBindData &bind_data, idx_t sample_size) {
+	JSONLineReader reader;
+	reader.Initialize(context, bind_data, {0, 0, DConstants::INVALID_INDEX});
+
+	auto structure_doc = JSONCommon::CreateDocument();
+	vector<yyjson_mut_val *> record_structures;
+	vector<string> key_order;
+	unordered_map<string, vector<yyjson_mut_val *>> key_structures;
+	bool all_objects = true;
+
+	const char *line;
+	idx_t line_len;
+	vector<DocPointer<yyjson_doc>> docs;
+	while (record_structures.size() < sample_size && reader.NextLine(line, line_len)) {
+		if (!ReadJSONLine(bind_data, reader, line, line_len, docs)) {
+			continue;
+		}
+		auto root = docs.back()->root;
+		record_structures.push_back(JSONStructure::BuildStructure(root, *structure_doc));
+		if (!yyjson_is_obj(root)) {
+			all_objects = false;
+			continue;
+		}
+		size_t idx, max;
+		yyjson_val *key, *val;
+		yyjson_obj_foreach(root, idx, max, key, val) {
+			string key_string(yyjson_get_str(key), yyjson_get_len(key));
+			auto entry = key_structures.find(key_string);
+			if (entry == key_structures.end()) {
+				key_order.push_back(key_string);
+				entry = key_structures.insert(make_pair(key_string, vector<yyjson_mut_val *>())).first;
+			}
+			entry->second.push_back(JSONStructure::BuildStructure(val, *structure_doc));
+		}
+	}
+	if (record_structures.empty()) {
+		throw InvalidInputException("Could not infer the schema of \"%s\": the file contains no JSON records, "
+		                            "specify the columns with the \"columns\" parameter",
+		                            bind_data.files[0]);
+	}
+
+	if (!all_objects || key_order.empty()) {
+		bind_data.records_are_objects = false;
+		bind_data.names.push_back(JSON_DEFAULT_COLUMN_NAME);
+		bind_data.types.push_back(InferType(record_structures, *structure_doc));
+		return;
+	}
+	for (auto &key : key_order) {
+		bind_data.names.push_back(key);
+		bind_data.types.push_back(InferType(key_structures[key], *structure_doc));
+	}
+}
+
+static unique_ptr<FunctionData> ReadJSONBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto &config = DBConfig::GetConfig(context);
+	if (!config.enable_external_access) {
+		throw PermissionException("Scanning JSON files is disabled through configuration");
+	}
+	auto result = make_unique<ReadJSONBindData>();
+	auto file_pattern = StringValue::Get(input.inputs[0]);
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->files = fs.Glob(file_pattern, context);
+	if (result->files.empty()) {
+		throw IOException("No files found that match the pattern \"%s\"", file_pattern);
+	}
+
+	idx_t sample_size = JSON_DEFAULT_SAMPLE_SIZE;
+	for (auto &kv : input.named_parameters) {
+		auto loption = StringUtil::Lower(kv.first);
+		if (loption == "columns") {
+			auto &child_type = kv.second.type();
+			if (child_type.id() != LogicalTypeId::STRUCT) {
+				throw BinderException("read_json \"columns\" parameter requires a struct as input");
+			}
+			auto &struct_children = StructValue::GetChildren(kv.second);
+			D_ASSERT(StructType::GetChildCount(child_type) == struct_children.size());
+			for (idx_t i = 0; i < struct_children.size(); i++) {
+				auto &val = struct_children[i];
+				if (val.type().id() != LogicalTypeId::VARCHAR) {
+					throw BinderException("read_json \"columns\" parameter requires a type specification as string");
+				}
+				result->names.push_back(StructType::GetChildName(child_type, i));
+				result->types.push_back(TransformStringToLogicalType(StringValue::Get(val)));
+			}
+			if (result->names.empty()) {
+				throw BinderException("read_json \"columns\" parameter needs at least one column");
+			}
+		} else if (loption == "sample_size") {
+			auto arg = BigIntValue::Get(kv.second);
+			if (arg == -1) {
+				sample_size = NumericLimits<idx_t>::Maximum();
+			} else if (arg > 0) {
+				sample_size = arg;
+			} else {
+				throw BinderException("read_json \"sample_size\" parameter must be positive, or -1 to sample all input");
+			}
+		} else if (loption == "ignore_errors") {
+			result->ignore_errors = BooleanValue::Get(kv.second);
+		} else if (loption == "compression") {
+			result->compression = FileCompressionTypeFromString(StringValue::Get(kv.second));
+		}
+	}
+
+	// files that can seek are split into ranges, others (e.g. compressed files) are read by a single thread
+	for (auto &file : result->files) {
+		auto handle = fs.OpenFile(file, FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK, result->compression,
+		                          FileSystem::GetFileOpener(context));
+		result->file_sizes.push_back(handle->CanSeek() ? handle->GetFileSize() : DConstants::INVALID_INDEX);
+	}
+
+	if (result->names.empty()) {
+		InferSchema(context, *result, sample_size);
+	}
+	names = result->names;
+	return_types = result->types;
+	return move(result);
+}
+
+static unique_ptr<FunctionOperatorData> ReadJSONInit(ClientContext &context, const FunctionData *bind_data_p,
+                                                     const vector<column_t> &column_ids,
+                                                     TableFilterCollection *filters) {
+	auto result = make_unique<ReadJSONOperatorData>();
+	result->column_ids = column_ids;
+	result->is_parallel = false;
+	return move(result);
+}
+
+static bool ReadJSONParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
+                                      FunctionOperatorData *state_p, ParallelState *parallel_state_p) {
+	if (!state_p) {
+		return false;
+	}
+	auto &bind_data = (ReadJSONBindData &)*bind_data_p;
+	auto &parallel_state = (ReadJSONParallelState &)*parallel_state_p;
+	auto &state = (ReadJSONOperatorData &)*state_p;
+	JSONScanRange range;
+	if (!parallel_state.NextRange(bind_data, range)) {
+		return false;
+	}
+	state.reader.Initialize(context, bind_data, range);
+	return true;
+}
+
+static unique_ptr<FunctionOperatorData> ReadJSONParallelInit(ClientContext &context, const FunctionData *bind_data_p,
+                                                             ParallelState *parallel_state_p,
+                                                             const vector<column_t> &column_ids,
+                                                             TableFilterCollection *filters) {
+	auto result = make_unique<ReadJSONOperatorData>();
+	result->column_ids = column_ids;
+	result->is_parallel = true;
+	if (!ReadJSONParallelStateNext(context, bind_data_p, result.get(), parallel_state_p)) {
+		return nullptr;
+	}
+	return move(result);
+}
+
+static void ReadJSONFunction(ClientContext &context, const FunctionData *bind_data_p,
+                             FunctionOperatorData *operator_state, DataChunk &output) {
+	if (!operator_state) {
+		return;
+	}
+	auto &bind_data = (ReadJSONBindData &)*bind_data_p;
+	auto &state = (ReadJSONOperatorData &)*operator_state;
+
+	// parse the next batch of lines
+	vector<DocPointer<yyjson_doc>> docs;
+	docs.reserve(STANDARD_VECTOR_SIZE);
+	const char *line;
+	idx_t line_len;
+	while (docs.size() < STANDARD_VECTOR_SIZE) {
+		if (!state.reader.NextLine(line, line_len)) {
+			// the range is exhausted: a parallel scan gets its next range through ReadJSONParallelStateNext
+			JSONScanRange range;
+			if (state.is_parallel || !state.sequential_state.NextRange(bind_data, range)) {
+				break;
+			}
+			state.reader.Initialize(context, bind_data, range);
+			continue;
+		}
+		ReadJSONLine(bind_data, state.reader, line, line_len, docs);
+	}
+	const idx_t count = docs.size();
+	if (count == 0) {
+		return;
+	}
+
+	// transform only the projected columns
+	yyjson_val *vals[STANDARD_VECTOR_SIZE];
+	for (idx_t col_idx = 0; col_idx < state.column_ids.size(); col_idx++) {
+		auto column_id = state.column_ids[col_idx];
+		auto &result = output.data[col_idx];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			// row ids are not meaningful for JSON files
+			result.Reference(Value::BIGINT(0));
+			continue;
+		}
+		if (bind_data.records_are_objects) {
+			auto &name = bind_data.names[column_id];
+			for (idx_t i = 0; i < count; i++) {
+				vals[i] = yyjson_obj_getn(docs[i]->root, name.c_str(), name.size());
+			}
+		} else {
+			for (idx_t i = 0; i < count; i++) {
+				vals[i] = docs[i]->root;
+			}
+		}
+		JSONTransform::TransformValues(vals, result, count, false, true);
+	}
+	output.SetCardinality(count);
+}
+
+static void ReadJSONFunctionParallel(ClientContext &context, const FunctionData *bind_data,
+                                     FunctionOperatorData *operator_state, DataChunk &output,
+                                     ParallelState *parallel_state_p) {
+	ReadJSONFunction(context, bind_data, operator_state, output);
+}
+
+static idx_t ReadJSONMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = (ReadJSONBindData &)*bind_data_p;
+	idx_t range_count = 0;
+	for (auto &file_size : bind_data.file_sizes) {
+		range_count += file_size == DConstants::INVALID_INDEX ? 1 : file_size / JSON_RANGE_SIZE + 1;
+	}
+	return range_count;
+}
+
+static unique_ptr<ParallelState> ReadJSONInitParallelState(ClientContext &context, const FunctionData *bind_data_p,
+                                                           const vector<column_t> &column_ids,
+                                                           TableFilterCollection *filters) {
+	return make_unique<ReadJSONParallelState>();
+}
+
+static TableFunction GetReadJSONFunction(const string &name) {
+	TableFunction table_function(name, {LogicalType::VARCHAR}, ReadJSONFunction, ReadJSONBind, ReadJSONInit,
+	                             /* statistics */ nullptr, /* cleanup */ nullptr,
+	                             /* dependency */ nullptr, /* cardinality */ nullptr,
+	                             /* pushdown_complex_filter */ nullptr, /* to_string */ nullptr, ReadJSONMaxThreads,
+	                             ReadJSONInitParallelState, ReadJSONFunctionParallel, ReadJSONParallelInit,
+	                             ReadJSONParallelStateNext, true, false, nullptr);
+	table_function.named_parameters["columns"] = LogicalType::ANY;
+	table_function.named_parameters["sample_size"] = LogicalType::BIGINT;
+	table_function.named_parameters["ignore_errors"] = LogicalType::BOOLEAN;
+	table_function.named_parameters["compression"] = LogicalType::VARCHAR;
+	return table_function;
+}
+
+CreateTableFunctionInfo JSONFunctions::GetReadJSONFunction() {
+	return CreateTableFunctionInfo(duckdb::GetReadJSONFunction("read_json"));
+}
+
+CreateTableFunctionInfo JSONFunctions::GetReadNDJSONFunction() {
+	return CreateTableFunctionInfo(duckdb::GetReadJSONFunction("read_ndjson"));
+}
+
+} // namespace duckdb
@@ -172,7 +172,7 @@ void RleBpEncoder::FinishWrite(Serializer &writer) {
 ColumnWriter::ColumnWriter(ParquetWriter &writer, idx_t schema_idx, vector<string> schema_path_p, idx_t max_repeat,
                            idx_t max_define, bool can_have_nulls)
     : writer(writer), schema_idx(schema_idx), schema_path(move(schema_path_p)), max_repeat(max_repeat),
-      max_define(max_define), can_have_nulls(can_have_nulls), null_count(0) {
+      max_define(max_define), can_have_nulls(can_have_nulls) {
 }
 ColumnWriter::~ColumnWriter() {
 }
@@ -305,7 +305,7 @@ void ColumnWriter::HandleDefineLevels(ColumnWriterState &state, ColumnWriterStat
 				if (!can_have_nulls) {
 					throw IOException("Parquet writer: map key column is not allowed to contain NULL values");
 				}
-				null_count++;
+				state.null_count++;
 				state.definition_levels.push_back(null_value);
 			}
 			if (parent->is_empty.empty() || !parent->is_empty[current_index]) {
@@ -321,7 +321,7 @@ void ColumnWriter::HandleDefineLevels(ColumnWriterState &state, ColumnWriterStat
 				if (!can_have_nulls) {
 					throw IOException("Parquet writer: map key column is not allowed to contain NULL values");
 				}
-				null_count++;
+				state.null_count++;
 				state.definition_levels.push_back(null_value);
 			}
 		}
@@ -537,7 +537,7 @@ void ColumnWriter::Write(ColumnWriterState &state_p, Vector &vector, idx_t count
 void ColumnWriter::SetParquetStatistics(StandardColumnWriterState &state,
                                         duckdb_parquet::format::ColumnChunk &column_chunk) {
 	if (max_repeat == 0) {
-		column_chunk.meta_data.statistics.null_count = null_count;
+		column_chunk.meta_data.statistics.null_count = state.null_count;
 		column_chunk.meta_data.statistics.__isset.null_count = true;
 		column_chunk.meta_data.__isset.statistics = true;
 	}
@@ -577,10 +577,15 @@ void ColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	FlushPage(state);
 	// flush the dictionary
 	FlushDictionary(state, state.stats_state.get());
+	SetParquetStatistics(state, column_chunk);
+}
+
+void ColumnWriter::FlushWrite(ColumnWriterState &state_p) {
+	auto &state = (StandardColumnWriterState &)state_p;
+	auto &column_chunk = state.row_group.columns[state.col_idx];
 
 	// record the start position of the pages for this column
 	column_chunk.meta_data.data_page_offset = writer.writer->GetTotalWritten();
-	SetParquetStatistics(state, column_chunk);
 
 	// write the individual pages to disk
 	for (auto &write_info : state.write_info) {
@@ -1261,6 +1266,7 @@ public:
 	void BeginWrite(ColumnWriterState &state) override;
 	void Write(ColumnWriterState &state, Vector &vector, idx_t count) override;
 	void FinalizeWrite(ColumnWriterState &state) override;
+	void FlushWrite(ColumnWriterState &state) override;
 };
 
 class StructColumnWriterState : public ColumnWriterState {
@@ -1322,11 +1328,18 @@ void StructColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	auto &state = (StructColumnWriterState &)state_p;
 	for (idx_t child_idx = 0; child_idx < child_writers.size(); child_idx++) {
 		// we add the null count of the struct to the null count of the children
-		child_writers[child_idx]->null_count += null_count;
+		state.child_states[child_idx]->null_count += state.null_count;
 		child_writers[child_idx]->FinalizeWrite(*state.child_states[child_idx]);
 	}
 }
 
+void StructColumnWriter::FlushWrite(ColumnWriterState &state_p) {
+	auto &state = (StructColumnWriterState &)state_p;
+	for (idx_t child_idx = 0; child_idx < child_writers.size(); child_idx++) {
+		child_writers[child_idx]->FlushWrite(*state.child_states[child_idx]);
+	}
+}
+
 //===--------------------------------------------------------------------===//
 // List Column Writer
 //===--------------------------------------------------------------------===//
@@ -1348,6 +1361,7 @@ public:
 	void BeginWrite(ColumnWriterState &state) override;
 	void Write(ColumnWriterState &state, Vector &vector, idx_t count) override;
 	void FinalizeWrite(ColumnWriterState &state) override;
+	void FlushWrite(ColumnWriterState &state) override;
 };
 
 class ListColumnWriterState : public ColumnWriterState {
@@ -1443,6 +1457,11 @@ void ListColumnWriter::FinalizeWrite(ColumnWriterState &state_p) {
 	child_writer->FinalizeWrite(*state.child_state);
 }
 
+void ListColumnWriter::FlushWrite(ColumnWriterState &state_p) {
+	auto &state = (ListColumnWriterState &)state_p;
+	child_writer->FlushWrite(*state.child_state);
+}
+
 //===--------------------------------------------------------------------===//
 // Create Column Writer
 //===--------------------------------------------------------------------===//
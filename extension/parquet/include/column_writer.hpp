@@ -24,6 +24,8 @@ public:
 	vector<uint16_t> definition_levels;
 	vector<uint16_t> repetition_levels;
 	vector<bool> is_empty;
+	//! The number of NULL values in the row group
+	idx_t null_count = 0;
 };
 
 class ColumnWriterStatistics {
@@ -52,8 +54,6 @@ public:
 	idx_t max_repeat;
 	idx_t max_define;
 	bool can_have_nulls;
-	// collected stats
-	idx_t null_count;
 
 public:
 	//! Create the column writer for a specific type recursively
@@ -68,7 +68,11 @@ public:
 
 	virtual void BeginWrite(ColumnWriterState &state);
 	virtual void Write(ColumnWriterState &state, Vector &vector, idx_t count);
+	//! Finishes encoding the column: compresses the last page and the dictionary, and sets the statistics. The column
+	//! writers only modify their state, so multiple row groups can be encoded concurrently.
 	virtual void FinalizeWrite(ColumnWriterState &state);
+	//! Writes the encoded pages of the column to the file
+	virtual void FlushWrite(ColumnWriterState &state);
 
 protected:
 	void HandleDefineLevels(ColumnWriterState &state, ColumnWriterState *parent, ValidityMask &validity, idx_t count,
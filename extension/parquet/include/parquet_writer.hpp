@@ -25,6 +25,12 @@ namespace duckdb {
 class FileSystem;
 class FileOpener;
 
+//! A row group that has been encoded, but not yet written to the file
+struct PreparedRowGroup {
+	duckdb_parquet::format::RowGroup row_group;
+	vector<unique_ptr<ColumnWriterState>> states;
+};
+
 class ParquetWriter {
 	friend class ColumnWriter;
 	friend class ListColumnWriter;
@@ -35,6 +41,12 @@ public:
 	              vector<string> names, duckdb_parquet::format::CompressionCodec::type codec);
 
 public:
+	//! Encodes the buffer as a row group. This does not write to the file, and can run concurrently with other calls.
+	//! The column states refer to the row group: the prepared row group must not be moved after this call.
+	void PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result);
+	//! Writes a prepared row group to the file
+	void FlushRowGroup(PreparedRowGroup &row_group);
+	//! Encodes the buffer as a row group and writes it to the file
 	void Flush(ChunkCollection &buffer);
 	void Finalize();
 
@@ -478,6 +478,7 @@ void ParquetWriteCombine(ClientContext &context, FunctionData &bind_data, Global
 	auto &local_state = (ParquetWriteLocalState &)lstate;
 	// flush any data left in the local state to the file
 	global_state.writer->Flush(*local_state.buffer);
+	local_state.buffer = make_unique<ChunkCollection>();
 }
 
 void ParquetWriteFinalize(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate) {
@@ -490,6 +491,33 @@ unique_ptr<LocalFunctionData> ParquetWriteInitializeLocal(ClientContext &context
 	return make_unique<ParquetWriteLocalState>();
 }
 
+//===--------------------------------------------------------------------===//
+// Parallel Write
+//===--------------------------------------------------------------------===//
+struct ParquetWriteBatchData : public PreparedBatchData {
+	PreparedRowGroup prepared_row_group;
+};
+
+unique_ptr<PreparedBatchData> ParquetWritePrepareBatch(ClientContext &context, FunctionData &bind_data,
+                                                       GlobalFunctionData &gstate, ChunkCollection &collection) {
+	auto &global_state = (ParquetWriteGlobalState &)gstate;
+	auto result = make_unique<ParquetWriteBatchData>();
+	global_state.writer->PrepareRowGroup(collection, result->prepared_row_group);
+	return move(result);
+}
+
+void ParquetWriteFlushBatch(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                            PreparedBatchData &batch_p) {
+	auto &global_state = (ParquetWriteGlobalState &)gstate;
+	auto &batch = (ParquetWriteBatchData &)batch_p;
+	global_state.writer->FlushRowGroup(batch.prepared_row_group);
+}
+
+idx_t ParquetWriteDesiredBatchSize(ClientContext &context, FunctionData &bind_data_p) {
+	auto &bind_data = (ParquetWriteBindData &)bind_data_p;
+	return bind_data.row_group_size;
+}
+
 unique_ptr<TableFunctionRef> ParquetScanReplacement(ClientContext &context, const string &table_name,
                                                     ReplacementScanData *data) {
 	if (!StringUtil::EndsWith(StringUtil::Lower(table_name), ".parquet")) {
@@ -525,6 +553,9 @@ void ParquetExtension::Load(DuckDB &db) {
 	function.copy_to_sink = ParquetWriteSink;
 	function.copy_to_combine = ParquetWriteCombine;
 	function.copy_to_finalize = ParquetWriteFinalize;
+	function.copy_to_prepare_batch = ParquetWritePrepareBatch;
+	function.copy_to_flush_batch = ParquetWriteFlushBatch;
+	function.copy_to_desired_batch_size = ParquetWriteDesiredBatchSize;
 	function.copy_from_bind = ParquetScanFunction::ParquetReadBind;
 	function.copy_from_function = scan_fun.functions[0];
 
@@ -245,37 +245,52 @@ ParquetWriter::ParquetWriter(FileSystem &fs, string file_name_p, FileOpener *fil
 	}
 }
 
-void ParquetWriter::Flush(ChunkCollection &buffer) {
-	if (buffer.Count() == 0) {
-		return;
-	}
-	lock_guard<mutex> glock(lock);
-
+void ParquetWriter::PrepareRowGroup(ChunkCollection &buffer, PreparedRowGroup &result) {
 	// set up a new row group for this chunk collection
-	ParquetRowGroup row_group;
+	auto &row_group = result.row_group;
 	row_group.num_rows = buffer.Count();
-	row_group.file_offset = writer->GetTotalWritten();
 	row_group.__isset.file_offset = true;
 
-	// iterate over each of the columns of the chunk collection and write them
+	// iterate over each of the columns of the chunk collection and encode them
+	auto &states = result.states;
 	auto &chunks = buffer.Chunks();
 	D_ASSERT(buffer.ColumnCount() == column_writers.size());
 	for (idx_t col_idx = 0; col_idx < buffer.ColumnCount(); col_idx++) {
-		auto write_state = column_writers[col_idx]->InitializeWriteState(row_group);
+		states.push_back(column_writers[col_idx]->InitializeWriteState(row_group));
+		auto &write_state = *states.back();
 		for (idx_t chunk_idx = 0; chunk_idx < chunks.size(); chunk_idx++) {
-			column_writers[col_idx]->Prepare(*write_state, nullptr, chunks[chunk_idx]->data[col_idx],
+			column_writers[col_idx]->Prepare(write_state, nullptr, chunks[chunk_idx]->data[col_idx],
 			                                 chunks[chunk_idx]->size());
 		}
-		column_writers[col_idx]->BeginWrite(*write_state);
+		column_writers[col_idx]->BeginWrite(write_state);
 		for (idx_t chunk_idx = 0; chunk_idx < chunks.size(); chunk_idx++) {
-			column_writers[col_idx]->Write(*write_state, chunks[chunk_idx]->data[col_idx], chunks[chunk_idx]->size());
+			column_writers[col_idx]->Write(write_state, chunks[chunk_idx]->data[col_idx], chunks[chunk_idx]->size());
 		}
-		column_writers[col_idx]->FinalizeWrite(*write_state);
+		column_writers[col_idx]->FinalizeWrite(write_state);
+	}
+}
+
+void ParquetWriter::FlushRowGroup(PreparedRowGroup &prepared) {
+	lock_guard<mutex> glock(lock);
+	auto &row_group = prepared.row_group;
+	auto &states = prepared.states;
+	row_group.file_offset = writer->GetTotalWritten();
+	for (idx_t col_idx = 0; col_idx < states.size(); col_idx++) {
+		column_writers[col_idx]->FlushWrite(*states[col_idx]);
 	}
 
 	// append the row group to the file meta data
 	file_meta_data.row_groups.push_back(row_group);
-	file_meta_data.num_rows += buffer.Count();
+	file_meta_data.num_rows += row_group.num_rows;
+}
+
+void ParquetWriter::Flush(ChunkCollection &buffer) {
+	if (buffer.Count() == 0) {
+		return;
+	}
+	PreparedRowGroup prepared;
+	PrepareRowGroup(buffer, prepared);
+	FlushRowGroup(prepared);
 }
 
 void ParquetWriter::Finalize() {
@@ -3,6 +3,9 @@ import sys
 import subprocess
 from io import StringIO
 import csv
+import json
+import math
+import random
 import statistics
 
 # how many times we will run the experiment, to be sure of the regression
@@ -12,39 +15,85 @@ regression_threshold_percentage = 0.1
 # minimal seconds diff for something to be a regression (for very fast benchmarks)
 regression_threshold_seconds = 0.01
 
+# statistical mode: the significance level of the one-sided Mann-Whitney U test
+significance_level = 0.01
+# statistical mode: the amount of bootstrap resamples used for the confidence interval of the slowdown
+bootstrap_samples = 2000
+
 old_runner = None
 new_runner = None
+old_results_file = None
+new_results_file = None
 benchmark_file = None
 verbose = False
 threads = None
+statistical = False
+profile_dir = None
 for arg in sys.argv:
     if arg.startswith("--old="):
         old_runner = arg.replace("--old=", "")
     elif arg.startswith("--new="):
         new_runner = arg.replace("--new=", "")
+    elif arg.startswith("--old-results="):
+        old_results_file = arg.replace("--old-results=", "")
+    elif arg.startswith("--new-results="):
+        new_results_file = arg.replace("--new-results=", "")
     elif arg.startswith("--benchmarks="):
         benchmark_file = arg.replace("--benchmarks=", "")
     elif arg == "--verbose":
         verbose = True
     elif arg == "--threads=":
         threads = int(arg.replace("--threads="))
+    elif arg == "--statistical":
+        statistical = True
+    elif arg.startswith("--repetitions="):
+        number_repetitions = int(arg.replace("--repetitions=", ""))
+    elif arg.startswith("--profile-dir="):
+        profile_dir = arg.replace("--profile-dir=", "")
 
-if old_runner is None or new_runner is None or benchmark_file is None:
-    print("Expected usage: python3 scripts/regression_test_runner.py --old=/old/benchmark_runner --new=/new/benchmark_runner --benchmarks=/benchmark/list.csv")
+compare_result_files = old_results_file is not None or new_results_file is not None
+if compare_result_files:
+    if old_results_file is None or new_results_file is None:
+        print("Expected usage: python3 scripts/regression_test_runner.py --old-results=/old/results.csv --new-results=/new/results.csv")
+        exit(1)
+    statistical = True
+elif old_runner is None or new_runner is None or benchmark_file is None:
+    print("Expected usage: python3 scripts/regression_test_runner.py --old=/old/benchmark_runner --new=/new/benchmark_runner --benchmarks=/benchmark/list.csv [--statistical] [--repetitions=n] [--profile-dir=/path/to/dir]")
+    print("           or: python3 scripts/regression_test_runner.py --old-results=/old/results.csv --new-results=/new/results.csv")
     exit(1)
 
-if not os.path.isfile(old_runner):
-    print(f"Failed to find old runner {old_runner}")
-    exit(1)
+if not compare_result_files:
+    if not os.path.isfile(old_runner):
+        print(f"Failed to find old runner {old_runner}")
+        exit(1)
 
-if not os.path.isfile(new_runner):
-    print(f"Failed to find new runner {new_runner}")
-    exit(1)
+    if not os.path.isfile(new_runner):
+        print(f"Failed to find new runner {new_runner}")
+        exit(1)
 
-def run_benchmark(runner, benchmark):
+def parse_timings(output):
+    # parse the "name run timing" lines written by the benchmark runner, grouped by benchmark
+    # other lines (the header, per-run metrics, TIMEOUT or INCORRECT results) are skipped
+    timings = {}
+    f = StringIO(output)
+    csv_reader = csv.reader(f, delimiter='\t')
+    for row in csv_reader:
+        if len(row) != 3 or not row[1].isdigit():
+            continue
+        try:
+            timing = float(row[2])
+        except ValueError:
+            continue
+        timings.setdefault(row[0], []).append(timing)
+    return timings
+
+def run_benchmark_timings(runner, benchmark, log_file=None):
     benchmark_args = [runner, benchmark]
     if threads is not None:
         benchmark_args += ["--threads=%d" % (threads,)]
+    if log_file is not None:
+        # with --profile, the runner writes the query profile of every run to the log file
+        benchmark_args += ["--profile", "--log=" + log_file]
     proc = subprocess.Popen(benchmark_args, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
     out = proc.stdout.read().decode('utf8')
     err = proc.stderr.read().decode('utf8')
@@ -64,24 +113,15 @@ def run_benchmark(runner, benchmark):
         exit(1)
     if verbose:
         print(err)
-    # read the input CSV
-    f = StringIO(err)
-    csv_reader = csv.reader(f, delimiter='\t')
-    header = True
-    timings = []
-    try:
-        for row in csv_reader:
-            if len(row) == 0:
-                continue
-            if header:
-                header = False
-            else:
-                timings.append(row[2])
-    except:
+    timings = parse_timings(err).get(benchmark, [])
+    if len(timings) == 0:
         print("Failed to run benchmark " + benchmark)
         print(err)
         exit(1)
-    return float(statistics.median(timings))
+    return timings
+
+def run_benchmark(runner, benchmark):
+    return float(statistics.median(run_benchmark_timings(runner, benchmark)))
 
 def run_benchmarks(runner, benchmark_list):
     results = {}
@@ -89,6 +129,170 @@ def run_benchmarks(runner, benchmark_list):
         results[benchmark] = run_benchmark(runner, benchmark)
     return results
 
+def mann_whitney_greater(old, new):
+    # one-sided Mann-Whitney U test with the hypothesis that the new timings are larger than the old timings
+    # returns the p-value, using the normal approximation with a correction for ties
+    n1 = len(old)
+    n2 = len(new)
+    values = sorted([(x, 0) for x in old] + [(x, 1) for x in new])
+    # assign (average) ranks to all values
+    ranks = [0.0] * len(values)
+    tie_correction = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        tie_count = j - i + 1
+        tie_correction += tie_count ** 3 - tie_count
+        i = j + 1
+    new_rank_sum = sum(rank for rank, value in zip(ranks, values) if value[1] == 1)
+    u = new_rank_sum - n2 * (n2 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_correction / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    # continuity correction
+    z = (u - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+def bootstrap_ratio_interval(old, new, confidence=0.95):
+    # bootstrap confidence interval of the ratio of the median new timing to the median old timing
+    rng = random.Random(42)
+    ratios = []
+    for _ in range(bootstrap_samples):
+        old_sample = [rng.choice(old) for _ in old]
+        new_sample = [rng.choice(new) for _ in new]
+        ratios.append(statistics.median(new_sample) / max(statistics.median(old_sample), sys.float_info.min))
+    ratios.sort()
+    alpha = (1.0 - confidence) / 2
+    return ratios[int(alpha * (len(ratios) - 1))], ratios[int((1 - alpha) * (len(ratios) - 1))]
+
+def compare_timings(benchmark, old, new):
+    old_median = statistics.median(old)
+    new_median = statistics.median(new)
+    p_value = mann_whitney_greater(old, new)
+    ci_low, ci_high = bootstrap_ratio_interval(old, new)
+    # a regression must be statistically significant AND larger than the (relative and absolute) thresholds
+    is_regression = (
+        p_value < significance_level
+        and ci_low > 1.0
+        and (old_median + regression_threshold_seconds) * (1.0 + regression_threshold_percentage) < new_median
+    )
+    return {
+        'benchmark': benchmark,
+        'old_median': old_median,
+        'new_median': new_median,
+        'old_runs': len(old),
+        'new_runs': len(new),
+        'p_value': p_value,
+        'ci_low': ci_low,
+        'ci_high': ci_high,
+        'regression': is_regression,
+    }
+
+def print_comparison(result):
+    print(f"{result['benchmark']}")
+    print(f"Old median: {result['old_median']:.6f} ({result['old_runs']} runs)")
+    print(f"New median: {result['new_median']:.6f} ({result['new_runs']} runs)")
+    print(f"New/old ratio 95% CI: [{result['ci_low']:.3f}, {result['ci_high']:.3f}], p-value: {result['p_value']:.5f}")
+    print("")
+
+def profile_prefix(benchmark, suffix):
+    return os.path.join(profile_dir, benchmark.replace('/', '_') + '.' + suffix)
+
+def split_profiles(log_file, prefix):
+    # the log contains one JSON profile per run, possibly followed by metric lines: write every profile to its own file
+    with open(log_file, 'r') as f:
+        log = f.read()
+    decoder = json.JSONDecoder()
+    profile_files = []
+    pos = 0
+    while pos < len(log):
+        if log[pos] != '{':
+            # skip to the next line
+            next_line = log.find('\n', pos)
+            pos = len(log) if next_line < 0 else next_line + 1
+            continue
+        try:
+            profile, pos = decoder.raw_decode(log, pos)
+        except ValueError:
+            break
+        profile_files.append(f"{prefix}.run{len(profile_files) + 1}.json")
+        with open(profile_files[-1], 'w') as f:
+            json.dump(profile, f, indent=2)
+    os.remove(log_file)
+    return profile_files
+
+def capture_profiles(runner, benchmark, suffix):
+    prefix = profile_prefix(benchmark, suffix)
+    log_file = prefix + '.log'
+    if os.path.exists(log_file):
+        os.remove(log_file)
+    run_benchmark_timings(runner, benchmark, log_file)
+    return split_profiles(log_file, prefix)
+
+def run_statistical():
+    # collect all timings of the old and the new runner
+    old_timings = {}
+    new_timings = {}
+    if compare_result_files:
+        with open(old_results_file, 'r') as f:
+            old_timings = parse_timings(f.read())
+        with open(new_results_file, 'r') as f:
+            new_timings = parse_timings(f.read())
+        benchmark_list = sorted(set(old_timings.keys()) & set(new_timings.keys()))
+    else:
+        with open(benchmark_file, 'r') as f:
+            benchmark_list = [x.strip() for x in f.read().split('\n') if len(x) > 0]
+        for i in range(number_repetitions):
+            print(f"Repetition {i + 1}/{number_repetitions}")
+            for benchmark in benchmark_list:
+                # interleave the runners, alternating which one goes first, so that drift in the machine state
+                # (e.g. thermal throttling or background load) affects both runners equally
+                runners = [(old_runner, old_timings), (new_runner, new_timings)]
+                if i % 2 == 1:
+                    runners.reverse()
+                for runner, timings in runners:
+                    timings.setdefault(benchmark, []).extend(run_benchmark_timings(runner, benchmark))
+
+    results = [compare_timings(x, old_timings[x], new_timings[x]) for x in benchmark_list]
+    regression_list = [x for x in results if x['regression']]
+    other_results = [x for x in results if not x['regression']]
+
+    if len(regression_list) > 0:
+        print('''====================================================
+==============  REGRESSIONS DETECTED   =============
+====================================================
+''')
+        for regression in regression_list:
+            print_comparison(regression)
+            if profile_dir is not None and not compare_result_files:
+                # capture the query profile of both runners for the regressed benchmark
+                os.makedirs(profile_dir, exist_ok=True)
+                old_profiles = capture_profiles(old_runner, regression['benchmark'], 'old')
+                new_profiles = capture_profiles(new_runner, regression['benchmark'], 'new')
+                print(f"Profiles written to {profile_prefix(regression['benchmark'], 'old')}.run*.json ({len(old_profiles)} runs) and {profile_prefix(regression['benchmark'], 'new')}.run*.json ({len(new_profiles)} runs)")
+                print("")
+        print('''====================================================
+==============     OTHER TIMINGS       =============
+====================================================
+''')
+    else:
+        print('''====================================================
+============== NO REGRESSIONS DETECTED  =============
+====================================================
+''')
+    for res in other_results:
+        print_comparison(res)
+    return 1 if len(regression_list) > 0 else 0
+
+if statistical:
+    exit(run_statistical())
+
 # read the initial benchmark list
 with open(benchmark_file, 'r') as f:
     benchmark_list = [x.strip() for x in f.read().split('\n') if len(x) > 0]
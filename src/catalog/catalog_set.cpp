@@ -41,8 +41,46 @@ private:
 	idx_t entry_index;
 };
 
+constexpr const idx_t CatalogSnapshotIndex::INITIAL_CAPACITY;
+
+CatalogSnapshotIndex::CatalogSnapshotIndex(idx_t capacity)
+    : capacity(capacity), count(0), names(unique_ptr<atomic<CatalogSnapshotName *>[]>(
+                                         new atomic<CatalogSnapshotName *>[capacity])) {
+	D_ASSERT((capacity & (capacity - 1)) == 0);
+	for (idx_t i = 0; i < capacity; i++) {
+		names[i] = nullptr;
+	}
+}
+
+CatalogSnapshotName *CatalogSnapshotIndex::Find(const string &name) {
+	auto mask = capacity - 1;
+	for (auto slot = CaseInsensitiveStringHashFunction()(name) & mask;; slot = (slot + 1) & mask) {
+		auto entry = names[slot].load();
+		if (!entry) {
+			return nullptr;
+		}
+		if (CaseInsensitiveStringEquality()(entry->name, name)) {
+			return entry;
+		}
+	}
+}
+
+void CatalogSnapshotIndex::Insert(CatalogSnapshotName *name) {
+	D_ASSERT(count * 2 < capacity);
+	auto mask = capacity - 1;
+	auto slot = CaseInsensitiveStringHashFunction()(name->name) & mask;
+	while (names[slot].load()) {
+		slot = (slot + 1) & mask;
+	}
+	// the name is fully constructed before it is published to lookups
+	names[slot].store(name);
+	count++;
+}
+
 CatalogSet::CatalogSet(Catalog &catalog, unique_ptr<DefaultGenerator> defaults)
-    : catalog(catalog), defaults(move(defaults)) {
+    : catalog(catalog), defaults(move(defaults)),
+      current_index(make_unique<CatalogSnapshotIndex>(CatalogSnapshotIndex::INITIAL_CAPACITY)) {
+	snapshot_index = current_index.get();
 }
 
 bool CatalogSet::CreateEntry(ClientContext &context, const string &name, unique_ptr<CatalogEntry> value,
@@ -52,6 +90,7 @@ bool CatalogSet::CreateEntry(ClientContext &context, const string &name, unique_
 	lock_guard<mutex> write_lock(catalog.write_lock);
 	// lock this catalog set to disallow reading
 	lock_guard<mutex> read_lock(catalog_lock);
+	InvalidateSnapshot(name);
 
 	// first check if the entry exists in the unordered set
 	idx_t entry_index;
@@ -169,6 +208,7 @@ bool CatalogSet::AlterEntry(ClientContext &context, const string &name, AlterInf
 	// set the timestamp to the timestamp of the current transaction
 	// and point it to the updated table node
 	string original_name = entry->name;
+	InvalidateSnapshot(original_name);
 	auto value = entry->AlterEntry(context, alter_info);
 	if (!value) {
 		// alter failed, but did not result in an error
@@ -176,6 +216,7 @@ bool CatalogSet::AlterEntry(ClientContext &context, const string &name, AlterInf
 	}
 
 	if (value->name != original_name) {
+		InvalidateSnapshot(value->name);
 		auto mapping_value = GetMapping(context, value->name);
 		if (mapping_value && !mapping_value->deleted) {
 			auto entry = GetEntryForTransaction(context, entries[mapping_value->index].get());
@@ -214,6 +255,10 @@ void CatalogSet::DropEntryDependencies(ClientContext &context, idx_t entry_index
 	EntryDropper dropper(*this, entry_index);
 
 	// To correctly delete the object and its dependencies, it temporarily is set to deleted.
+	{
+		lock_guard<mutex> lock(catalog_lock);
+		InvalidateSnapshot(entry.name);
+	}
 	entries[entry_index].get()->deleted = true;
 
 	// check any dependencies of this object
@@ -229,6 +274,10 @@ void CatalogSet::DropEntryInternal(ClientContext &context, idx_t entry_index, Ca
 
 	DropEntryDependencies(context, entry_index, entry, cascade);
 
+	// the entry might have been published again while its dependencies were dropped
+	lock_guard<mutex> lock(catalog_lock);
+	InvalidateSnapshot(entry.name);
+
 	// create a new entry and replace the currently stored one
 	// set the timestamp to the timestamp of the current transaction
 	// and point it at the dummy node
@@ -266,6 +315,7 @@ void CatalogSet::CleanupEntry(CatalogEntry *catalog_entry) {
 	// destroy the backed up entry: it is no longer required
 	D_ASSERT(catalog_entry->parent);
 	if (catalog_entry->parent->type != CatalogType::UPDATED_ENTRY) {
+		// lookups only read the latest version of an entry, which is not removed here: no need to invalidate it
 		lock_guard<mutex> lock(catalog_lock);
 		if (!catalog_entry->deleted) {
 			// delete the entry from the dependency manager, if it is not deleted yet
@@ -282,6 +332,7 @@ void CatalogSet::CleanupEntry(CatalogEntry *catalog_entry) {
 			if (entry->second.get() == parent) {
 				mapping.erase(mapping_entry);
 				entries.erase(entry);
+				RemoveSnapshotName();
 			}
 		}
 	}
@@ -403,14 +454,153 @@ CatalogEntry *CatalogSet::CreateEntryInternal(ClientContext &context, unique_ptr
 
 	entry->timestamp = 0;
 
+	InvalidateSnapshot(name);
 	PutMapping(context, name, entry_index);
 	mapping[name]->timestamp = 0;
 	entries[entry_index] = move(entry);
 	return catalog_entry;
 }
 
+bool CatalogSet::GetEntryFromSnapshot(ClientContext &context, const string &name, CatalogEntry *&result) {
+	auto snapshot_name = snapshot_index.load()->Find(name);
+	if (!snapshot_name) {
+		// the name was never in the mapping: unless a default entry can still be created for it, it does not exist
+		if (defaults && !defaults->created_all_entries) {
+			return false;
+		}
+		result = nullptr;
+		return true;
+	}
+	auto entry = snapshot_name->entry.load();
+	if (!entry || entry->timestamp >= Transaction::GetTransaction(context).start_time) {
+		// the entry was changed, or it was committed after our transaction started
+		return false;
+	}
+	if (!entry->entry && defaults && !defaults->created_all_entries) {
+		return false;
+	}
+	result = entry->entry;
+	return true;
+}
+
+void CatalogSet::UpdateSnapshot(const string &name) {
+	// every name in the mapping is in the index
+	auto snapshot_name = current_index->Find(name);
+	if (!snapshot_name || snapshot_name->current_entry) {
+		return;
+	}
+	auto mapping_entry = mapping.find(name);
+	if (mapping_entry == mapping.end()) {
+		// the name was removed from the mapping: it does not exist for any transaction
+		snapshot_name->current_entry = make_unique<CatalogSnapshotEntry>(nullptr, 0);
+	} else {
+		// only publish the latest entry once both it and its name are committed
+		auto &mapping_value = *mapping_entry->second;
+		if (mapping_value.deleted || mapping_value.timestamp >= TRANSACTION_ID_START) {
+			return;
+		}
+		auto entry = entries.find(mapping_value.index);
+		if (entry == entries.end()) {
+			return;
+		}
+		auto &catalog_entry = *entry->second;
+		if (catalog_entry.deleted || catalog_entry.timestamp >= TRANSACTION_ID_START) {
+			return;
+		}
+		snapshot_name->current_entry = make_unique<CatalogSnapshotEntry>(
+		    &catalog_entry, MaxValue<transaction_t>(catalog_entry.timestamp, mapping_value.timestamp));
+	}
+	snapshot_name->entry.store(snapshot_name->current_entry.get());
+}
+
+void CatalogSet::InvalidateSnapshot(const string &name) {
+	auto snapshot_name = current_index->Find(name);
+	if (snapshot_name) {
+		if (snapshot_name->current_entry) {
+			snapshot_name->entry.store(nullptr);
+			RetireSnapshot(move(snapshot_name->current_entry), nullptr);
+		}
+		return;
+	}
+	// a new name: add it to the index without an entry
+	if ((current_index->count + 1) * 2 > current_index->capacity) {
+		RebuildSnapshotIndex();
+	}
+	snapshot_names.push_back(make_unique<CatalogSnapshotName>(name));
+	current_index->Insert(snapshot_names.back().get());
+}
+
+void CatalogSet::RebuildSnapshotIndex() {
+	// a name that is no longer in the mapping does not exist for any transaction: lookups that do not find it in the
+	// index return the same result, so it can be left out
+	vector<unique_ptr<CatalogSnapshotName>> names;
+	vector<unique_ptr<CatalogSnapshotName>> removed_names;
+	for (auto &snapshot_name : snapshot_names) {
+		if (mapping.find(snapshot_name->name) == mapping.end()) {
+			removed_names.push_back(move(snapshot_name));
+		} else {
+			names.push_back(move(snapshot_name));
+		}
+	}
+	// leave room for the name that is about to be added
+	idx_t capacity = CatalogSnapshotIndex::INITIAL_CAPACITY;
+	while ((names.size() + 1) * 2 > capacity) {
+		capacity *= 2;
+	}
+	auto new_index = make_unique<CatalogSnapshotIndex>(capacity);
+	for (auto &snapshot_name : names) {
+		new_index->Insert(snapshot_name.get());
+	}
+	snapshot_names = move(names);
+	removed_snapshot_names = 0;
+	snapshot_index.store(new_index.get());
+	// lookups might still be reading the removed names through the old index
+	RetireSnapshot(nullptr, move(current_index), move(removed_names));
+	current_index = move(new_index);
+}
+
+void CatalogSet::RemoveSnapshotName() {
+	// the removed names stay in the index until they make up half of it, which bounds the index to twice the amount of
+	// names in the mapping without rebuilding it for every removed name
+	removed_snapshot_names++;
+	if (removed_snapshot_names * 2 >= snapshot_names.size()) {
+		RebuildSnapshotIndex();
+	}
+}
+
+void CatalogSet::RetireSnapshot(unique_ptr<CatalogSnapshotEntry> entry, unique_ptr<CatalogSnapshotIndex> index,
+                                vector<unique_ptr<CatalogSnapshotName>> names) {
+	// the replacement is already published: transactions that start from here on can only read the replacement
+	RetiredCatalogSnapshot retired;
+	retired.timestamp = TransactionManager::Get(catalog.db).NextStartTimestamp();
+	retired.entry = move(entry);
+	retired.index = move(index);
+	retired.names = move(names);
+	retired_snapshots.push_back(move(retired));
+	CleanupSnapshots();
+}
+
+void CatalogSet::CleanupSnapshots() {
+	if (retired_snapshots.empty()) {
+		return;
+	}
+	// the retired snapshots are ordered by timestamp: free the ones retired before the oldest active transaction
+	auto lowest_active_start = TransactionManager::Get(catalog.db).LowestActiveStart();
+	idx_t expired = 0;
+	while (expired < retired_snapshots.size() && retired_snapshots[expired].timestamp <= lowest_active_start) {
+		expired++;
+	}
+	retired_snapshots.erase(retired_snapshots.begin(), retired_snapshots.begin() + expired);
+}
+
 CatalogEntry *CatalogSet::GetEntry(ClientContext &context, const string &name) {
+	CatalogEntry *snapshot_entry;
+	if (GetEntryFromSnapshot(context, name, snapshot_entry)) {
+		return snapshot_entry;
+	}
 	unique_lock<mutex> lock(catalog_lock);
+	UpdateSnapshot(name);
+	CleanupSnapshots();
 	auto mapping_value = GetMapping(context, name);
 	if (mapping_value != nullptr && !mapping_value->deleted) {
 		// we found an entry for this name
@@ -509,6 +699,8 @@ void CatalogSet::Undo(CatalogEntry *entry) {
 
 	// i.e. we have to place (entry) as (entry->parent) again
 	auto &to_be_removed_node = entry->parent;
+	InvalidateSnapshot(entry->name);
+	InvalidateSnapshot(to_be_removed_node->name);
 
 	AdjustTableDependencies(entry);
 
@@ -524,6 +716,7 @@ void CatalogSet::Undo(CatalogEntry *entry) {
 			mapping[to_be_removed_node->name] = move(removed_entry->second->child);
 		} else {
 			mapping.erase(removed_entry);
+			RemoveSnapshotName();
 		}
 	}
 	if (to_be_removed_node->parent) {
@@ -547,6 +740,7 @@ void CatalogSet::Undo(CatalogEntry *entry) {
 			mapping[entry->name] = move(restored_entry->second->child);
 		} else {
 			mapping.erase(restored_entry);
+			RemoveSnapshotName();
 		}
 	}
 	// we mark the catalog as being modified, since this action can lead to e.g. tables being dropped
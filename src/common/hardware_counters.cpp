@@ -0,0 +1,115 @@
+#include "duckdb/common/hardware_counters.hpp"
+
+#if defined(__linux__)
+#include <cstddef>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace duckdb {
+
+#if defined(__linux__)
+struct HardwareCounterDefinition {
+	uint32_t type;
+	uint64_t config;
+	idx_t offset;
+};
+
+static constexpr uint64_t TLB_READ_MISS = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+// the cycle counter is the first counter and leads the group, the other counters are optional
+static const HardwareCounterDefinition HARDWARE_COUNTERS[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, offsetof(HardwareCounterValues, cycles)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, offsetof(HardwareCounterValues, instructions)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, offsetof(HardwareCounterValues, cache_misses)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, offsetof(HardwareCounterValues, branch_misses)},
+    {PERF_TYPE_HW_CACHE, TLB_READ_MISS, offsetof(HardwareCounterValues, tlb_misses)}};
+
+static constexpr idx_t HARDWARE_COUNTER_COUNT = sizeof(HARDWARE_COUNTERS) / sizeof(HardwareCounterDefinition);
+
+static int OpenHardwareCounter(const HardwareCounterDefinition &definition, int group_fd) {
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = definition.type;
+	attr.config = definition.config;
+	// the kernel multiplexes the counters when there are more events than hardware counters: the times are used to
+	// scale the values to the full time the counters were enabled
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	// only count the user-space work of the calling thread, which is permitted at the default paranoia level
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+HardwareCounters::HardwareCounters() : group_fd(-1) {
+	for (idx_t i = 0; i < HARDWARE_COUNTER_COUNT; i++) {
+		int fd = OpenHardwareCounter(HARDWARE_COUNTERS[i], group_fd);
+		if (fd < 0) {
+			if (i == 0) {
+				// no cycle counter: perf events are not supported or not permitted
+				return;
+			}
+			continue;
+		}
+		if (i == 0) {
+			group_fd = fd;
+		}
+		fds.push_back(fd);
+		offsets.push_back(HARDWARE_COUNTERS[i].offset);
+	}
+}
+
+HardwareCounters::~HardwareCounters() {
+	for (auto fd : fds) {
+		close(fd);
+	}
+}
+
+bool HardwareCounters::Read(HardwareCounterValues &result) {
+	if (group_fd < 0) {
+		return false;
+	}
+	// the group is read at once: the number of counters, the time the group was enabled and the time it was actually
+	// counting, followed by the values of the counters in the order they were opened
+	static constexpr idx_t HEADER_SIZE = 3;
+	uint64_t values[HEADER_SIZE + HARDWARE_COUNTER_COUNT];
+	auto bytes_read = read(group_fd, values, sizeof(uint64_t) * (HEADER_SIZE + fds.size()));
+	if (bytes_read < 0 || idx_t(bytes_read) < sizeof(uint64_t) * (HEADER_SIZE + fds.size())) {
+		return false;
+	}
+	auto time_enabled = values[1];
+	auto time_running = values[2];
+	// the counters of a group are scheduled together, so a single scale applies to all of them (if the group has not
+	// been scheduled at all, the values are zero)
+	double scale = 1.0;
+	if (time_running > 0 && time_running < time_enabled) {
+		scale = double(time_enabled) / double(time_running);
+	}
+	result = HardwareCounterValues();
+	for (idx_t i = 0; i < fds.size(); i++) {
+		*(idx_t *)((data_ptr_t)&result + offsets[i]) = idx_t(double(values[HEADER_SIZE + i]) * scale);
+	}
+	return true;
+}
+#else
+HardwareCounters::HardwareCounters() : group_fd(-1) {
+}
+
+HardwareCounters::~HardwareCounters() {
+}
+
+bool HardwareCounters::Read(HardwareCounterValues &result) {
+	return false;
+}
+#endif
+
+HardwareCounters &HardwareCounters::Get() {
+	static thread_local HardwareCounters counters;
+	return counters;
+}
+
+} // namespace duckdb
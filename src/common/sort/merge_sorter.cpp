@@ -2,22 +2,33 @@
 #include "duckdb/common/sort/comparators.hpp"
 #include "duckdb/common/sort/sort.hpp"
 
+#include <algorithm>
+
 namespace duckdb {
 
 MergeSorter::MergeSorter(GlobalSortState &state, BufferManager &buffer_manager)
-    : state(state), buffer_manager(buffer_manager), sort_layout(state.sort_layout) {
+    : state(state), buffer_manager(buffer_manager), sort_layout(state.sort_layout), k_way(false) {
 }
 
 void MergeSorter::PerformInMergeRound() {
 	while (true) {
 		{
 			lock_guard<mutex> pair_guard(state.lock);
-			if (state.pair_idx == state.num_pairs) {
+			if (state.group_idx == state.num_groups) {
 				break;
 			}
-			GetNextPartition();
+			k_way = state.group_offsets[state.group_idx + 1] - state.group_offsets[state.group_idx] > 2;
+			if (k_way) {
+				GetNextKWayPartition();
+			} else {
+				GetNextPartition();
+			}
+		}
+		if (k_way) {
+			MergeKWayPartition();
+		} else {
+			MergePartition();
 		}
-		MergePartition();
 	}
 }
 
@@ -83,11 +94,14 @@ void MergeSorter::MergePartition() {
 
 void MergeSorter::GetNextPartition() {
 	// Create result block
-	state.sorted_blocks_temp[state.pair_idx].push_back(make_unique<SortedBlock>(buffer_manager, state));
-	result = state.sorted_blocks_temp[state.pair_idx].back().get();
+	state.sorted_blocks_temp[state.group_idx].push_back(make_unique<SortedBlock>(buffer_manager, state));
+	result = state.sorted_blocks_temp[state.group_idx].back().get();
 	// Determine which blocks must be merged
-	auto &left_block = *state.sorted_blocks[state.pair_idx * 2];
-	auto &right_block = *state.sorted_blocks[state.pair_idx * 2 + 1];
+	const idx_t l_block_idx = state.group_offsets[state.group_idx];
+	auto &left_block = *state.sorted_blocks[l_block_idx];
+	auto &right_block = *state.sorted_blocks[l_block_idx + 1];
+	auto &l_start = state.run_starts[0];
+	auto &r_start = state.run_starts[1];
 	const idx_t l_count = left_block.Count();
 	const idx_t r_count = right_block.Count();
 	// Initialize left and right reader
@@ -96,10 +110,10 @@ void MergeSorter::GetNextPartition() {
 	// Compute the work that this thread must do using Merge Path
 	idx_t l_end;
 	idx_t r_end;
-	if (state.l_start + state.r_start + state.block_capacity < l_count + r_count) {
-		left->sb = state.sorted_blocks[state.pair_idx * 2].get();
-		right->sb = state.sorted_blocks[state.pair_idx * 2 + 1].get();
-		const idx_t intersection = state.l_start + state.r_start + state.block_capacity;
+	if (l_start + r_start + state.block_capacity < l_count + r_count) {
+		left->sb = &left_block;
+		right->sb = &right_block;
+		const idx_t intersection = l_start + r_start + state.block_capacity;
 		GetIntersection(intersection, l_end, r_end);
 		D_ASSERT(l_end <= l_count);
 		D_ASSERT(r_end <= r_count);
@@ -111,22 +125,20 @@ void MergeSorter::GetNextPartition() {
 	// Create slices of the data that this thread must merge
 	left->SetIndices(0, 0);
 	right->SetIndices(0, 0);
-	left_input = left_block.CreateSlice(state.l_start, l_end, left->entry_idx);
-	right_input = right_block.CreateSlice(state.r_start, r_end, right->entry_idx);
+	left_input = left_block.CreateSlice(l_start, l_end, left->entry_idx);
+	right_input = right_block.CreateSlice(r_start, r_end, right->entry_idx);
 	left->sb = left_input.get();
 	right->sb = right_input.get();
-	state.l_start = l_end;
-	state.r_start = r_end;
+	l_start = l_end;
+	r_start = r_end;
 	D_ASSERT(left->Remaining() + right->Remaining() == state.block_capacity || (l_end == l_count && r_end == r_count));
 	// Update global state
-	if (state.l_start == l_count && state.r_start == r_count) {
+	if (l_start == l_count && r_start == r_count) {
 		// Delete references to previous pair
-		state.sorted_blocks[state.pair_idx * 2] = nullptr;
-		state.sorted_blocks[state.pair_idx * 2 + 1] = nullptr;
-		// Advance pair
-		state.pair_idx++;
-		state.l_start = 0;
-		state.r_start = 0;
+		state.sorted_blocks[l_block_idx] = nullptr;
+		state.sorted_blocks[l_block_idx + 1] = nullptr;
+		// Advance to the next group
+		AdvanceGroup();
 	}
 }
 
@@ -135,10 +147,10 @@ int MergeSorter::CompareUsingGlobalIndex(SBScanState &l, SBScanState &r, const i
 	D_ASSERT(r_idx < r.sb->Count());
 
 	// Easy comparison using the previous result (intersections must increase monotonically)
-	if (l_idx < state.l_start) {
+	if (l_idx < state.run_starts[0]) {
 		return -1;
 	}
-	if (r_idx < state.r_start) {
+	if (r_idx < state.run_starts[1]) {
 		return 1;
 	}
 
@@ -239,6 +251,307 @@ void MergeSorter::GetIntersection(const idx_t diagonal, idx_t &l_idx, idx_t &r_i
 	}
 }
 
+void MergeSorter::AdvanceGroup() {
+	state.group_idx++;
+	state.run_starts.clear();
+	if (state.group_idx < state.num_groups) {
+		state.run_starts.resize(state.group_offsets[state.group_idx + 1] - state.group_offsets[state.group_idx], 0);
+	}
+}
+
+void MergeSorter::GetNextKWayPartition() {
+	// Create result block
+	state.sorted_blocks_temp[state.group_idx].push_back(make_unique<SortedBlock>(buffer_manager, state));
+	result = state.sorted_blocks_temp[state.group_idx].back().get();
+	// Determine where the partition ends in each of the blocks of the group
+	const idx_t group_start = state.group_offsets[state.group_idx];
+	const idx_t run_count = state.run_starts.size();
+	vector<idx_t> counts;
+	idx_t remaining = 0;
+	for (idx_t run = 0; run < run_count; run++) {
+		counts.push_back(state.sorted_blocks[group_start + run]->Count());
+		remaining += counts[run] - state.run_starts[run];
+	}
+	vector<idx_t> ends = counts;
+	if (remaining > state.block_capacity) {
+		GetKWayIntersection(state.block_capacity, ends);
+	}
+	// Create slices of the data that this thread must merge
+	run_readers.clear();
+	run_inputs.clear();
+	run_remaining.clear();
+	bool group_done = true;
+	for (idx_t run = 0; run < run_count; run++) {
+		auto reader = make_unique<SBScanState>(buffer_manager, state);
+		auto &start = state.run_starts[run];
+		unique_ptr<SortedBlock> input;
+		if (ends[run] > start) {
+			input = state.sorted_blocks[group_start + run]->CreateSlice(start, ends[run], reader->entry_idx);
+			reader->sb = input.get();
+		}
+		run_readers.push_back(move(reader));
+		run_inputs.push_back(move(input));
+		run_remaining.push_back(ends[run] - start);
+		start = ends[run];
+		group_done = group_done && start == counts[run];
+	}
+	if (group_done) {
+		// Delete references to the blocks of this group
+		for (idx_t run = 0; run < run_count; run++) {
+			state.sorted_blocks[group_start + run] = nullptr;
+		}
+		AdvanceGroup();
+	}
+}
+
+//! Positions the reader at the row with the given index in its sorted block
+static void SetGlobalIndex(SBScanState &reader, const vector<idx_t> &block_offsets, idx_t global_idx) {
+	auto it = std::upper_bound(block_offsets.begin(), block_offsets.end(), global_idx);
+	D_ASSERT(it != block_offsets.begin());
+	reader.block_idx = it - block_offsets.begin() - 1;
+	reader.entry_idx = global_idx - block_offsets[reader.block_idx];
+}
+
+void MergeSorter::GetKWayIntersection(const idx_t count, vector<idx_t> &ends) {
+	// This generalizes Merge Path to k sorted blocks: we look for the boundaries in each block such that the rows
+	// before them are the next 'count' rows of the merge. The boundaries lie in [lo, hi], which we narrow down by
+	// using a row of the block with the largest range as the pivot, until all ranges are empty
+	const idx_t group_start = state.group_offsets[state.group_idx];
+	const idx_t run_count = state.run_starts.size();
+	vector<unique_ptr<SBScanState>> readers;
+	vector<vector<idx_t>> block_offsets(run_count);
+	vector<idx_t> lo(run_count);
+	vector<idx_t> hi(run_count);
+	idx_t target = count;
+	for (idx_t run = 0; run < run_count; run++) {
+		auto &sb = *state.sorted_blocks[group_start + run];
+		readers.push_back(make_unique<SBScanState>(buffer_manager, state));
+		readers.back()->sb = &sb;
+		idx_t offset = 0;
+		for (auto &block : sb.radix_sorting_data) {
+			block_offsets[run].push_back(offset);
+			offset += block.count;
+		}
+		lo[run] = state.run_starts[run];
+		hi[run] = MinValue(offset, lo[run] + count);
+		target += lo[run];
+	}
+	while (true) {
+		idx_t pivot_run = 0;
+		for (idx_t run = 1; run < run_count; run++) {
+			if (hi[run] - lo[run] > hi[pivot_run] - lo[pivot_run]) {
+				pivot_run = run;
+			}
+		}
+		if (lo[pivot_run] == hi[pivot_run]) {
+			break;
+		}
+		const idx_t pivot_idx = lo[pivot_run] + (hi[pivot_run] - lo[pivot_run]) / 2;
+		SetGlobalIndex(*readers[pivot_run], block_offsets[pivot_run], pivot_idx);
+		// Count the rows that come before the pivot (within the current ranges)
+		idx_t rank = 0;
+		for (idx_t run = 0; run < run_count; run++) {
+			ends[run] =
+			    run == pivot_run ? pivot_idx : FindRank(readers, block_offsets, run, lo[run], hi[run], pivot_run);
+			rank += ends[run];
+		}
+		if (rank < target) {
+			// The pivot belongs to this partition, and so do the rows before it
+			for (idx_t run = 0; run < run_count; run++) {
+				lo[run] = MaxValue(lo[run], ends[run]);
+			}
+			lo[pivot_run] = pivot_idx + 1;
+		} else {
+			// The pivot belongs to a later partition, and so do the rows after it
+			for (idx_t run = 0; run < run_count; run++) {
+				hi[run] = MinValue(hi[run], ends[run]);
+			}
+			hi[pivot_run] = pivot_idx;
+		}
+	}
+	idx_t total = 0;
+	for (idx_t run = 0; run < run_count; run++) {
+		ends[run] = lo[run];
+		total += ends[run];
+	}
+	D_ASSERT(total == target);
+}
+
+idx_t MergeSorter::FindRank(vector<unique_ptr<SBScanState>> &readers, const vector<vector<idx_t>> &block_offsets,
+                            idx_t run, idx_t lo, idx_t hi, idx_t pivot_run) {
+	auto &reader = *readers[run];
+	auto &pivot = *readers[pivot_run];
+	while (lo < hi) {
+		const idx_t middle = lo + (hi - lo) / 2;
+		SetGlobalIndex(reader, block_offsets[run], middle);
+		if (CompareRuns(reader, run, pivot, pivot_run) > 0) {
+			hi = middle;
+		} else {
+			lo = middle + 1;
+		}
+	}
+	return lo;
+}
+
+int MergeSorter::CompareRuns(SBScanState &l, idx_t l_run, SBScanState &r, idx_t r_run) {
+	D_ASSERT(l_run != r_run);
+	l.PinRadix(l.block_idx);
+	r.PinRadix(r.block_idx);
+	data_ptr_t l_ptr = l.RadixPtr();
+	data_ptr_t r_ptr = r.RadixPtr();
+	int comp_res;
+	if (sort_layout.all_constant) {
+		comp_res = FastMemcmp(l_ptr, r_ptr, sort_layout.comparison_size);
+	} else {
+		l.PinData(*l.sb->blob_sorting_data);
+		r.PinData(*r.sb->blob_sorting_data);
+		comp_res = Comparators::CompareTuple(l, r, l_ptr, r_ptr, sort_layout, state.external);
+	}
+	if (comp_res == 0) {
+		// Break ties using the index of the sorted block so that all threads agree on the order
+		comp_res = l_run < r_run ? -1 : 1;
+	}
+	return comp_res;
+}
+
+bool MergeSorter::KWayLess(idx_t l, idx_t r) {
+	if (run_remaining[l] == 0) {
+		return false;
+	}
+	if (run_remaining[r] == 0) {
+		return true;
+	}
+	return CompareRuns(*run_readers[l], l, *run_readers[r], r) < 0;
+}
+
+idx_t MergeSorter::BuildLoserTree(idx_t node) {
+	// The internal nodes are [1, k), the leaf of sorted block 'run' is node k + run
+	const idx_t run_count = run_readers.size();
+	if (node >= run_count) {
+		return node - run_count;
+	}
+	const idx_t l_winner = BuildLoserTree(2 * node);
+	const idx_t r_winner = BuildLoserTree(2 * node + 1);
+	if (KWayLess(l_winner, r_winner)) {
+		loser_tree[node] = r_winner;
+		return l_winner;
+	}
+	loser_tree[node] = l_winner;
+	return r_winner;
+}
+
+void MergeSorter::PinKWayReader(SBScanState &reader) {
+	reader.PinRadix(reader.block_idx);
+	if (!sort_layout.all_constant) {
+		reader.PinData(*reader.sb->blob_sorting_data);
+	}
+	reader.PinData(*reader.sb->payload_data);
+}
+
+void MergeSorter::CopyKWayRow(SortedData &result_data, BufferHandle &data_handle, BufferHandle *heap_handle,
+                              SortedData &source_data, SBScanState &reader) {
+	const auto &layout = result_data.layout;
+	const idx_t row_width = layout.GetRowWidth();
+	auto &data_block = result_data.data_blocks.back();
+	const data_ptr_t target_ptr = data_handle.Ptr() + data_block.count * row_width;
+	FastMemcpy(target_ptr, reader.DataPtr(source_data), row_width);
+	data_block.count++;
+	if (layout.AllConstant() || !state.external) {
+		return;
+	}
+	// Copy the heap row too, and store its offset in the row
+	auto &heap_block = result_data.heap_blocks.back();
+	const data_ptr_t source_heap_ptr = reader.HeapPtr(source_data);
+	const idx_t entry_size = Load<uint32_t>(source_heap_ptr);
+	D_ASSERT(entry_size >= sizeof(uint32_t));
+	if (heap_block.byte_offset + entry_size > heap_block.capacity) {
+		idx_t new_capacity = MaxValue(heap_block.capacity * 2, heap_block.byte_offset + entry_size);
+		buffer_manager.ReAllocate(heap_block.block, new_capacity);
+		heap_block.capacity = new_capacity;
+	}
+	memcpy(heap_handle->Ptr() + heap_block.byte_offset, source_heap_ptr, entry_size);
+	Store<idx_t>(heap_block.byte_offset, target_ptr + layout.GetHeapPointerOffset());
+	heap_block.byte_offset += entry_size;
+	heap_block.count++;
+}
+
+void MergeSorter::MergeKWayPartition() {
+	// Set up the write block
+	result->InitializeWrite();
+	auto &radix_block = result->radix_sorting_data.back();
+	auto radix_handle = buffer_manager.Pin(radix_block.block);
+	unique_ptr<BufferHandle> blob_data_handle;
+	unique_ptr<BufferHandle> blob_heap_handle;
+	if (!sort_layout.all_constant) {
+		blob_data_handle = buffer_manager.Pin(result->blob_sorting_data->data_blocks.back().block);
+		if (state.external) {
+			blob_heap_handle = buffer_manager.Pin(result->blob_sorting_data->heap_blocks.back().block);
+		}
+	}
+	auto payload_data_handle = buffer_manager.Pin(result->payload_data->data_blocks.back().block);
+	unique_ptr<BufferHandle> payload_heap_handle;
+	if (!state.payload_layout.AllConstant() && state.external) {
+		payload_heap_handle = buffer_manager.Pin(result->payload_data->heap_blocks.back().block);
+	}
+	// Pin the first row of every sorted block and set up the loser tree
+	const idx_t run_count = run_readers.size();
+	idx_t total = 0;
+	for (idx_t run = 0; run < run_count; run++) {
+		if (run_remaining[run] > 0) {
+			PinKWayReader(*run_readers[run]);
+		}
+		total += run_remaining[run];
+	}
+	loser_tree.assign(run_count, 0);
+	loser_tree[0] = BuildLoserTree(1);
+	// Merge loop: copy the row of the winner, advance it, and replay its path to the root
+	for (idx_t i = 0; i < total; i++) {
+		idx_t winner = loser_tree[0];
+		auto &reader = *run_readers[winner];
+		auto &input = *reader.sb;
+		D_ASSERT(run_remaining[winner] > 0);
+		FastMemcpy(radix_handle->Ptr() + radix_block.count * sort_layout.entry_size, reader.RadixPtr(),
+		           sort_layout.entry_size);
+		radix_block.count++;
+		if (!sort_layout.all_constant) {
+			CopyKWayRow(*result->blob_sorting_data, *blob_data_handle, blob_heap_handle.get(),
+			            *input.blob_sorting_data, reader);
+		}
+		CopyKWayRow(*result->payload_data, *payload_data_handle, payload_heap_handle.get(), *input.payload_data,
+		            reader);
+		run_remaining[winner]--;
+		reader.entry_idx++;
+		if (reader.entry_idx == input.radix_sorting_data[reader.block_idx].count) {
+			// Delete references to the block we have passed
+			input.radix_sorting_data[reader.block_idx].block = nullptr;
+			if (!sort_layout.all_constant) {
+				input.blob_sorting_data->data_blocks[reader.block_idx].block = nullptr;
+				if (state.external) {
+					input.blob_sorting_data->heap_blocks[reader.block_idx].block = nullptr;
+				}
+			}
+			input.payload_data->data_blocks[reader.block_idx].block = nullptr;
+			if (!state.payload_layout.AllConstant() && state.external) {
+				input.payload_data->heap_blocks[reader.block_idx].block = nullptr;
+			}
+			reader.block_idx++;
+			reader.entry_idx = 0;
+		}
+		if (run_remaining[winner] > 0) {
+			PinKWayReader(reader);
+		}
+		for (idx_t node = (winner + run_count) / 2; node > 0; node /= 2) {
+			if (KWayLess(loser_tree[node], winner)) {
+				std::swap(loser_tree[node], winner);
+			}
+		}
+		loser_tree[0] = winner;
+	}
+	D_ASSERT(result->Count() == total);
+	run_readers.clear();
+	run_inputs.clear();
+}
+
 void MergeSorter::ComputeMerge(const idx_t &count, bool left_smaller[]) {
 	auto &l = *left;
 	auto &r = *right;
@@ -2,6 +2,7 @@
 #include "duckdb/common/row_operations/row_operations.hpp"
 #include "duckdb/common/sort/sort.hpp"
 #include "duckdb/common/sort/sorted_block.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/statistics/string_statistics.hpp"
 
 #include <numeric>
@@ -317,7 +318,7 @@ void LocalSortState::ReOrder(GlobalSortState &gstate, bool reorder_heap) {
 GlobalSortState::GlobalSortState(BufferManager &buffer_manager, const vector<BoundOrderByNode> &orders,
                                  RowLayout &payload_layout)
     : buffer_manager(buffer_manager), sort_layout(SortLayout(orders)), payload_layout(payload_layout),
-      block_capacity(0), external(false) {
+      block_capacity(0), external(false), merge_fan_in(2), group_idx(0), num_groups(0) {
 }
 
 void GlobalSortState::AddLocalState(LocalSortState &local_sort_state) {
@@ -350,6 +351,12 @@ void GlobalSortState::AddLocalState(LocalSortState &local_sort_state) {
 	}
 }
 
+//! The memory that a single thread can use to pin blocks while merging
+static idx_t MergeMemoryPerThread(BufferManager &buffer_manager) {
+	idx_t num_threads = TaskScheduler::GetScheduler(buffer_manager.GetDatabase()).NumberOfThreads();
+	return buffer_manager.GetMaxMemory() / 2 / MaxValue<idx_t>(num_threads, 1);
+}
+
 void GlobalSortState::PrepareMergePhase() {
 	// Determine if we need to use do an external sort
 	idx_t total_heap_size =
@@ -374,6 +381,20 @@ void GlobalSortState::PrepareMergePhase() {
 			block_capacity = MaxValue(block_capacity, sb->Count());
 		}
 	}
+	if (external) {
+		// Limit the size of the blocks that are created while merging, so that many blocks can be merged at once
+		idx_t total_count = 0;
+		idx_t total_size = 0;
+		for (auto &sb : sorted_blocks) {
+			total_count += sb->Count();
+			total_size += sb->SizeInBytes();
+		}
+		if (total_count > 0) {
+			const idx_t row_size = MaxValue<idx_t>(total_size / total_count, 1);
+			const idx_t max_block_size = MergeMemoryPerThread(buffer_manager) / (SortConstants::MAX_MERGE_FAN_IN + 1);
+			block_capacity = MinValue(block_capacity, MaxValue<idx_t>(max_block_size / row_size, STANDARD_VECTOR_SIZE));
+		}
+	}
 	// Unswizzle and pin heap blocks if we can fit everything in memory
 	if (!external) {
 		for (auto &sb : sorted_blocks) {
@@ -383,23 +404,72 @@ void GlobalSortState::PrepareMergePhase() {
 	}
 }
 
+idx_t GlobalSortState::PinnedBytesPerBlock(const SortedBlock &sb) const {
+	// Each of the buffers that make up a block is pinned separately, and takes up at least a full block of memory.
+	// The heap blocks of an in-memory sort are pinned throughout the sort, so they do not count here
+	idx_t result = 0;
+	for (idx_t i = 0; i < sb.radix_sorting_data.size(); i++) {
+		idx_t bytes = MaxValue<idx_t>(sb.radix_sorting_data[i].capacity * sort_layout.entry_size, Storage::BLOCK_SIZE);
+		if (!sort_layout.all_constant) {
+			bytes += MaxValue<idx_t>(sb.blob_sorting_data->data_blocks[i].capacity *
+			                             sort_layout.blob_layout.GetRowWidth(),
+			                         Storage::BLOCK_SIZE);
+			if (external) {
+				bytes += MaxValue<idx_t>(sb.blob_sorting_data->heap_blocks[i].capacity, Storage::BLOCK_SIZE);
+			}
+		}
+		bytes += MaxValue<idx_t>(sb.payload_data->data_blocks[i].capacity * payload_layout.GetRowWidth(),
+		                         Storage::BLOCK_SIZE);
+		if (!payload_layout.AllConstant() && external) {
+			bytes += MaxValue<idx_t>(sb.payload_data->heap_blocks[i].capacity, Storage::BLOCK_SIZE);
+		}
+		result = MaxValue(result, bytes);
+	}
+	return result;
+}
+
+idx_t GlobalSortState::ComputeMergeFanIn() {
+	// While merging, every thread pins a block of each of the sorted blocks it merges, and the block it writes to
+	idx_t block_size = 1;
+	for (auto &sb : sorted_blocks) {
+		block_size = MaxValue(block_size, PinnedBytesPerBlock(*sb));
+	}
+	idx_t fan_in = MergeMemoryPerThread(buffer_manager) / block_size;
+	fan_in = fan_in > 0 ? fan_in - 1 : 0;
+	return MinValue(MaxValue<idx_t>(fan_in, 2), SortConstants::MAX_MERGE_FAN_IN);
+}
+
 void GlobalSortState::InitializeMergeRound() {
 	D_ASSERT(sorted_blocks_temp.empty());
 	// If we reverse this list, the blocks that were merged last will be merged first in the next round
 	// These are still in memory, therefore this reduces the amount of read/write to disk!
 	std::reverse(sorted_blocks.begin(), sorted_blocks.end());
-	// Uneven number of blocks - keep one on the side
-	if (sorted_blocks.size() % 2 == 1) {
+	// Divide the blocks into groups of (almost) equal size that are merged at once
+	merge_fan_in = ComputeMergeFanIn();
+	const idx_t block_count = sorted_blocks.size();
+	num_groups = (block_count + merge_fan_in - 1) / merge_fan_in;
+	group_offsets.clear();
+	idx_t offset = 0;
+	for (idx_t g_idx = 0; g_idx < num_groups; g_idx++) {
+		group_offsets.push_back(offset);
+		offset += block_count / num_groups + (g_idx < block_count % num_groups);
+	}
+	group_offsets.push_back(block_count);
+	// A group of a single block (only possible when merging pairs) - keep it on the side
+	if (num_groups > 0 && group_offsets[num_groups] - group_offsets[num_groups - 1] == 1) {
 		odd_one_out = move(sorted_blocks.back());
 		sorted_blocks.pop_back();
+		group_offsets.pop_back();
+		num_groups--;
+	}
+	// Init merge path indices
+	group_idx = 0;
+	run_starts.clear();
+	if (num_groups > 0) {
+		run_starts.resize(group_offsets[1] - group_offsets[0], 0);
 	}
-	// Init merge path path indices
-	pair_idx = 0;
-	num_pairs = sorted_blocks.size() / 2;
-	l_start = 0;
-	r_start = 0;
 	// Allocate room for merge results
-	for (idx_t p_idx = 0; p_idx < num_pairs; p_idx++) {
+	for (idx_t g_idx = 0; g_idx < num_groups; g_idx++) {
 		sorted_blocks_temp.emplace_back();
 	}
 }
@@ -0,0 +1,10 @@
+#include "duckdb/common/thread_metrics.hpp"
+
+namespace duckdb {
+
+ThreadMetrics &ThreadMetrics::Get() {
+	static thread_local ThreadMetrics metrics;
+	return metrics;
+}
+
+} // namespace duckdb
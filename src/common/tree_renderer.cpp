@@ -490,6 +490,32 @@ unique_ptr<RenderTreeNode> TreeRenderer::CreateNode(const QueryProfiler::TreeNod
 	result->extra_text += "\n" + to_string(op.info.elements);
 	string timing = StringUtil::Format("%.2f", op.info.time);
 	result->extra_text += "\n(" + timing + "s)";
+	auto &metrics = op.info.metrics;
+	if (metrics.peak_memory > 0) {
+		result->extra_text += "\nMemory: " + StringUtil::BytesToHumanReadableString(metrics.peak_memory);
+	}
+	if (metrics.bytes_spilled > 0 || metrics.bytes_reloaded > 0) {
+		result->extra_text += "\nSpilled: " + StringUtil::BytesToHumanReadableString(metrics.bytes_spilled);
+		result->extra_text += "\nReloaded: " + StringUtil::BytesToHumanReadableString(metrics.bytes_reloaded);
+	}
+	if (metrics.pin_hits > 0 || metrics.pin_misses > 0) {
+		result->extra_text +=
+		    "\nPins: " + to_string(metrics.pin_hits) + " hit, " + to_string(metrics.pin_misses) + " miss";
+	}
+	if (metrics.bytes_read > 0) {
+		result->extra_text += "\nRead: " + StringUtil::BytesToHumanReadableString(metrics.bytes_read);
+	}
+	if (metrics.rows_scanned > 0) {
+		result->extra_text += "\nScanned: " + to_string(metrics.rows_scanned) + " rows";
+	}
+	auto &counters = op.info.hardware_counters;
+	if (counters.cycles > 0) {
+		result->extra_text += "\nCycles: " + to_string(counters.cycles);
+		result->extra_text += "\nIPC: " + StringUtil::Format("%.2f", double(counters.instructions) / counters.cycles);
+		result->extra_text += "\nLLC Misses: " + to_string(counters.cache_misses);
+		result->extra_text += "\nBranch Misses: " + to_string(counters.branch_misses);
+		result->extra_text += "\nTLB Misses: " + to_string(counters.tlb_misses);
+	}
 	if (config.detailed) {
 		for (auto &info : op.info.executors_info) {
 			if (!info) {
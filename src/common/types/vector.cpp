@@ -187,6 +187,13 @@ void Vector::Slice(const SelectionVector &sel, idx_t count, SelCache &cache) {
 	}
 }
 
+void Vector::Dictionary(Vector &dict, idx_t dictionary_size, const SelectionVector &sel, idx_t count) {
+	D_ASSERT(dict.GetVectorType() == VectorType::FLAT_VECTOR);
+	Reference(dict);
+	Slice(sel, count);
+	((VectorChildBuffer &)*auxiliary).size = dictionary_size;
+}
+
 void Vector::Initialize(bool zero_data, idx_t capacity) {
 	auxiliary.reset();
 	validity.Reset();
@@ -977,6 +984,12 @@ void Vector::Verify(const SelectionVector &sel, idx_t count) {
 		// merge the selection vectors and verify the child
 		auto new_buffer = dict_sel.Slice(sel, count);
 		SelectionVector new_sel(new_buffer);
+		auto dictionary_size = DictionaryVector::DictionarySize(*this);
+		if (dictionary_size != DConstants::INVALID_INDEX) {
+			for (idx_t i = 0; i < count; i++) {
+				D_ASSERT(new_sel.get_index(i) < dictionary_size);
+			}
+		}
 		child.Verify(new_sel, count);
 		return;
 	}
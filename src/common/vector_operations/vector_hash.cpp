@@ -230,11 +230,75 @@ static inline void HashTypeSwitch(Vector &input, Vector &result, const Selection
 	}
 }
 
+//! Whether or not the input is a dictionary vector with fewer dictionary entries than rows. For those vectors we hash
+//! every dictionary entry once, and then gather the hashes for the rows through the selection vector.
+//! Sized dictionary vectors are currently only produced by scans of dictionary compressed segments. Comparing the join
+//! keys after the hash lookup still happens per row, and the Parquet reader decodes its dictionary pages into flat
+//! vectors, so neither benefits from this.
+static bool UseDictionaryHash(Vector &input, idx_t count) {
+	return input.GetVectorType() == VectorType::DICTIONARY_VECTOR && DictionaryVector::DictionarySize(input) < count;
+}
+
+static void DictionaryHash(Vector &input, Vector &dictionary_hashes) {
+	D_ASSERT(dictionary_hashes.GetType().id() == LogicalTypeId::HASH);
+	auto &dictionary = DictionaryVector::Child(input);
+	HashTypeSwitch<false>(dictionary, dictionary_hashes, nullptr, DictionaryVector::DictionarySize(input));
+	dictionary_hashes.Normalify(DictionaryVector::DictionarySize(input));
+}
+
+template <bool HAS_RSEL>
+static void DictionaryLoopHash(Vector &input, Vector &result, const SelectionVector *rsel, idx_t count) {
+	Vector dictionary_hashes(LogicalType::HASH, DictionaryVector::DictionarySize(input));
+	DictionaryHash(input, dictionary_hashes);
+	auto dictionary_data = FlatVector::GetData<hash_t>(dictionary_hashes);
+
+	auto &sel = DictionaryVector::SelVector(input);
+	result.SetVectorType(VectorType::FLAT_VECTOR);
+	auto result_data = FlatVector::GetData<hash_t>(result);
+	for (idx_t i = 0; i < count; i++) {
+		auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+		result_data[ridx] = dictionary_data[sel.get_index(ridx)];
+	}
+}
+
+template <bool HAS_RSEL>
+static void DictionaryLoopCombineHash(Vector &hashes, Vector &input, const SelectionVector *rsel, idx_t count) {
+	Vector dictionary_hashes(LogicalType::HASH, DictionaryVector::DictionarySize(input));
+	DictionaryHash(input, dictionary_hashes);
+	auto dictionary_data = FlatVector::GetData<hash_t>(dictionary_hashes);
+
+	auto &sel = DictionaryVector::SelVector(input);
+	if (hashes.GetVectorType() == VectorType::CONSTANT_VECTOR) {
+		auto constant_hash = *ConstantVector::GetData<hash_t>(hashes);
+		hashes.SetVectorType(VectorType::FLAT_VECTOR);
+		auto hash_data = FlatVector::GetData<hash_t>(hashes);
+		for (idx_t i = 0; i < count; i++) {
+			auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+			hash_data[ridx] = CombineHashScalar(constant_hash, dictionary_data[sel.get_index(ridx)]);
+		}
+	} else {
+		D_ASSERT(hashes.GetVectorType() == VectorType::FLAT_VECTOR);
+		auto hash_data = FlatVector::GetData<hash_t>(hashes);
+		for (idx_t i = 0; i < count; i++) {
+			auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+			hash_data[ridx] = CombineHashScalar(hash_data[ridx], dictionary_data[sel.get_index(ridx)]);
+		}
+	}
+}
+
 void VectorOperations::Hash(Vector &input, Vector &result, idx_t count) {
+	if (UseDictionaryHash(input, count)) {
+		DictionaryLoopHash<false>(input, result, nullptr, count);
+		return;
+	}
 	HashTypeSwitch<false>(input, result, nullptr, count);
 }
 
 void VectorOperations::Hash(Vector &input, Vector &result, const SelectionVector &sel, idx_t count) {
+	if (UseDictionaryHash(input, count)) {
+		DictionaryLoopHash<true>(input, result, &sel, count);
+		return;
+	}
 	HashTypeSwitch<true>(input, result, &sel, count);
 }
 
@@ -363,10 +427,18 @@ static inline void CombineHashTypeSwitch(Vector &hashes, Vector &input, const Se
 }
 
 void VectorOperations::CombineHash(Vector &hashes, Vector &input, idx_t count) {
+	if (UseDictionaryHash(input, count)) {
+		DictionaryLoopCombineHash<false>(hashes, input, nullptr, count);
+		return;
+	}
 	CombineHashTypeSwitch<false>(hashes, input, nullptr, count);
 }
 
 void VectorOperations::CombineHash(Vector &hashes, Vector &input, const SelectionVector &rsel, idx_t count) {
+	if (UseDictionaryHash(input, count)) {
+		DictionaryLoopCombineHash<true>(hashes, input, &rsel, count);
+		return;
+	}
 	CombineHashTypeSwitch<true>(hashes, input, &rsel, count);
 }
 
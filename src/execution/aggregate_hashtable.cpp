@@ -499,10 +499,67 @@ idx_t GroupedAggregateHashTable::FindOrCreateGroupsInternal(DataChunk &groups, V
 	return new_group_count;
 }
 
+idx_t GroupedAggregateHashTable::FindOrCreateDictionaryGroups(DataChunk &groups, Vector &group_hashes,
+                                                              Vector &addresses_out, SelectionVector &new_groups_out) {
+	auto &group_vector = groups.data[0];
+	auto &dictionary_sel = DictionaryVector::SelVector(group_vector);
+	auto dictionary_size = DictionaryVector::DictionarySize(group_vector);
+
+	// find the first row that references every dictionary entry
+	vector<idx_t> entry_index(dictionary_size, DConstants::INVALID_INDEX);
+	SelectionVector unique_rows(STANDARD_VECTOR_SIZE);
+	idx_t unique_count = 0;
+	for (idx_t i = 0; i < groups.size(); i++) {
+		auto dictionary_idx = dictionary_sel.get_index(i);
+		if (entry_index[dictionary_idx] == DConstants::INVALID_INDEX) {
+			entry_index[dictionary_idx] = unique_count;
+			unique_rows.set_index(unique_count++, i);
+		}
+	}
+
+	// look up the groups of the distinct dictionary entries only
+	DataChunk unique_groups;
+	unique_groups.InitializeEmpty(groups.GetTypes());
+	unique_groups.Slice(groups, unique_rows, unique_count);
+	Vector unique_hashes(group_hashes, unique_rows, unique_count);
+	Vector unique_addresses(LogicalType::POINTER);
+	SelectionVector unique_new_groups(STANDARD_VECTOR_SIZE);
+	idx_t new_group_count;
+	switch (entry_type) {
+	case HtEntryType::HT_WIDTH_64:
+		new_group_count = FindOrCreateGroupsInternal<aggr_ht_entry_64>(unique_groups, unique_hashes, unique_addresses,
+		                                                               unique_new_groups);
+		break;
+	case HtEntryType::HT_WIDTH_32:
+		new_group_count = FindOrCreateGroupsInternal<aggr_ht_entry_32>(unique_groups, unique_hashes, unique_addresses,
+		                                                               unique_new_groups);
+		break;
+	default:
+		throw InternalException("Unknown HT entry width");
+	}
+
+	// now gather the group addresses of every row
+	auto unique_addresses_ptr = FlatVector::GetData<data_ptr_t>(unique_addresses);
+	addresses_out.Normalify(groups.size());
+	auto addresses_ptr = FlatVector::GetData<data_ptr_t>(addresses_out);
+	for (idx_t i = 0; i < groups.size(); i++) {
+		addresses_ptr[i] = unique_addresses_ptr[entry_index[dictionary_sel.get_index(i)]];
+	}
+	for (idx_t i = 0; i < new_group_count; i++) {
+		new_groups_out.set_index(i, unique_rows.get_index(unique_new_groups.get_index(i)));
+	}
+	return new_group_count;
+}
+
 // this is to support distinct aggregations where we need to record whether we
 // have already seen a value for a group
 idx_t GroupedAggregateHashTable::FindOrCreateGroups(DataChunk &groups, Vector &group_hashes, Vector &addresses_out,
                                                     SelectionVector &new_groups_out) {
+	if (groups.ColumnCount() == 1 && groups.data[0].GetVectorType() == VectorType::DICTIONARY_VECTOR &&
+	    DictionaryVector::DictionarySize(groups.data[0]) < groups.size()) {
+		// low-cardinality dictionary: look up every dictionary entry only once
+		return FindOrCreateDictionaryGroups(groups, group_hashes, addresses_out, new_groups_out);
+	}
 	switch (entry_type) {
 	case HtEntryType::HT_WIDTH_64:
 		return FindOrCreateGroupsInternal<aggr_ht_entry_64>(groups, group_hashes, addresses_out, new_groups_out);
@@ -212,6 +212,10 @@ public:
 		D_ASSERT(!tasks.empty());
 		SetTasks(move(tasks));
 	}
+
+	string GetName() const override {
+		return "Hash Aggregate Finalize";
+	}
 };
 
 SinkFinalizeType PhysicalHashAggregate::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
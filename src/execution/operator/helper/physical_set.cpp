@@ -3,6 +3,8 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
+#include "duckdb/main/result_cache.hpp"
 
 namespace duckdb {
 
@@ -36,6 +38,8 @@ void PhysicalSet::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSou
 		}
 		if (scope == SetScope::GLOBAL) {
 			config.set_variables[name] = move(target_value);
+			PreparedStatementCache::Get(context.client).Clear();
+			ResultCache::Get(context.client).Clear();
 		} else {
 			auto &client_config = ClientConfig::GetConfig(context.client);
 			client_config.set_variables[name] = move(target_value);
@@ -61,6 +65,9 @@ void PhysicalSet::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSou
 		auto &db = DatabaseInstance::GetDatabase(context.client);
 		auto &config = DBConfig::GetConfig(context.client);
 		option->set_global(&db, config, input);
+		// global settings can influence planning: plans and results cached under the old settings cannot be used
+		PreparedStatementCache::Get(context.client).Clear();
+		ResultCache::Get(context.client).Clear();
 		break;
 	}
 	case SetScope::SESSION:
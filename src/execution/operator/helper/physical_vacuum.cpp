@@ -1,10 +1,36 @@
 #include "duckdb/execution/operator/helper/physical_vacuum.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
 
 namespace duckdb {
 
 void PhysicalVacuum::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
                              LocalSourceState &lstate) const {
-	// NOP
+	if (!info->vacuum) {
+		// ANALYZE: NOP
+		return;
+	}
+	auto &client = context.client;
+	auto &catalog = Catalog::GetCatalog(client);
+	vector<TableCatalogEntry *> tables;
+	if (info->has_table) {
+		tables.push_back(catalog.GetEntry<TableCatalogEntry>(client, info->schema, info->table));
+	} else {
+		// vacuum all tables of the database
+		// the schemas are collected first: scanning the tables of a schema can create default views, which look up
+		// schemas themselves
+		auto schemas = catalog.schemas->GetEntries<SchemaCatalogEntry>(client);
+		for (auto &schema : schemas) {
+			schema->Scan(client, CatalogType::TABLE_ENTRY, [&](CatalogEntry *entry) {
+				if (entry->type == CatalogType::TABLE_ENTRY) {
+					tables.push_back((TableCatalogEntry *)entry);
+				}
+			});
+		}
+	}
+	TransactionManager::Get(client).Vacuum(client, tables);
 }
 
 } // namespace duckdb
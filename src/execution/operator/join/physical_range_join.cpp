@@ -87,24 +87,35 @@ public:
 	using GlobalSortedTable = PhysicalRangeJoin::GlobalSortedTable;
 
 public:
-	RangeJoinMergeTask(shared_ptr<Event> event_p, ClientContext &context, GlobalSortedTable &table)
-	    : ExecutorTask(context), event(move(event_p)), context(context), table(table) {
+	RangeJoinMergeTask(shared_ptr<Event> event_p, ClientContext &context, GlobalSortedTable &table,
+	                   const PhysicalOperator &op)
+	    : ExecutorTask(context), event(move(event_p)), context(context), table(table), op(op) {
 	}
 
 	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
+		// the merge is part of the work of the join in the query profile
+		ThreadContext thread(context);
+		thread.profiler.StartOperator(&op);
 		// Initialize iejoin sorted and iterate until done
 		auto &global_sort_state = table.global_sort_state;
 		MergeSorter merge_sorter(global_sort_state, BufferManager::GetBufferManager(context));
 		merge_sorter.PerformInMergeRound();
+		thread.profiler.EndOperator(nullptr);
+		executor.Flush(thread);
 		event->FinishTask();
 
 		return TaskExecutionResult::TASK_FINISHED;
 	}
 
+	string GetName() const override {
+		return "Range Join Merge";
+	}
+
 private:
 	shared_ptr<Event> event;
 	ClientContext &context;
 	GlobalSortedTable &table;
+	const PhysicalOperator &op;
 };
 
 class RangeJoinMergeEvent : public Event {
@@ -129,7 +140,8 @@ public:
 
 		vector<unique_ptr<Task>> iejoin_tasks;
 		for (idx_t tnum = 0; tnum < num_threads; tnum++) {
-			iejoin_tasks.push_back(make_unique<RangeJoinMergeTask>(shared_from_this(), context, table));
+			iejoin_tasks.push_back(
+			    make_unique<RangeJoinMergeTask>(shared_from_this(), context, table, *pipeline.GetSink()));
 		}
 		SetTasks(move(iejoin_tasks));
 	}
@@ -143,6 +155,10 @@ public:
 			table.ScheduleMergeTasks(pipeline, *this);
 		}
 	}
+
+	string GetName() const override {
+		return "Range Join Merge Round";
+	}
 };
 
 void PhysicalRangeJoin::GlobalSortedTable::ScheduleMergeTasks(Pipeline &pipeline, Event &event) {
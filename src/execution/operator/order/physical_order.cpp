@@ -6,6 +6,7 @@
 #include "duckdb/storage/buffer_manager.hpp"
 
 #include "duckdb/parallel/event.hpp"
+#include "duckdb/parallel/thread_context.hpp"
 
 namespace duckdb {
 
@@ -105,23 +106,34 @@ void PhysicalOrder::Combine(ExecutionContext &context, GlobalSinkState &gstate_p
 
 class PhysicalOrderMergeTask : public ExecutorTask {
 public:
-	PhysicalOrderMergeTask(shared_ptr<Event> event_p, ClientContext &context, OrderGlobalState &state)
-	    : ExecutorTask(context), event(move(event_p)), context(context), state(state) {
+	PhysicalOrderMergeTask(shared_ptr<Event> event_p, ClientContext &context, OrderGlobalState &state,
+	                       const PhysicalOperator &op)
+	    : ExecutorTask(context), event(move(event_p)), context(context), state(state), op(op) {
 	}
 
 	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
+		// the merge is part of the work of the order operator in the query profile
+		ThreadContext thread(context);
+		thread.profiler.StartOperator(&op);
 		// Initialize merge sorted and iterate until done
 		auto &global_sort_state = state.global_sort_state;
 		MergeSorter merge_sorter(global_sort_state, BufferManager::GetBufferManager(context));
 		merge_sorter.PerformInMergeRound();
+		thread.profiler.EndOperator(nullptr);
+		executor.Flush(thread);
 		event->FinishTask();
 		return TaskExecutionResult::TASK_FINISHED;
 	}
 
+	string GetName() const override {
+		return "Order Merge";
+	}
+
 private:
 	shared_ptr<Event> event;
 	ClientContext &context;
 	OrderGlobalState &state;
+	const PhysicalOperator &op;
 };
 
 class OrderMergeEvent : public Event {
@@ -143,7 +155,8 @@ public:
 
 		vector<unique_ptr<Task>> merge_tasks;
 		for (idx_t tnum = 0; tnum < num_threads; tnum++) {
-			merge_tasks.push_back(make_unique<PhysicalOrderMergeTask>(shared_from_this(), context, gstate));
+			merge_tasks.push_back(
+			    make_unique<PhysicalOrderMergeTask>(shared_from_this(), context, gstate, *pipeline.GetSink()));
 		}
 		SetTasks(move(merge_tasks));
 	}
@@ -157,6 +170,10 @@ public:
 			PhysicalOrder::ScheduleMergeTasks(pipeline, *this, gstate);
 		}
 	}
+
+	string GetName() const override {
+		return "Order Merge Round";
+	}
 };
 
 SinkFinalizeType PhysicalOrder::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
@@ -189,33 +206,84 @@ void PhysicalOrder::ScheduleMergeTasks(Pipeline &pipeline, Event &event, OrderGl
 //===--------------------------------------------------------------------===//
 // Source
 //===--------------------------------------------------------------------===//
-class PhysicalOrderOperatorState : public GlobalSourceState {
+class PhysicalOrderGlobalSourceState : public GlobalSourceState {
+public:
+	explicit PhysicalOrderGlobalSourceState(const PhysicalOrder &op) : op(op), next_block(0) {
+	}
+
+	const PhysicalOrder &op;
+	mutex lock;
+	//! The next block of the sorted data that is handed out to a thread
+	idx_t next_block;
+
 public:
-	//! Payload scanner
+	idx_t MaxThreads() override {
+		// every thread scans whole blocks of the sorted data
+		return BlockCount();
+	}
+
+	idx_t BlockCount() const {
+		auto &global_sort_state = ((OrderGlobalState &)*op.sink_state).global_sort_state;
+		if (global_sort_state.sorted_blocks.empty()) {
+			return 0;
+		}
+		return global_sort_state.sorted_blocks[0]->payload_data->data_blocks.size();
+	}
+};
+
+class PhysicalOrderLocalSourceState : public LocalSourceState {
+public:
+	PhysicalOrderLocalSourceState() : block_idx(0) {
+	}
+
+	//! Scanner of the block that is currently being scanned
 	unique_ptr<PayloadScanner> scanner;
+	//! The index of that block, which doubles as the batch index of the scanned chunks
+	idx_t block_idx;
 };
 
 unique_ptr<GlobalSourceState> PhysicalOrder::GetGlobalSourceState(ClientContext &context) const {
-	return make_unique<PhysicalOrderOperatorState>();
+	return make_unique<PhysicalOrderGlobalSourceState>(*this);
 }
 
-void PhysicalOrder::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
-                            LocalSourceState &lstate) const {
-	auto &state = (PhysicalOrderOperatorState &)gstate;
+unique_ptr<LocalSourceState> PhysicalOrder::GetLocalSourceState(ExecutionContext &context,
+                                                                GlobalSourceState &gstate) const {
+	return make_unique<PhysicalOrderLocalSourceState>();
+}
 
-	if (!state.scanner) {
-		// Initialize scanner (if not yet initialized)
-		auto &gstate = (OrderGlobalState &)*this->sink_state;
-		auto &global_sort_state = gstate.global_sort_state;
-		if (global_sort_state.sorted_blocks.empty()) {
-			return;
+void PhysicalOrder::GetData(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate_p,
+                            LocalSourceState &lstate_p) const {
+	auto &gstate = (PhysicalOrderGlobalSourceState &)gstate_p;
+	auto &lstate = (PhysicalOrderLocalSourceState &)lstate_p;
+	auto &global_sort_state = ((OrderGlobalState &)*this->sink_state).global_sort_state;
+
+	while (true) {
+		if (lstate.scanner) {
+			// Scan the next data chunk
+			lstate.scanner->Scan(chunk);
+			if (chunk.size() > 0) {
+				return;
+			}
+			// Done with this block: release it
+			lstate.scanner.reset();
+			global_sort_state.sorted_blocks[0]->payload_data->data_blocks[lstate.block_idx].block = nullptr;
 		}
-		state.scanner =
-		    make_unique<PayloadScanner>(*global_sort_state.sorted_blocks[0]->payload_data, global_sort_state);
+		// Fetch the next block to scan
+		{
+			lock_guard<mutex> guard(gstate.lock);
+			if (gstate.next_block >= gstate.BlockCount()) {
+				return;
+			}
+			lstate.block_idx = gstate.next_block++;
+		}
+		lstate.scanner = make_unique<PayloadScanner>(global_sort_state, lstate.block_idx);
 	}
+}
 
-	// Scan the next data chunk
-	state.scanner->Scan(chunk);
+idx_t PhysicalOrder::GetBatchIndex(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
+                                   LocalSourceState &lstate_p) const {
+	auto &lstate = (PhysicalOrderLocalSourceState &)lstate_p;
+	return lstate.block_idx;
 }
 
 string PhysicalOrder::ParamsToString() const {
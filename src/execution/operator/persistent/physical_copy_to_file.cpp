@@ -1,26 +1,119 @@
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/table/row_group.hpp"
 
 #include <algorithm>
 
 namespace duckdb {
 
+//! The chunks of a batch that cannot be written yet. The chunks are serialized into blocks of the buffer manager, so
+//! buffered batches count towards the memory limit and are written to the temporary directory when it is reached.
+class CopyToBufferedBatch {
+public:
+	explicit CopyToBufferedBatch(BufferManager &buffer_manager) : buffer_manager(buffer_manager) {
+	}
+
+	void Append(DataChunk &chunk) {
+		chunk.Serialize(serializer);
+		if (serializer.blob.size >= Storage::BLOCK_SIZE) {
+			FlushBlock();
+		}
+	}
+
+	//! Calls the callback for every chunk, in the order in which they were appended, and releases the blocks
+	void Scan(const std::function<void(DataChunk &)> &callback) {
+		FlushBlock();
+		for (idx_t block_idx = 0; block_idx < blocks.size(); block_idx++) {
+			auto handle = buffer_manager.Pin(blocks[block_idx]);
+			BufferedDeserializer source(handle->Ptr(), block_sizes[block_idx]);
+			while (source.ptr < source.endptr) {
+				DataChunk chunk;
+				chunk.Deserialize(source);
+				callback(chunk);
+			}
+			handle.reset();
+			blocks[block_idx].reset();
+		}
+	}
+
+private:
+	void FlushBlock() {
+		auto size = serializer.blob.size;
+		if (size == 0) {
+			return;
+		}
+		auto block = buffer_manager.RegisterMemory(size, false);
+		auto handle = buffer_manager.Pin(block);
+		memcpy(handle->Ptr(), serializer.blob.data.get(), size);
+		blocks.push_back(move(block));
+		block_sizes.push_back(size);
+		serializer.Reset();
+	}
+
+private:
+	BufferManager &buffer_manager;
+	//! The serialized chunks that do not fill a block yet
+	BufferedSerializer serializer;
+	vector<shared_ptr<BlockHandle>> blocks;
+	vector<idx_t> block_sizes;
+};
+
+//! Rows that were sealed into a unit of the size desired by the copy function, and that are encoded next
+struct CopyToSealedBatch {
+	CopyToSealedBatch(idx_t unit_index, unique_ptr<ChunkCollection> collection)
+	    : unit_index(unit_index), collection(move(collection)) {
+	}
+
+	idx_t unit_index;
+	unique_ptr<ChunkCollection> collection;
+};
+
 class CopyToFunctionGlobalState : public GlobalSinkState {
 public:
-	explicit CopyToFunctionGlobalState(unique_ptr<GlobalFunctionData> global_state)
-	    : rows_copied(0), global_state(move(global_state)) {
+	CopyToFunctionGlobalState(unique_ptr<GlobalFunctionData> global_state, unique_ptr<LocalFunctionData> local_state)
+	    : rows_copied(0), global_state(move(global_state)), local_state(move(local_state)), next_batch(0),
+	      pending(make_unique<ChunkCollection>()), next_unit(0), next_flush(0) {
 	}
 
+	mutex lock;
 	idx_t rows_copied;
 	unique_ptr<GlobalFunctionData> global_state;
+	//! All data is written through this local state of the copy function, in the order of the batch indexes
+	//! (only used if the copy function cannot prepare batches)
+	unique_ptr<LocalFunctionData> local_state;
+	//! The batch that is written next, the chunks of this batch are written as soon as they are sunk
+	idx_t next_batch;
+	//! Batches that have been completely sunk but that are preceded by batches that have not been written yet
+	map<idx_t, unique_ptr<CopyToBufferedBatch>> completed_batches;
+
+	//! If the copy function prepares batches: the rows that are in order but not sealed into a unit yet
+	unique_ptr<ChunkCollection> pending;
+	//! The index of the next unit that is sealed
+	idx_t next_unit;
+
+	//! Serializes writing the prepared units, in the order of their unit index
+	mutex flush_lock;
+	//! The unit that is written next
+	idx_t next_flush;
+	//! Units that have been prepared but that are preceded by units that are still being prepared
+	map<idx_t, unique_ptr<PreparedBatchData>> prepared_units;
 };
 
 class CopyToFunctionLocalState : public LocalSinkState {
 public:
-	explicit CopyToFunctionLocalState(unique_ptr<LocalFunctionData> local_state) : local_state(move(local_state)) {
+	CopyToFunctionLocalState() : current_batch(DConstants::INVALID_INDEX) {
 	}
-	unique_ptr<LocalFunctionData> local_state;
+
+	//! The batch this thread is currently sinking
+	idx_t current_batch;
+	//! The chunks of the current batch that were sunk before all preceding batches were written
+	unique_ptr<CopyToBufferedBatch> buffered;
 };
 
 //===--------------------------------------------------------------------===//
@@ -41,28 +134,142 @@ PhysicalCopyToFile::PhysicalCopyToFile(vector<LogicalType> types, CopyFunction f
       function(move(function_p)), bind_data(move(bind_data)) {
 }
 
+bool PhysicalCopyToFile::PreparesBatches() const {
+	return function.copy_to_prepare_batch && function.copy_to_flush_batch;
+}
+
+void PhysicalCopyToFile::AppendChunk(ClientContext &context, GlobalSinkState &gstate, DataChunk &chunk,
+                                     vector<CopyToSealedBatch> &sealed) const {
+	auto &g = (CopyToFunctionGlobalState &)gstate;
+	if (!PreparesBatches()) {
+		function.copy_to_sink(context, *bind_data, *g.global_state, *g.local_state, chunk);
+		return;
+	}
+	g.pending->Append(chunk);
+	idx_t desired_size = function.copy_to_desired_batch_size
+	                         ? function.copy_to_desired_batch_size(context, *bind_data)
+	                         : RowGroup::ROW_GROUP_SIZE;
+	if (g.pending->Count() >= desired_size) {
+		// the unit is encoded by this thread after releasing the lock
+		sealed.emplace_back(g.next_unit++, move(g.pending));
+		g.pending = make_unique<ChunkCollection>();
+	}
+}
+
+void PhysicalCopyToFile::WriteChunks(ClientContext &context, GlobalSinkState &gstate,
+                                     unique_ptr<CopyToBufferedBatch> chunks, vector<CopyToSealedBatch> &sealed) const {
+	if (!chunks) {
+		return;
+	}
+	chunks->Scan([&](DataChunk &chunk) { AppendChunk(context, gstate, chunk, sealed); });
+}
+
+void PhysicalCopyToFile::PrepareAndFlush(ClientContext &context, GlobalSinkState &gstate,
+                                         vector<CopyToSealedBatch> &sealed) const {
+	auto &g = (CopyToFunctionGlobalState &)gstate;
+	for (auto &batch : sealed) {
+		// encoding happens in parallel, only writing the encoded units is serialized
+		auto prepared = function.copy_to_prepare_batch(context, *bind_data, *g.global_state, *batch.collection);
+		batch.collection.reset();
+
+		lock_guard<mutex> guard(g.flush_lock);
+		g.prepared_units[batch.unit_index] = move(prepared);
+		while (!g.prepared_units.empty() && g.prepared_units.begin()->first == g.next_flush) {
+			function.copy_to_flush_batch(context, *bind_data, *g.global_state, *g.prepared_units.begin()->second);
+			g.prepared_units.erase(g.prepared_units.begin());
+			g.next_flush++;
+		}
+	}
+	sealed.clear();
+}
+
+void PhysicalCopyToFile::FinishBatch(ClientContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const {
+	auto &g = (CopyToFunctionGlobalState &)gstate;
+	auto &l = (CopyToFunctionLocalState &)lstate;
+
+	vector<CopyToSealedBatch> sealed;
+	{
+		lock_guard<mutex> guard(g.lock);
+		if (l.current_batch != g.next_batch) {
+			// preceding batches are still being sunk: write this batch after them
+			g.completed_batches[l.current_batch] = move(l.buffered);
+			return;
+		}
+		WriteChunks(context, gstate, move(l.buffered), sealed);
+		g.next_batch++;
+		// write the completed batches that were waiting for this one
+		while (!g.completed_batches.empty() && g.completed_batches.begin()->first == g.next_batch) {
+			WriteChunks(context, gstate, move(g.completed_batches.begin()->second), sealed);
+			g.completed_batches.erase(g.completed_batches.begin());
+			g.next_batch++;
+		}
+	}
+	PrepareAndFlush(context, gstate, sealed);
+}
+
 SinkResultType PhysicalCopyToFile::Sink(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate,
                                         DataChunk &input) const {
 	auto &g = (CopyToFunctionGlobalState &)gstate;
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
-	g.rows_copied += input.size();
-	function.copy_to_sink(context.client, *bind_data, *g.global_state, *l.local_state, input);
+	if (l.batch_index != l.current_batch) {
+		if (l.current_batch != DConstants::INVALID_INDEX) {
+			FinishBatch(context.client, gstate, lstate);
+		}
+		l.current_batch = l.batch_index;
+	}
+	vector<CopyToSealedBatch> sealed;
+	bool written = false;
+	{
+		lock_guard<mutex> guard(g.lock);
+		g.rows_copied += input.size();
+		if (l.current_batch == g.next_batch) {
+			// all preceding batches have been written: write the chunk directly
+			WriteChunks(context.client, gstate, move(l.buffered), sealed);
+			AppendChunk(context.client, gstate, input, sealed);
+			written = true;
+		}
+	}
+	if (written) {
+		PrepareAndFlush(context.client, gstate, sealed);
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+	if (!l.buffered) {
+		l.buffered = make_unique<CopyToBufferedBatch>(BufferManager::GetBufferManager(context.client));
+	}
+	l.buffered->Append(input);
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
 void PhysicalCopyToFile::Combine(ExecutionContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const {
-	auto &g = (CopyToFunctionGlobalState &)gstate;
 	auto &l = (CopyToFunctionLocalState &)lstate;
 
-	if (function.copy_to_combine) {
-		function.copy_to_combine(context.client, *bind_data, *g.global_state, *l.local_state);
+	// the data is only flushed from the shared local state of the copy function when all batches are written, flushing
+	// it here would cut e.g. Parquet row groups short whenever a thread finishes
+	if (l.current_batch != DConstants::INVALID_INDEX) {
+		FinishBatch(context.client, gstate, lstate);
 	}
 }
 
 SinkFinalizeType PhysicalCopyToFile::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                               GlobalSinkState &gstate_p) const {
 	auto &gstate = (CopyToFunctionGlobalState &)gstate_p;
+	// the batch indexes are not necessarily consecutive: write the remaining batches in order
+	vector<CopyToSealedBatch> sealed;
+	for (auto &entry : gstate.completed_batches) {
+		WriteChunks(context, gstate, move(entry.second), sealed);
+	}
+	gstate.completed_batches.clear();
+	if (PreparesBatches()) {
+		// the rows that did not fill a complete unit
+		if (gstate.pending->Count() > 0) {
+			sealed.emplace_back(gstate.next_unit++, move(gstate.pending));
+		}
+		PrepareAndFlush(context, gstate, sealed);
+		D_ASSERT(gstate.prepared_units.empty());
+	} else if (function.copy_to_combine) {
+		function.copy_to_combine(context, *bind_data, *gstate.global_state, *gstate.local_state);
+	}
 	if (function.copy_to_finalize) {
 		function.copy_to_finalize(context, *bind_data, *gstate.global_state);
 
@@ -74,10 +281,11 @@ SinkFinalizeType PhysicalCopyToFile::Finalize(Pipeline &pipeline, Event &event,
 }
 
 unique_ptr<LocalSinkState> PhysicalCopyToFile::GetLocalSinkState(ExecutionContext &context) const {
-	return make_unique<CopyToFunctionLocalState>(function.copy_to_initialize_local(context.client, *bind_data));
+	return make_unique<CopyToFunctionLocalState>();
 }
 unique_ptr<GlobalSinkState> PhysicalCopyToFile::GetGlobalSinkState(ClientContext &context) const {
-	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data, file_path));
+	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data, file_path),
+	                                              function.copy_to_initialize_local(context, *bind_data));
 }
 
 //===--------------------------------------------------------------------===//
@@ -60,6 +60,11 @@ void PhysicalOperator::GetData(ExecutionContext &context, DataChunk &chunk, Glob
                                LocalSourceState &lstate) const {
 	throw InternalException("Calling GetData on a node that is not a source!");
 }
+
+idx_t PhysicalOperator::GetBatchIndex(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
+                                      LocalSourceState &lstate) const {
+	throw InternalException("Calling GetBatchIndex on a source that does not support batch indexes!");
+}
 // LCOV_EXCL_STOP
 
 //===--------------------------------------------------------------------===//
@@ -2,6 +2,7 @@
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
 #include "duckdb/parallel/event.hpp"
+#include "duckdb/parallel/thread_context.hpp"
 
 namespace duckdb {
 
@@ -254,8 +255,8 @@ bool RadixPartitionedHashTable::Finalize(ClientContext &context, GlobalSinkState
 class RadixAggregateFinalizeTask : public ExecutorTask {
 public:
 	RadixAggregateFinalizeTask(Executor &executor, shared_ptr<Event> event_p, RadixHTGlobalState &state_p,
-	                           idx_t radix_p)
-	    : ExecutorTask(executor), event(move(event_p)), state(state_p), radix(radix_p) {
+	                           idx_t radix_p, const PhysicalOperator &op_p)
+	    : ExecutorTask(executor), event(move(event_p)), state(state_p), radix(radix_p), op(op_p) {
 	}
 
 	static void FinalizeHT(RadixHTGlobalState &gstate, idx_t radix) {
@@ -271,15 +272,25 @@ public:
 	}
 
 	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
+		// combining the partitions is part of the work of the aggregate in the query profile
+		ThreadContext thread(executor.context);
+		thread.profiler.StartOperator(&op);
 		FinalizeHT(state, radix);
+		thread.profiler.EndOperator(nullptr);
+		executor.Flush(thread);
 		event->FinishTask();
 		return TaskExecutionResult::TASK_FINISHED;
 	}
 
+	string GetName() const override {
+		return "Hash Aggregate Finalize " + to_string(radix);
+	}
+
 private:
 	shared_ptr<Event> event;
 	RadixHTGlobalState &state;
 	idx_t radix;
+	const PhysicalOperator &op;
 };
 
 void RadixPartitionedHashTable::ScheduleTasks(Executor &executor, const shared_ptr<Event> &event,
@@ -291,7 +302,7 @@ void RadixPartitionedHashTable::ScheduleTasks(Executor &executor, const shared_p
 	for (idx_t r = 0; r < gstate.partition_info.n_partitions; r++) {
 		D_ASSERT(gstate.partition_info.n_partitions <= gstate.finalized_hts.size());
 		D_ASSERT(gstate.finalized_hts[r]);
-		tasks.push_back(make_unique<RadixAggregateFinalizeTask>(executor, event, gstate, r));
+		tasks.push_back(make_unique<RadixAggregateFinalizeTask>(executor, event, gstate, r, op));
 	}
 }
 
@@ -27,7 +27,10 @@ static void AgeFunction(DataChunk &input, ExpressionState &state, Vector &result
 
 void AgeFun::RegisterFunction(BuiltinFunctions &set) {
 	ScalarFunctionSet age("age");
-	age.AddFunction(ScalarFunction({LogicalType::TIMESTAMP}, LogicalType::INTERVAL, AgeFunctionStandard));
+	// the age of a single timestamp is relative to the current date
+	ScalarFunction age_standard({LogicalType::TIMESTAMP}, LogicalType::INTERVAL, AgeFunctionStandard);
+	age_standard.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	age.AddFunction(age_standard);
 	age.AddFunction(
 	    ScalarFunction({LogicalType::TIMESTAMP, LogicalType::TIMESTAMP}, LogicalType::INTERVAL, AgeFunction));
 	set.AddFunction(age);
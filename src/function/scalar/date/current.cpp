@@ -57,16 +57,22 @@ unique_ptr<FunctionData> BindCurrentTime(ClientContext &context, ScalarFunction
 }
 
 void CurrentTimeFun::RegisterFunction(BuiltinFunctions &set) {
-	set.AddFunction(ScalarFunction("current_time", {}, LogicalType::TIME, CurrentTimeFunction, false, BindCurrentTime));
+	ScalarFunction current_time("current_time", {}, LogicalType::TIME, CurrentTimeFunction, false, BindCurrentTime);
+	current_time.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(current_time);
 }
 
 void CurrentDateFun::RegisterFunction(BuiltinFunctions &set) {
-	set.AddFunction(ScalarFunction("current_date", {}, LogicalType::DATE, CurrentDateFunction, false, BindCurrentTime));
+	ScalarFunction current_date("current_date", {}, LogicalType::DATE, CurrentDateFunction, false, BindCurrentTime);
+	current_date.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(current_date);
 }
 
 void CurrentTimestampFun::RegisterFunction(BuiltinFunctions &set) {
-	set.AddFunction({"now", "current_timestamp"}, ScalarFunction({}, LogicalType::TIMESTAMP, CurrentTimestampFunction,
-	                                                             false, false, BindCurrentTime));
+	ScalarFunction current_timestamp({}, LogicalType::TIMESTAMP, CurrentTimestampFunction, false, false,
+	                                 BindCurrentTime);
+	current_timestamp.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction({"now", "current_timestamp"}, current_timestamp);
 }
 
 } // namespace duckdb
@@ -57,8 +57,10 @@ unique_ptr<FunctionData> CurrentSettingBind(ClientContext &context, ScalarFuncti
 }
 
 void CurrentSettingFun::RegisterFunction(BuiltinFunctions &set) {
-	set.AddFunction(ScalarFunction("current_setting", {LogicalType::VARCHAR}, LogicalType::ANY, CurrentSettingFunction,
-	                               false, CurrentSettingBind));
+	ScalarFunction current_setting("current_setting", {LogicalType::VARCHAR}, LogicalType::ANY,
+	                               CurrentSettingFunction, false, CurrentSettingBind);
+	current_setting.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(current_setting);
 }
 
 } // namespace duckdb
@@ -151,6 +151,210 @@ struct ContainsOperator {
 	}
 };
 
+//! A rough rank of how common a byte is in text, used to pick the byte of a needle that is searched for with memchr
+static uint8_t ByteFrequencyRank(unsigned char c) {
+	switch (c) {
+	case ' ':
+	case 'e':
+	case 't':
+	case 'a':
+	case 'o':
+	case 'i':
+	case 'n':
+	case 's':
+	case 'r':
+		return 4;
+	default:
+		break;
+	}
+	if (c >= 'a' && c <= 'z') {
+		return 3;
+	}
+	if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+		return 2;
+	}
+	// punctuation and control characters are rarer still, and bytes outside of ASCII the rarest
+	return c < 128 ? 1 : 0;
+}
+
+//! Matches strings against a set of needles
+//! With only a few needles, every needle is searched for separately: memchr finds the occurrences of its rarest byte,
+//! which are then verified against the entire needle.
+//! With more needles, every string is scanned once. Each position is checked against a table of the first bytes of
+//! all needles and a bitmap of their first two bytes; only positions that pass both filters are verified against the
+//! needles starting with that pair.
+struct ContainsAnyBindData : public FunctionData {
+	static constexpr const uint8_t NEEDLE_START = 1;
+	static constexpr const uint8_t SINGLE_BYTE_NEEDLE = 2;
+	static constexpr const idx_t PAIR_COUNT = 65536;
+	static constexpr const idx_t FEW_NEEDLES = 3;
+
+	explicit ContainsAnyBindData(vector<string> needles_p) : needles(move(needles_p)), always_match(false) {
+		memset(first_bytes, 0, sizeof(first_bytes));
+		for (auto &needle : needles) {
+			if (needle.empty()) {
+				// the empty needle is contained in every string
+				always_match = true;
+				return;
+			}
+		}
+		if (needles.size() <= FEW_NEEDLES) {
+			for (auto &needle : needles) {
+				auto needle_data = (const unsigned char *)needle.c_str();
+				idx_t rare_offset = 0;
+				for (idx_t i = 1; i < needle.size(); i++) {
+					if (ByteFrequencyRank(needle_data[i]) < ByteFrequencyRank(needle_data[rare_offset])) {
+						rare_offset = i;
+					}
+				}
+				rare_offsets.push_back(rare_offset);
+			}
+			return;
+		}
+		pair_filter.resize(PAIR_COUNT / 64, 0);
+		// the needles of every pair are stored contiguously in pair_needles, starting at pair_offsets[pair]
+		pair_offsets.resize(PAIR_COUNT + 1, 0);
+		for (auto &needle : needles) {
+			auto needle_data = (const unsigned char *)needle.c_str();
+			if (needle.size() == 1) {
+				first_bytes[needle_data[0]] |= SINGLE_BYTE_NEEDLE;
+				continue;
+			}
+			first_bytes[needle_data[0]] |= NEEDLE_START;
+			auto pair = GetPair(needle_data);
+			pair_filter[pair / 64] |= uint64_t(1) << (pair % 64);
+			pair_offsets[pair + 1]++;
+		}
+		for (idx_t pair = 0; pair < PAIR_COUNT; pair++) {
+			pair_offsets[pair + 1] += pair_offsets[pair];
+		}
+		pair_needles.resize(pair_offsets[PAIR_COUNT]);
+		vector<uint32_t> pair_fill(pair_offsets.begin(), pair_offsets.end() - 1);
+		for (idx_t needle_idx = 0; needle_idx < needles.size(); needle_idx++) {
+			auto &needle = needles[needle_idx];
+			if (needle.size() > 1) {
+				pair_needles[pair_fill[GetPair((const unsigned char *)needle.c_str())]++] = needle_idx;
+			}
+		}
+	}
+
+	//! The needles, sorted and without duplicates
+	vector<string> needles;
+	//! Whether or not one of the needles is empty
+	bool always_match;
+	//! With only a few needles: the offset of the rarest byte within every needle
+	vector<idx_t> rare_offsets;
+	//! For every byte value: whether or not it is a single-byte needle or the start of a longer needle
+	uint8_t first_bytes[256];
+	//! Bitmap of the first two bytes of all needles with two or more bytes
+	vector<uint64_t> pair_filter;
+	//! For every pair of first two bytes: the offset of its needles in pair_needles (the last entry is the total)
+	vector<uint32_t> pair_offsets;
+	//! The needles (indexes into needles) with two or more bytes, grouped by their first two bytes
+	vector<idx_t> pair_needles;
+
+public:
+	static inline uint16_t GetPair(const unsigned char *data) {
+		return (uint16_t(data[0]) << 8) | uint16_t(data[1]);
+	}
+
+	bool Match(const string_t &str) const {
+		if (always_match) {
+			return true;
+		}
+		auto str_data = (const unsigned char *)str.GetDataUnsafe();
+		auto str_size = str.GetSize();
+		if (!rare_offsets.empty()) {
+			return MatchFew(str_data, str_size);
+		}
+		for (idx_t i = 0; i < str_size; i++) {
+			auto flags = first_bytes[str_data[i]];
+			if (flags == 0) {
+				continue;
+			}
+			if (flags & SINGLE_BYTE_NEEDLE) {
+				return true;
+			}
+			if (i + 1 == str_size) {
+				// the remainder of the string is too short for any needle starting with this byte
+				break;
+			}
+			auto pair = GetPair(str_data + i);
+			if (!(pair_filter[pair / 64] & (uint64_t(1) << (pair % 64)))) {
+				continue;
+			}
+			// the first two bytes match: verify the needles starting with this pair
+			for (auto offset = pair_offsets[pair]; offset < pair_offsets[pair + 1]; offset++) {
+				auto &needle = needles[pair_needles[offset]];
+				if (needle.size() <= str_size - i && memcmp(str_data + i, needle.c_str(), needle.size()) == 0) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	bool MatchFew(const unsigned char *str_data, idx_t str_size) const {
+		for (idx_t needle_idx = 0; needle_idx < needles.size(); needle_idx++) {
+			auto &needle = needles[needle_idx];
+			if (needle.size() > str_size) {
+				continue;
+			}
+			auto needle_data = (const unsigned char *)needle.c_str();
+			auto rare_offset = rare_offsets[needle_idx];
+			auto rare_byte = needle_data[rare_offset];
+			// the rare byte can only be found at the positions where the entire needle fits in the string
+			auto search = str_data + rare_offset;
+			auto search_end = str_data + str_size - needle.size() + rare_offset + 1;
+			while (search < search_end) {
+				auto found = (const unsigned char *)memchr(search, rare_byte, search_end - search);
+				if (!found) {
+					break;
+				}
+				if (memcmp(found - rare_offset, needle_data, needle.size()) == 0) {
+					return true;
+				}
+				search = found + 1;
+			}
+		}
+		return false;
+	}
+
+	unique_ptr<FunctionData> Copy() const override {
+		return make_unique<ContainsAnyBindData>(needles);
+	}
+
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = (const ContainsAnyBindData &)other_p;
+		return needles == other.needles;
+	}
+};
+
+static void ContainsAnyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &func_expr = (BoundFunctionExpression &)state.expr;
+	auto &info = (ContainsAnyBindData &)*func_expr.bind_info;
+	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(),
+	                                       [&](string_t input) { return info.Match(input); });
+}
+
+unique_ptr<FunctionData> ContainsFun::BindNeedles(vector<string> needles) {
+	std::sort(needles.begin(), needles.end());
+	needles.erase(std::unique(needles.begin(), needles.end()), needles.end());
+	return make_unique<ContainsAnyBindData>(move(needles));
+}
+
+const vector<string> &ContainsFun::GetNeedles(const FunctionData &bind_data) {
+	return ((const ContainsAnyBindData &)bind_data).needles;
+}
+
+ScalarFunction ContainsFun::GetAnyFunction() {
+	// the needles are passed as constant arguments so they show up when the expression is printed, but the function
+	// only reads the string: it searches for the needles of the bind data created by BindNeedles
+	ScalarFunction function("contains_any", {LogicalType::VARCHAR}, LogicalType::BOOLEAN, ContainsAnyFunction);
+	function.varargs = LogicalType::VARCHAR;
+	return function;
+}
+
 ScalarFunction ContainsFun::GetFunction() {
 	return ScalarFunction("contains",                                   // name of the function
 	                      {LogicalType::VARCHAR, LogicalType::VARCHAR}, // argument list
@@ -74,12 +74,19 @@ void SystemFun::RegisterFunction(BuiltinFunctions &set) {
 
 	set.AddFunction(
 	    ScalarFunction("current_query", {}, LogicalType::VARCHAR, CurrentQueryFunction, true, BindSystemFunction));
-	set.AddFunction(
-	    ScalarFunction("current_schema", {}, LogicalType::VARCHAR, CurrentSchemaFunction, false, BindSystemFunction));
-	set.AddFunction(ScalarFunction("current_schemas", {LogicalType::BOOLEAN}, varchar_list_type, CurrentSchemasFunction,
-	                               false, BindSystemFunction));
-	set.AddFunction(
-	    ScalarFunction("txid_current", {}, LogicalType::BIGINT, TransactionIdCurrent, false, BindSystemFunction));
+	// the results of these functions depend on the client and the transaction that run them
+	ScalarFunction current_schema("current_schema", {}, LogicalType::VARCHAR, CurrentSchemaFunction, false,
+	                              BindSystemFunction);
+	current_schema.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(current_schema);
+	ScalarFunction current_schemas("current_schemas", {LogicalType::BOOLEAN}, varchar_list_type,
+	                               CurrentSchemasFunction, false, BindSystemFunction);
+	current_schemas.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(current_schemas);
+	ScalarFunction txid_current("txid_current", {}, LogicalType::BIGINT, TransactionIdCurrent, false,
+	                            BindSystemFunction);
+	txid_current.stability = FunctionStability::CONSISTENT_WITHIN_QUERY;
+	set.AddFunction(txid_current);
 	set.AddFunction(ScalarFunction("version", {}, LogicalType::VARCHAR, VersionFunction));
 	set.AddFunction(ExportAggregateFunction::GetCombine());
 	set.AddFunction(ExportAggregateFunction::GetFinalize());
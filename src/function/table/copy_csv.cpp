@@ -5,6 +5,7 @@
 #include "duckdb/parser/parsed_data/copy_info.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/types/string_type.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/function/scalar/string_functions.hpp"
@@ -298,17 +299,12 @@ static unique_ptr<GlobalFunctionData> WriteCSVInitializeGlobal(ClientContext &co
 	return move(global_data);
 }
 
-static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
-                         LocalFunctionData &lstate, DataChunk &input) {
+static void WriteCSVChunkInternal(ClientContext &context, FunctionData &bind_data, DataChunk &cast_chunk,
+                                  BufferedSerializer &writer, DataChunk &input) {
 	auto &csv_data = (WriteCSVData &)bind_data;
 	auto &options = csv_data.options;
-	auto &local_data = (LocalReadCSVData &)lstate;
-	auto &global_state = (GlobalWriteCSVData &)gstate;
-
-	// write data into the local buffer
 
 	// first cast the columns of the chunk to varchar
-	auto &cast_chunk = local_data.cast_chunk;
 	cast_chunk.SetCardinality(input);
 	for (idx_t col_idx = 0; col_idx < input.ColumnCount(); col_idx++) {
 		if (csv_data.sql_types[col_idx].id() == LogicalTypeId::VARCHAR) {
@@ -321,7 +317,6 @@ static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, Global
 	}
 
 	cast_chunk.Normalify();
-	auto &writer = local_data.serializer;
 	// now loop over the vectors and output the values
 	for (idx_t row_idx = 0; row_idx < cast_chunk.size(); row_idx++) {
 		// write values
@@ -346,7 +341,19 @@ static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, Global
 		}
 		writer.WriteBufferData(csv_data.newline);
 	}
+}
+
+static void WriteCSVSink(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                         LocalFunctionData &lstate, DataChunk &input) {
+	auto &csv_data = (WriteCSVData &)bind_data;
+	auto &local_data = (LocalReadCSVData &)lstate;
+	auto &global_state = (GlobalWriteCSVData &)gstate;
+
+	// write data into the local buffer
+	WriteCSVChunkInternal(context, bind_data, local_data.cast_chunk, local_data.serializer, input);
+
 	// check if we should flush what we have currently written
+	auto &writer = local_data.serializer;
 	if (writer.blob.size >= csv_data.flush_size) {
 		global_state.WriteData(writer.blob.data.get(), writer.blob.size);
 		writer.Reset();
@@ -378,6 +385,44 @@ void WriteCSVFinalize(ClientContext &context, FunctionData &bind_data, GlobalFun
 	global_state.handle.reset();
 }
 
+//===--------------------------------------------------------------------===//
+// Prepare Batch
+//===--------------------------------------------------------------------===//
+struct WriteCSVBatchData : public PreparedBatchData {
+	//! The thread-local buffer to write data into
+	BufferedSerializer serializer;
+};
+
+static unique_ptr<PreparedBatchData> WriteCSVPrepareBatch(ClientContext &context, FunctionData &bind_data,
+                                                          GlobalFunctionData &gstate, ChunkCollection &collection) {
+	auto &csv_data = (WriteCSVData &)bind_data;
+
+	// create the cast chunk with VARCHAR types
+	vector<LogicalType> types;
+	types.resize(csv_data.options.names.size(), LogicalType::VARCHAR);
+	DataChunk cast_chunk;
+	cast_chunk.Initialize(types);
+
+	// write the rows to the batch data
+	auto batch = make_unique<WriteCSVBatchData>();
+	for (auto &chunk : collection.Chunks()) {
+		WriteCSVChunkInternal(context, bind_data, cast_chunk, batch->serializer, *chunk);
+	}
+	return move(batch);
+}
+
+//===--------------------------------------------------------------------===//
+// Flush Batch
+//===--------------------------------------------------------------------===//
+static void WriteCSVFlushBatch(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                               PreparedBatchData &batch) {
+	auto &csv_batch = (WriteCSVBatchData &)batch;
+	auto &global_state = (GlobalWriteCSVData &)gstate;
+	auto &writer = csv_batch.serializer;
+	global_state.WriteData(writer.blob.data.get(), writer.blob.size);
+	writer.Reset();
+}
+
 void CSVCopyFunction::RegisterFunction(BuiltinFunctions &set) {
 	CopyFunction info("csv");
 	info.copy_to_bind = WriteCSVBind;
@@ -386,6 +431,8 @@ void CSVCopyFunction::RegisterFunction(BuiltinFunctions &set) {
 	info.copy_to_sink = WriteCSVSink;
 	info.copy_to_combine = WriteCSVCombine;
 	info.copy_to_finalize = WriteCSVFinalize;
+	info.copy_to_prepare_batch = WriteCSVPrepareBatch;
+	info.copy_to_flush_batch = WriteCSVFlushBatch;
 
 	info.copy_from_bind = ReadCSVBind;
 	info.copy_from_function = ReadCSVTableFunction::GetFunction();
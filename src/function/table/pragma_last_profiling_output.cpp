@@ -41,16 +41,44 @@ static unique_ptr<FunctionData> PragmaLastProfilingOutputBind(ClientContext &con
 	names.emplace_back("DESCRIPTION");
 	return_types.emplace_back(LogicalType::VARCHAR);
 
+	names.emplace_back("PEAK_MEMORY");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("BYTES_SPILLED");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("BYTES_RELOADED");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("PIN_HITS");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("PIN_MISSES");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("BYTES_READ");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	names.emplace_back("ROWS_SCANNED");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
 	return make_unique<PragmaLastProfilingOutputData>(return_types);
 }
 
 static void SetValue(DataChunk &output, int index, int op_id, string name, double time, int64_t car,
-                     string description) {
+                     string description, const ThreadMetrics &metrics) {
 	output.SetValue(0, index, op_id);
 	output.SetValue(1, index, move(name));
 	output.SetValue(2, index, time);
 	output.SetValue(3, index, car);
 	output.SetValue(4, index, move(description));
+	output.SetValue(5, index, Value::UBIGINT(metrics.peak_memory));
+	output.SetValue(6, index, Value::UBIGINT(metrics.bytes_spilled));
+	output.SetValue(7, index, Value::UBIGINT(metrics.bytes_reloaded));
+	output.SetValue(8, index, Value::UBIGINT(metrics.pin_hits));
+	output.SetValue(9, index, Value::UBIGINT(metrics.pin_misses));
+	output.SetValue(10, index, Value::UBIGINT(metrics.bytes_read));
+	output.SetValue(11, index, Value::UBIGINT(metrics.rows_scanned));
 }
 
 unique_ptr<FunctionOperatorData> PragmaLastProfilingOutputInit(ClientContext &context, const FunctionData *bind_data,
@@ -74,7 +102,7 @@ static void PragmaLastProfilingOutputFunction(ClientContext &context, const Func
 			for (auto op :
 			     ClientData::Get(context).query_profiler_history->GetPrevProfilers().back().second->GetTreeMap()) {
 				SetValue(chunk, chunk.size(), operator_counter++, op.second->name, op.second->info.time,
-				         op.second->info.elements, " ");
+				         op.second->info.elements, " ", op.second->info.metrics);
 				chunk.SetCardinality(chunk.size() + 1);
 				if (chunk.size() == STANDARD_VECTOR_SIZE) {
 					collection->Append(chunk);
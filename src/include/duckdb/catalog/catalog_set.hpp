@@ -11,6 +11,7 @@
 #include "duckdb/catalog/catalog_entry.hpp"
 #include "duckdb/catalog/default/default_generator.hpp"
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
 #include "duckdb/common/pair.hpp"
 #include "duckdb/common/unordered_set.hpp"
@@ -40,6 +41,58 @@ struct MappingValue {
 	MappingValue *parent;
 };
 
+//! The latest committed version of a catalog entry, which lookups can use without locking
+struct CatalogSnapshotEntry {
+	CatalogSnapshotEntry(CatalogEntry *entry, transaction_t timestamp) : entry(entry), timestamp(timestamp) {
+	}
+
+	//! The entry, or nullptr if the name does not exist
+	CatalogEntry *entry;
+	//! The commit timestamp of the entry and its name: only transactions that started later can use it
+	transaction_t timestamp;
+};
+
+//! A name in the lookup index of a catalog set
+struct CatalogSnapshotName {
+	explicit CatalogSnapshotName(string name_p) : name(move(name_p)), entry(nullptr) {
+	}
+
+	string name;
+	//! The entry that is read by lookups, or nullptr if lookups of this name have to go through the mapping
+	atomic<CatalogSnapshotEntry *> entry;
+	//! The entry that is pointed to by entry
+	unique_ptr<CatalogSnapshotEntry> current_entry;
+};
+
+//! An open addressing hash table of the names in a catalog set, which lookups probe without locking. Names are
+//! never removed from a table: it is replaced by a new table once it is half full, or once half of its names were
+//! removed from the mapping of the catalog set.
+struct CatalogSnapshotIndex {
+	static constexpr const idx_t INITIAL_CAPACITY = 16;
+
+	explicit CatalogSnapshotIndex(idx_t capacity);
+
+	//! Returns the name, or nullptr if the name is not in the index
+	CatalogSnapshotName *Find(const string &name);
+	void Insert(CatalogSnapshotName *name);
+
+	//! The capacity of the table, which is a power of two
+	idx_t capacity;
+	//! The amount of names in the table
+	idx_t count;
+	unique_ptr<atomic<CatalogSnapshotName *>[]> names;
+};
+
+//! An entry or index that was replaced, but might still be read by lookups
+struct RetiredCatalogSnapshot {
+	//! Transactions that start from this timestamp on cannot read it: it is freed once all older transactions are
+	//! finished
+	transaction_t timestamp;
+	unique_ptr<CatalogSnapshotEntry> entry;
+	unique_ptr<CatalogSnapshotIndex> index;
+	vector<unique_ptr<CatalogSnapshotName>> names;
+};
+
 //! The Catalog Set stores (key, value) map of a set of CatalogEntries
 class CatalogSet {
 	friend class DependencyManager;
@@ -102,13 +155,29 @@ private:
 	CatalogEntry *GetCommittedEntry(CatalogEntry *current);
 	bool GetEntryInternal(ClientContext &context, const string &name, idx_t &entry_index, CatalogEntry *&entry);
 	bool GetEntryInternal(ClientContext &context, idx_t entry_index, CatalogEntry *&entry);
-	//! Drops an entry from the catalog set; must hold the catalog_lock to safely call this
+	//! Drops an entry from the catalog set
 	void DropEntryInternal(ClientContext &context, idx_t entry_index, CatalogEntry &entry, bool cascade);
 	CatalogEntry *CreateEntryInternal(ClientContext &context, unique_ptr<CatalogEntry> entry);
 	MappingValue *GetMapping(ClientContext &context, const string &name, bool get_latest = false);
 	void PutMapping(ClientContext &context, const string &name, idx_t entry_index);
 	void DeleteMapping(ClientContext &context, const string &name);
 	void DropEntryDependencies(ClientContext &context, idx_t entry_index, CatalogEntry &entry, bool cascade);
+	//! Looks up an entry in the lookup index without taking the catalog_lock. Returns false if the lookup has to go
+	//! through the mapping instead.
+	bool GetEntryFromSnapshot(ClientContext &context, const string &name, CatalogEntry *&result);
+	//! Publishes the entry of a name to lookups if it was committed; must hold the catalog_lock
+	void UpdateSnapshot(const string &name);
+	//! Stops lookups from using the published entry of a name before it is changed; must hold the catalog_lock
+	void InvalidateSnapshot(const string &name);
+	void RetireSnapshot(unique_ptr<CatalogSnapshotEntry> entry, unique_ptr<CatalogSnapshotIndex> index,
+	                    vector<unique_ptr<CatalogSnapshotName>> names = vector<unique_ptr<CatalogSnapshotName>>());
+	//! Replaces the lookup index by one that only holds the names that are still in the mapping; must hold the
+	//! catalog_lock
+	void RebuildSnapshotIndex();
+	//! Called when a name is removed from the mapping; must hold the catalog_lock
+	void RemoveSnapshotName();
+	//! Frees the retired entries and indexes that can no longer be read; must hold the catalog_lock
+	void CleanupSnapshots();
 
 private:
 	Catalog &catalog;
@@ -122,5 +191,13 @@ private:
 	idx_t current_entry = 0;
 	//! The generator used to generate default internal entries
 	unique_ptr<DefaultGenerator> defaults;
+	//! The lookup index of the names in the mapping
+	atomic<CatalogSnapshotIndex *> snapshot_index;
+	unique_ptr<CatalogSnapshotIndex> current_index;
+	vector<unique_ptr<CatalogSnapshotName>> snapshot_names;
+	//! The amount of names that were removed from the mapping since the index was last rebuilt
+	idx_t removed_snapshot_names = 0;
+	//! The entries and indexes that were replaced while lookups might still be reading them
+	vector<RetiredCatalogSnapshot> retired_snapshots;
 };
 } // namespace duckdb
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/hardware_counters.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/common/winapi.hpp"
+
+namespace duckdb {
+
+//! The values of the hardware performance counters that are collected per operator
+struct HardwareCounterValues {
+	idx_t cycles = 0;
+	idx_t instructions = 0;
+	//! Misses in the last level cache
+	idx_t cache_misses = 0;
+	idx_t branch_misses = 0;
+	//! Misses of the data TLB
+	idx_t tlb_misses = 0;
+
+	void Combine(const HardwareCounterValues &other) {
+		cycles += other.cycles;
+		instructions += other.instructions;
+		cache_misses += other.cache_misses;
+		branch_misses += other.branch_misses;
+		tlb_misses += other.tlb_misses;
+	}
+	//! Turns the values into the counts since an earlier reading. The scaled values of multiplexed counters are
+	//! estimates that can be lower than an earlier reading, the count is zero in that case.
+	void Subtract(const HardwareCounterValues &start) {
+		cycles = cycles > start.cycles ? cycles - start.cycles : 0;
+		instructions = instructions > start.instructions ? instructions - start.instructions : 0;
+		cache_misses = cache_misses > start.cache_misses ? cache_misses - start.cache_misses : 0;
+		branch_misses = branch_misses > start.branch_misses ? branch_misses - start.branch_misses : 0;
+		tlb_misses = tlb_misses > start.tlb_misses ? tlb_misses - start.tlb_misses : 0;
+	}
+};
+
+//! The HardwareCounters read the hardware performance counters of the calling thread. The counters are only
+//! available on Linux, and only if the kernel permits perf events for the process (see perf_event_paranoid).
+class HardwareCounters {
+public:
+	HardwareCounters();
+	~HardwareCounters();
+
+	//! Returns the counters of the calling thread, they are opened when a thread first uses them
+	DUCKDB_API static HardwareCounters &Get();
+
+	//! Whether or not the counters could be opened
+	bool IsAvailable() const {
+		return group_fd >= 0;
+	}
+	//! Reads the current values of the counters, returns false if the counters are not available. If the kernel had to
+	//! multiplex the counters, the values are scaled up to the time the counters were enabled.
+	bool Read(HardwareCounterValues &result);
+
+private:
+	//! The file descriptor of the group leader (the cycle counter), or -1 if the counters are not available
+	int group_fd;
+	//! The file descriptors of all opened counters
+	vector<int> fds;
+	//! For each opened counter, the offset of its value in HardwareCounterValues
+	vector<idx_t> offsets;
+};
+
+} // namespace duckdb
@@ -22,6 +22,8 @@ struct SortConstants {
 	static constexpr idx_t MSD_RADIX_LOCATIONS = VALUES_PER_RADIX + 1;
 	static constexpr idx_t INSERTION_SORT_THRESHOLD = 24;
 	static constexpr idx_t MSD_RADIX_SORT_SIZE_THRESHOLD = 4;
+	//! The maximum number of sorted blocks that are merged at once
+	static constexpr idx_t MAX_MERGE_FAN_IN = 64;
 };
 
 struct SortLayout {
@@ -58,6 +60,10 @@ public:
 	void PrepareMergePhase();
 	//! Initializes the global sort state for another round of merging
 	void InitializeMergeRound();
+	//! The number of sorted blocks that can be merged at once, given the available memory
+	idx_t ComputeMergeFanIn();
+	//! The amount of memory that is pinned for a block of a sorted block while it is being merged
+	idx_t PinnedBytesPerBlock(const SortedBlock &sb) const;
 	//! Completes the cascaded merge sort round.
 	//! Pass true if you wish to use the radix data for further comparisons.
 	void CompleteMergeRound(bool keep_radix_data = false);
@@ -88,11 +94,15 @@ public:
 	//! Whether we are doing an external sort
 	bool external;
 
+	//! The sorted blocks are merged in groups of at most 'merge_fan_in' blocks per merge round
+	idx_t merge_fan_in;
+	//! The offsets of the groups in sorted_blocks (num_groups + 1 entries)
+	vector<idx_t> group_offsets;
 	//! Progress in merge path stage
-	idx_t pair_idx;
-	idx_t num_pairs;
-	idx_t l_start;
-	idx_t r_start;
+	idx_t group_idx;
+	idx_t num_groups;
+	//! How far each sorted block of the current group has been merged
+	vector<idx_t> run_starts;
 };
 
 struct LocalSortState {
@@ -167,6 +177,15 @@ private:
 	unique_ptr<SortedBlock> right_input;
 	SortedBlock *result;
 
+	//! Whether the current partition is a k-way merge of more than two sorted blocks
+	bool k_way;
+	//! The readers, input blocks, and remaining row counts of a k-way merge
+	vector<unique_ptr<SBScanState>> run_readers;
+	vector<unique_ptr<SortedBlock>> run_inputs;
+	vector<idx_t> run_remaining;
+	//! Loser tree of the k-way merge: entry 0 holds the winner, the internal nodes hold the losers
+	vector<idx_t> loser_tree;
+
 private:
 	//! Computes the left and right block that will be merged next (Merge Path partition)
 	void GetNextPartition();
@@ -178,6 +197,29 @@ private:
 	//! Finds the next partition and merges it
 	void MergePartition();
 
+	//! Moves on to the next group of sorted blocks (called when the current group has been partitioned entirely)
+	void AdvanceGroup();
+	//! Computes the slices of the sorted blocks in the current group that will be merged next (k-way Merge Path)
+	void GetNextKWayPartition();
+	//! Finds where the next 'count' rows of the k-way merge end in each sorted block of the current group
+	void GetKWayIntersection(idx_t count, vector<idx_t> &ends);
+	//! Compares the current rows of two readers of sorted blocks, ties are broken using the index of the sorted block
+	int CompareRuns(SBScanState &l, idx_t l_run, SBScanState &r, idx_t r_run);
+	//! Returns the first index in [lo, hi] of sorted block 'run' whose row comes after the current row of the pivot
+	idx_t FindRank(vector<unique_ptr<SBScanState>> &readers, const vector<vector<idx_t>> &block_offsets, idx_t run,
+	               idx_t lo, idx_t hi, idx_t pivot_run);
+	//! Merges the current k-way partition using a loser tree
+	void MergeKWayPartition();
+	//! Whether the current row of run 'l' comes before the current row of run 'r' in the k-way merge
+	bool KWayLess(idx_t l, idx_t r);
+	//! Initializes the loser tree, returns the winner of the subtree rooted at 'node'
+	idx_t BuildLoserTree(idx_t node);
+	//! Pins the blocks of the current row of a k-way reader
+	void PinKWayReader(SBScanState &reader);
+	//! Copies the current row of a k-way reader to the result SortedData (including its heap, if any)
+	void CopyKWayRow(SortedData &result_data, BufferHandle &data_handle, BufferHandle *heap_handle,
+	                 SortedData &source_data, SBScanState &reader);
+
 	//! Computes how the next 'count' tuples should be merged by setting the 'left_smaller' array
 	void ComputeMerge(const idx_t &count, bool left_smaller[]);
 
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/thread_metrics.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/constants.hpp"
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/winapi.hpp"
+
+namespace duckdb {
+
+//! The MemoryAccount tracks the buffer-managed memory held on behalf of an operator. A block is charged to the account
+//! that is active on the thread that loads it, and released from that same account when it is evicted, resized or
+//! destroyed, regardless of the thread that does so.
+struct MemoryAccount {
+	//! The memory currently held by the operator
+	atomic<int64_t> memory;
+	//! The highest amount of memory held by the operator
+	atomic<idx_t> peak_memory;
+
+	MemoryAccount() : memory(0), peak_memory(0) {
+	}
+
+	void Reserve(idx_t size) {
+		auto current = memory += int64_t(size);
+		if (current <= 0) {
+			return;
+		}
+		idx_t peak = peak_memory;
+		while (idx_t(current) > peak && !peak_memory.compare_exchange_weak(peak, idx_t(current))) {
+		}
+	}
+	void Release(idx_t size) {
+		memory -= int64_t(size);
+	}
+};
+
+//! The ThreadMetrics count the memory and I/O activity of the current thread. The counters are only ever touched by
+//! the thread that owns them, the OperatorProfiler attributes the difference between two snapshots to the operator
+//! that was running in between.
+struct ThreadMetrics {
+	//! The highest amount of memory held by the operator, taken from its MemoryAccount when the query finishes
+	idx_t peak_memory = 0;
+	//! The number of bytes written to temporary files when evicting blocks
+	idx_t bytes_spilled = 0;
+	//! The number of bytes read back from temporary files
+	idx_t bytes_reloaded = 0;
+	//! The number of pins of blocks that were already loaded in memory
+	idx_t pin_hits = 0;
+	//! The number of pins that had to load the block
+	idx_t pin_misses = 0;
+	//! The number of bytes read through a file system
+	idx_t bytes_read = 0;
+	//! The number of table rows that were scanned, i.e. that were not skipped using the zonemaps
+	idx_t rows_scanned = 0;
+	//! The account that blocks loaded by this thread are charged to (if any)
+	shared_ptr<MemoryAccount> memory_account;
+
+	//! Returns the metrics of the calling thread
+	DUCKDB_API static ThreadMetrics &Get();
+
+	//! Adds the activity recorded in another set of metrics
+	void Combine(const ThreadMetrics &other) {
+		peak_memory = MaxValue<idx_t>(peak_memory, other.peak_memory);
+		bytes_spilled += other.bytes_spilled;
+		bytes_reloaded += other.bytes_reloaded;
+		pin_hits += other.pin_hits;
+		pin_misses += other.pin_misses;
+		bytes_read += other.bytes_read;
+		rows_scanned += other.rows_scanned;
+	}
+};
+
+} // namespace duckdb
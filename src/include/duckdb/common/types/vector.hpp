@@ -100,6 +100,9 @@ public:
 	DUCKDB_API void Slice(const SelectionVector &sel, idx_t count);
 	//! Slice the vector, keeping the result around in a cache or potentially using the cache instead of slicing
 	DUCKDB_API void Slice(const SelectionVector &sel, idx_t count, SelCache &cache);
+	//! Turns the vector into a dictionary vector that references the first dictionary_size entries of the flat
+	//! vector dict. Unlike with Slice, the size of the dictionary is known and can be exploited by operators.
+	DUCKDB_API void Dictionary(Vector &dict, idx_t dictionary_size, const SelectionVector &sel, idx_t count);
 
 	//! Creates the data of this vector with the specified type. Any data that
 	//! is currently in the vector is destroyed.
@@ -187,11 +190,14 @@ protected:
 //! The DictionaryBuffer holds a selection vector
 class VectorChildBuffer : public VectorBuffer {
 public:
-	VectorChildBuffer(Vector vector) : VectorBuffer(VectorBufferType::VECTOR_CHILD_BUFFER), data(move(vector)) {
+	VectorChildBuffer(Vector vector)
+	    : VectorBuffer(VectorBufferType::VECTOR_CHILD_BUFFER), data(move(vector)), size(DConstants::INVALID_INDEX) {
 	}
 
 public:
 	Vector data;
+	//! The amount of entries in the child vector, or DConstants::INVALID_INDEX if it is unknown
+	idx_t size;
 };
 
 struct ConstantVector {
@@ -247,6 +253,11 @@ struct DictionaryVector {
 		D_ASSERT(vector.GetVectorType() == VectorType::DICTIONARY_VECTOR);
 		return ((VectorChildBuffer &)*vector.auxiliary).data;
 	}
+	//! The amount of entries in the dictionary, or DConstants::INVALID_INDEX if it is unknown
+	static inline idx_t DictionarySize(const Vector &vector) {
+		D_ASSERT(vector.GetVectorType() == VectorType::DICTIONARY_VECTOR);
+		return ((const VectorChildBuffer &)*vector.auxiliary).size;
+	}
 };
 
 struct FlatVector {
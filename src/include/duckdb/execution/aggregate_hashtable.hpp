@@ -166,6 +166,10 @@ private:
 	template <class ENTRY>
 	idx_t FindOrCreateGroupsInternal(DataChunk &groups, Vector &group_hashes, Vector &addresses,
 	                                 SelectionVector &new_groups);
+	//! Finds or creates the groups of a single dictionary group column, looking up every distinct dictionary entry
+	//! only once
+	idx_t FindOrCreateDictionaryGroups(DataChunk &groups, Vector &group_hashes, Vector &addresses_out,
+	                                   SelectionVector &new_groups_out);
 
 	template <class FUNC = std::function<void(idx_t, idx_t, data_ptr_t)>>
 	void PayloadApply(FUNC fun);
@@ -68,6 +68,8 @@ public:
 
 	//! Flush a thread context into the client context
 	void Flush(ThreadContext &context);
+	//! Returns the query profiler of the query that is executed
+	QueryProfiler &GetProfiler();
 
 	//! Returns the progress of the pipelines
 	bool GetPipelinesProgress(double &current_progress);
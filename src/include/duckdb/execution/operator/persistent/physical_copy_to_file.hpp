@@ -13,6 +13,8 @@
 #include "duckdb/function/copy_function.hpp"
 
 namespace duckdb {
+class CopyToBufferedBatch;
+struct CopyToSealedBatch;
 
 //! Copy the contents of a query into a table
 class PhysicalCopyToFile : public PhysicalOperator {
@@ -44,5 +46,28 @@ public:
 	bool IsSink() const override {
 		return true;
 	}
+	bool ParallelSink() const override {
+		return true;
+	}
+	//! The data is written in the order of the batch indexes, which preserves the order of an ORDER BY
+	bool RequiresBatchIndex() const override {
+		return true;
+	}
+
+private:
+	//! Whether the copy function encodes the batches in parallel, and only writes the encoded batches in order
+	bool PreparesBatches() const;
+	//! Writes an (in order) chunk through the shared local state of the copy function, or appends it to the pending
+	//! rows of a prepared unit. Full units are added to "sealed". Requires the lock of the global state.
+	void AppendChunk(ClientContext &context, GlobalSinkState &gstate, DataChunk &chunk,
+	                 vector<CopyToSealedBatch> &sealed) const;
+	//! Writes the chunks of a buffered batch with AppendChunk (requires the lock of the global state)
+	void WriteChunks(ClientContext &context, GlobalSinkState &gstate, unique_ptr<CopyToBufferedBatch> chunks,
+	                 vector<CopyToSealedBatch> &sealed) const;
+	//! Encodes the sealed units and writes them in the order of their unit index (must not hold the lock of the global
+	//! state)
+	void PrepareAndFlush(ClientContext &context, GlobalSinkState &gstate, vector<CopyToSealedBatch> &sealed) const;
+	//! Marks the current batch of the thread as completely sunk, and writes all batches that can be written
+	void FinishBatch(ClientContext &context, GlobalSinkState &gstate, LocalSinkState &lstate) const;
 };
 } // namespace duckdb
@@ -50,6 +50,9 @@ class LocalSinkState {
 public:
 	virtual ~LocalSinkState() {
 	}
+
+	//! The batch index of the chunks that are currently being sunk (only set if the sink requires a batch index)
+	idx_t batch_index = 0;
 };
 
 class GlobalSourceState {
@@ -131,6 +134,10 @@ public:
 	virtual unique_ptr<GlobalSourceState> GetGlobalSourceState(ClientContext &context) const;
 	virtual void GetData(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
 	                     LocalSourceState &lstate) const;
+	//! Returns the batch index of the chunk that was last emitted by GetData. Batch indexes increase with the position
+	//! of the data in the output of the source, which allows a sink to restore that order after a parallel scan.
+	virtual idx_t GetBatchIndex(ExecutionContext &context, DataChunk &chunk, GlobalSourceState &gstate,
+	                            LocalSourceState &lstate) const;
 
 	virtual bool IsSource() const {
 		return false;
@@ -140,6 +147,16 @@ public:
 		return false;
 	}
 
+	virtual bool SupportsBatchIndex() const {
+		return false;
+	}
+
+	//! Whether or not the order in which the source emits its data is meaningful (e.g. ORDER BY). Such a source is
+	//! only scanned in parallel if the sink restores the order using the batch index.
+	virtual bool SourceOrderMatters() const {
+		return false;
+	}
+
 public:
 	// Sink interface
 
@@ -171,6 +188,12 @@ public:
 	virtual bool SinkOrderMatters() const {
 		return false;
 	}
+
+	//! Whether or not the sink requires the batch index of its input, which it uses to process the input in the order
+	//! of the source even if the pipeline is executed in parallel
+	virtual bool RequiresBatchIndex() const {
+		return false;
+	}
 };
 
 } // namespace duckdb
@@ -12,6 +12,7 @@
 #include "duckdb/function/function.hpp"
 #include "duckdb/common/enums/compression_type.hpp"
 #include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/storage/storage_info.hpp"
 
 namespace duckdb {
@@ -20,6 +21,8 @@ class ColumnData;
 class ColumnDataCheckpointer;
 class ColumnSegment;
 class SegmentStatistics;
+struct SelectionVector;
+class TableFilter;
 
 struct ColumnFetchState;
 struct ColumnScanState;
@@ -87,6 +90,15 @@ typedef void (*compression_fetch_row_t)(ColumnSegment &segment, ColumnFetchState
                                         idx_t result_idx);
 typedef void (*compression_skip_t)(ColumnSegment &segment, ColumnScanState &state, idx_t skip_count);
 
+//===--------------------------------------------------------------------===//
+// Filter (optional)
+//===--------------------------------------------------------------------===//
+//! Evaluates a filter against the next scan_count rows of the segment without decompressing them, and without
+//! moving the scan forward. Rows that cannot pass the filter are removed from sel; rows that remain still have to be
+//! checked against the scanned data. Returns false if the filter could not be evaluated on the compressed data.
+typedef bool (*compression_filter_t)(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count,
+                                     SelectionVector &sel, idx_t &approved_tuple_count, const TableFilter &filter);
+
 //===--------------------------------------------------------------------===//
 // Append (optional)
 //===--------------------------------------------------------------------===//
@@ -110,7 +122,8 @@ public:
 	    : type(type), data_type(data_type), init_analyze(init_analyze), analyze(analyze), final_analyze(final_analyze),
 	      init_compression(init_compression), compress(compress), compress_finalize(compress_finalize),
 	      init_scan(init_scan), scan_vector(scan_vector), scan_partial(scan_partial), fetch_row(fetch_row), skip(skip),
-	      init_segment(init_segment), append(append), finalize_append(finalize_append), revert_append(revert_append) {
+	      init_segment(init_segment), append(append), finalize_append(finalize_append), revert_append(revert_append),
+	      filter(nullptr) {
 	}
 
 	//! Compression type
@@ -163,10 +176,16 @@ public:
 	compression_finalize_append_t finalize_append;
 	//! Revert append (optional)
 	compression_revert_append_t revert_append;
+
+	//! Evaluate a filter on the compressed data (optional)
+	//! this allows the scan to skip decompressing vectors in which no rows can pass the filter
+	compression_filter_t filter;
 };
 
 //! The set of compression functions
 struct CompressionFunctionSet {
+	//! Functions are loaded lazily, possibly by multiple threads checkpointing columns in parallel
+	mutex lock;
 	map<CompressionType, map<PhysicalType, CompressionFunction>> functions;
 };
 
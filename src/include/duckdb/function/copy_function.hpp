@@ -13,6 +13,7 @@
 #include "duckdb/parser/parsed_data/copy_info.hpp"
 
 namespace duckdb {
+class ChunkCollection;
 class ExecutionContext;
 
 struct LocalFunctionData {
@@ -25,6 +26,12 @@ struct GlobalFunctionData {
 	}
 };
 
+//! A batch of rows that has been encoded by the copy function, but not yet written to the file
+struct PreparedBatchData {
+	virtual ~PreparedBatchData() {
+	}
+};
+
 typedef unique_ptr<FunctionData> (*copy_to_bind_t)(ClientContext &context, CopyInfo &info, vector<string> &names,
                                                    vector<LogicalType> &sql_types);
 typedef unique_ptr<LocalFunctionData> (*copy_to_initialize_local_t)(ClientContext &context, FunctionData &bind_data);
@@ -35,6 +42,15 @@ typedef void (*copy_to_sink_t)(ClientContext &context, FunctionData &bind_data,
 typedef void (*copy_to_combine_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
                                   LocalFunctionData &lstate);
 typedef void (*copy_to_finalize_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate);
+//! Encodes a batch of rows, without writing to the file. Called concurrently from multiple threads.
+typedef unique_ptr<PreparedBatchData> (*copy_to_prepare_batch_t)(ClientContext &context, FunctionData &bind_data,
+                                                                 GlobalFunctionData &gstate,
+                                                                 ChunkCollection &collection);
+//! Writes an encoded batch to the file. Called for one batch at a time, in the order of the batches.
+typedef void (*copy_to_flush_batch_t)(ClientContext &context, FunctionData &bind_data, GlobalFunctionData &gstate,
+                                      PreparedBatchData &batch);
+//! The number of rows the copy function prefers to encode as one batch (e.g. the row group size of Parquet)
+typedef idx_t (*copy_to_desired_batch_size_t)(ClientContext &context, FunctionData &bind_data);
 
 typedef unique_ptr<FunctionData> (*copy_from_bind_t)(ClientContext &context, CopyInfo &info,
                                                      vector<string> &expected_names,
@@ -44,7 +60,8 @@ class CopyFunction : public Function {
 public:
 	explicit CopyFunction(string name)
 	    : Function(name), copy_to_bind(nullptr), copy_to_initialize_local(nullptr), copy_to_initialize_global(nullptr),
-	      copy_to_sink(nullptr), copy_to_combine(nullptr), copy_to_finalize(nullptr), copy_from_bind(nullptr) {
+	      copy_to_sink(nullptr), copy_to_combine(nullptr), copy_to_finalize(nullptr), copy_to_prepare_batch(nullptr),
+	      copy_to_flush_batch(nullptr), copy_to_desired_batch_size(nullptr), copy_from_bind(nullptr) {
 	}
 
 	copy_to_bind_t copy_to_bind;
@@ -53,6 +70,11 @@ public:
 	copy_to_sink_t copy_to_sink;
 	copy_to_combine_t copy_to_combine;
 	copy_to_finalize_t copy_to_finalize;
+	//! Optional: if both are set, the batches of an ordered COPY are encoded in parallel and only written in order
+	copy_to_prepare_batch_t copy_to_prepare_batch;
+	copy_to_flush_batch_t copy_to_flush_batch;
+	//! Optional: defaults to the row group size of the storage
+	copy_to_desired_batch_size_t copy_to_desired_batch_size;
 
 	copy_from_bind_t copy_from_bind;
 	TableFunction copy_from_function;
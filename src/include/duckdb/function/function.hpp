@@ -132,6 +132,15 @@ public:
 	DUCKDB_API bool HasNamedParameters();
 };
 
+//! Whether the result of a scalar function only depends on its arguments
+enum class FunctionStability : uint8_t {
+	//! The function always returns the same result for the same arguments
+	CONSISTENT,
+	//! The result also depends on the time, the session or the transaction (e.g. NOW()): it is the same within a
+	//! query, but not across queries
+	CONSISTENT_WITHIN_QUERY
+};
+
 class BaseScalarFunction : public SimpleFunction {
 public:
 	DUCKDB_API BaseScalarFunction(string name, vector<LogicalType> arguments, LogicalType return_type,
@@ -144,6 +153,9 @@ public:
 	//! Whether or not the function has side effects (e.g. sequence increments, random() functions, NOW()). Functions
 	//! with side-effects cannot be constant-folded.
 	bool has_side_effects;
+	//! Whether the result only depends on the arguments. Functions whose result depends on the query they run in can
+	//! be constant-folded, but their result cannot be reused by other queries.
+	FunctionStability stability;
 	//! Whether or not the function propagates null values
 	bool propagates_null_values;
 
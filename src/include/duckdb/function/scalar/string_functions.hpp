@@ -149,6 +149,13 @@ struct TrimFun {
 
 struct ContainsFun {
 	static ScalarFunction GetFunction();
+	//! Returns the (internal) function that checks whether a string contains any of a set of constant needles
+	//! The needles are searched for through the bind data created by BindNeedles, and are also passed as constant
+	//! arguments after the string so that they show up when the expression is printed
+	static ScalarFunction GetAnyFunction();
+	static unique_ptr<FunctionData> BindNeedles(vector<string> needles);
+	//! Returns the needles of the bind data created by BindNeedles
+	static const vector<string> &GetNeedles(const FunctionData &bind_data);
 	static void RegisterFunction(BuiltinFunctions &set);
 	static idx_t Find(const string_t &haystack, const string_t &needle);
 	static idx_t Find(const unsigned char *haystack, idx_t haystack_size, const unsigned char *needle,
@@ -27,6 +27,8 @@ struct ClientConfig {
 	//! The file to save query profiling information to, instead of printing it to the console
 	//! (empty = print to console)
 	string profiler_save_location;
+	//! If the query profiler collects hardware performance counters per operator (if supported by the system)
+	bool enable_hardware_counters = false;
 
 	//! If the progress bar is enabled or not.
 	bool enable_progress_bar = false;
@@ -52,6 +54,8 @@ struct ClientConfig {
 	//! Maximum bits allowed for using a perfect hash table (i.e. the perfect HT can hold up to 2^perfect_ht_threshold
 	//! elements)
 	idx_t perfect_ht_threshold = 12;
+	//! The relative share of the worker threads that queries of this connection receive when other queries are running
+	idx_t task_priority = 10;
 
 	//! The explain output type used when none is specified (default: PHYSICAL_ONLY)
 	ExplainOutputType explain_output_type = ExplainOutputType::PHYSICAL_ONLY;
@@ -92,6 +92,9 @@ public:
 	idx_t maximum_threads = (idx_t)-1;
 	//! The number of external threads that work on DuckDB tasks. Default: none.
 	idx_t external_threads = 0;
+	//! The NUMA nodes the threads are pinned to: 0 disables NUMA mode, -1 detects the topology of the machine and
+	//! N > 0 simulates N nodes. Default: disabled.
+	int64_t numa_nodes = 0;
 	//! Whether or not to create and use a temporary directory to store intermediates that do not fit in memory
 	bool use_temporary_directory = true;
 	//! Directory to store temporary structures that do not fit in memory
@@ -106,6 +109,12 @@ public:
 	bool enable_external_access = true;
 	//! Whether or not object cache is used
 	bool object_cache_enable = false;
+	//! The maximum amount of plans kept in the prepared statement cache, shared by all connections (default: 0,
+	//! disabled)
+	idx_t prepared_statement_cache_size = 0;
+	//! The maximum amount of memory used to cache the results of read-only queries, shared by all connections
+	//! (default: 0, disabled)
+	idx_t result_cache_size = 0;
 	//! Force checkpoint when CHECKPOINT is called or on shutdown, even if no changes have been made
 	bool force_checkpoint = false;
 	//! Run a checkpoint on successful shutdown and delete the WAL, to leave only a single database file behind
@@ -121,6 +130,16 @@ public:
 	set<OptimizerType> disabled_optimizers;
 	//! Force a specific compression method to be used when checkpointing (if available)
 	CompressionType force_compression = CompressionType::COMPRESSION_AUTO;
+	//! The fraction of the vectors of a column that is analyzed to choose its compression method when checkpointing
+	double compression_sample_rate = 1.0;
+	//! The relative margin by which the best compression method must win on the sample; if it wins by less, all
+	//! vectors are analyzed
+	double compression_confidence_threshold = 0.1;
+	//! Whether to reuse the compression method that was chosen for the previous row group of the same column
+	bool compression_reuse_choice = false;
+	//! Whether to store the statistics of every vector of a column when checkpointing, which table scans use to skip
+	//! vectors
+	bool vector_statistics = true;
 	//! Debug flag that adds additional (unnecessary) free_list blocks to the storage
 	bool debug_many_free_list_blocks = false;
 	//! Debug setting for window aggregation mode: (window, combine, separate)
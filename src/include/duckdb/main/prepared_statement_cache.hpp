@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/prepared_statement_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <list>
+
+namespace duckdb {
+class ClientContext;
+class DatabaseInstance;
+class PreparedStatementData;
+
+//! The PreparedStatementCache keeps the plans of statements prepared through ClientContext::Prepare, so that any
+//! connection preparing the same query again can skip parsing, binding, optimizing and physical planning.
+//! Plans are keyed by the normalized query text and the client settings that influence planning. A plan is handed
+//! out to a single prepared statement at a time, and is returned to the cache when that prepared statement is
+//! destroyed. Plans that were bound before the last catalog change are discarded.
+class PreparedStatementCache {
+public:
+	explicit PreparedStatementCache(DatabaseInstance &db);
+
+	//! Takes a cached plan for the key out of the cache, if there is one that was bound at the current catalog version
+	shared_ptr<PreparedStatementData> Take(const string &key, idx_t current_version);
+	//! Returns the plan of a prepared statement that is being destroyed to the cache
+	void Return(shared_ptr<PreparedStatementData> data, idx_t current_version);
+	//! Removes all plans from the cache
+	void Clear();
+	//! Returns the amount of plans in the cache
+	idx_t Count();
+
+	//! Returns the cache key of the query for the given client, or an empty string if the plan cannot be shared
+	static string GetCacheKey(ClientContext &context, const string &query);
+	//! Returns the fingerprint of the plan of a query: the normalized query and the client settings that influence
+	//! binding and planning. Returns an empty string if the query cannot be normalized safely.
+	static string GetPlanFingerprint(ClientContext &context, const string &query);
+	//! Collapses all whitespace and removes the comments of a query, outside of string literals and quoted
+	//! identifiers. Returns an empty string if the query contains constructs that are not normalized safely.
+	static string NormalizeQuery(const string &query);
+	//! Whether or not the client has (possibly uncommitted) temporary objects. Requires an active transaction.
+	static bool HasTemporaryObjects(ClientContext &context);
+
+	static PreparedStatementCache &Get(ClientContext &context);
+
+private:
+	struct CacheEntry {
+		//! The idle plans of the query
+		vector<shared_ptr<PreparedStatementData>> plans;
+		//! The position of the key in the LRU list
+		std::list<string>::iterator lru_position;
+	};
+
+	//! Removes all plans from the cache if the catalog was modified since they were added
+	void InvalidateIfStale(idx_t current_version);
+	//! Removes a key and all its plans from the cache
+	void EraseEntry(unordered_map<string, CacheEntry>::iterator entry);
+
+	DatabaseInstance &db;
+	mutex cache_lock;
+	//! The catalog version at which the cached plans were bound
+	idx_t catalog_version;
+	//! The cached plans by key
+	unordered_map<string, CacheEntry> entries;
+	//! The keys in order of use, most recently used first
+	std::list<string> lru;
+	//! The total amount of plans in the cache
+	idx_t plan_count;
+};
+
+} // namespace duckdb
@@ -18,6 +18,7 @@ namespace duckdb {
 class CatalogEntry;
 class PhysicalOperator;
 class SQLStatement;
+struct ResultCacheDependencies;
 
 class PreparedStatementData {
 public:
@@ -50,6 +51,10 @@ public:
 	//! The catalog version of when the prepared statement was bound
 	//! If this version is lower than the current catalog version, we have to rebind the prepared statement
 	idx_t catalog_version;
+	//! The key of the plan in the prepared statement cache, or empty if the plan is not shared between connections
+	string cache_key;
+	//! The tables that the result of the statement depends on, or nullptr if the result cannot be cached
+	unique_ptr<ResultCacheDependencies> result_dependencies;
 
 public:
 	//! Bind a set of values to the prepared statement data
@@ -8,10 +8,14 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/enums/profiler_format.hpp"
+#include "duckdb/common/hardware_counters.hpp"
 #include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/thread_metrics.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/winapi.hpp"
@@ -25,6 +29,7 @@ namespace duckdb {
 class ClientContext;
 class ExpressionExecutor;
 class PhysicalOperator;
+class QueryProfiler;
 class SQLStatement;
 
 //! The ExpressionInfo keeps information related to an expression
@@ -88,17 +93,40 @@ struct OperatorInformation {
 
 	double time = 0;
 	idx_t elements = 0;
+	//! The memory and I/O activity of the operator
+	ThreadMetrics metrics;
+	//! The hardware performance counters of the operator (if collected)
+	HardwareCounterValues hardware_counters;
 	string name;
 	//! A vector of Expression Executor Info
 	vector<unique_ptr<ExpressionExecutorInfo>> executors_info;
 };
 
+//! The TraceEvent is an entry in the execution timeline of a query, in the Chrome trace-event format
+struct TraceEvent {
+	//! The name of the traced task or event
+	string name;
+	//! The category of the entry ("query", "task" or "event")
+	const char *category;
+	//! The phase of the entry: 'X' is a complete span, 'b' and 'e' begin and end an asynchronous span
+	char phase;
+	//! The time in microseconds since the start of the query
+	int64_t timestamp;
+	//! The duration in microseconds (for complete spans)
+	int64_t duration;
+	//! The identifier of the thread that recorded the entry
+	idx_t thread_id;
+	//! The identifier that links the begin and end of an asynchronous span
+	idx_t span_id;
+};
+
 //! The OperatorProfiler measures timings of individual operators
 class OperatorProfiler {
 	friend class QueryProfiler;
 
 public:
-	DUCKDB_API explicit OperatorProfiler(bool enabled);
+	DUCKDB_API explicit OperatorProfiler(bool enabled, bool hardware_counters = false,
+	                                     QueryProfiler *query_profiler = nullptr);
 
 	DUCKDB_API void StartOperator(const PhysicalOperator *phys_op);
 	DUCKDB_API void EndOperator(DataChunk *chunk);
@@ -109,14 +137,23 @@ public:
 	}
 
 private:
-	void AddTiming(const PhysicalOperator *op, double time, idx_t elements);
+	void AddTiming(const PhysicalOperator *op, double time, idx_t elements, const ThreadMetrics &metrics,
+	               const HardwareCounterValues &counters);
 
 	//! Whether or not the profiler is enabled
 	bool enabled;
+	//! Whether or not the hardware performance counters are collected
+	bool hardware_counters;
+	//! The query profiler that holds the memory accounts of the operators (if any)
+	QueryProfiler *query_profiler;
 	//! The timer used to time the execution time of the individual Physical Operators
 	Profiler op;
 	//! The stack of Physical Operators that are currently active
 	const PhysicalOperator *active_operator;
+	//! The metrics of this thread when the active operator was started
+	ThreadMetrics start_metrics;
+	//! The hardware performance counters of this thread when the active operator was started
+	HardwareCounterValues start_counters;
 	//! A mapping of physical operators to recorded timings
 	unordered_map<const PhysicalOperator *, OperatorInformation> timings;
 };
@@ -132,6 +169,8 @@ public:
 		string name;
 		string extra_info;
 		OperatorInformation info;
+		//! The buffer-managed memory held on behalf of the operator
+		shared_ptr<MemoryAccount> memory_account;
 		vector<unique_ptr<TreeNode>> children;
 		idx_t depth = 0;
 	};
@@ -148,6 +187,8 @@ private:
 public:
 	DUCKDB_API bool IsEnabled() const;
 	DUCKDB_API bool IsDetailedEnabled() const;
+	//! Whether or not hardware performance counters are collected for the current query
+	DUCKDB_API bool HardwareCountersEnabled() const;
 	DUCKDB_API ProfilerPrintFormat GetPrintFormat() const;
 	DUCKDB_API string GetSaveLocation() const;
 
@@ -160,6 +201,8 @@ public:
 
 	//! Adds the timings gathered by an OperatorProfiler to this query profiler
 	DUCKDB_API void Flush(OperatorProfiler &profiler);
+	//! Returns the memory account of an operator of the running query, the tree is not modified while it runs
+	shared_ptr<MemoryAccount> GetMemoryAccount(const PhysicalOperator *op) const;
 
 	DUCKDB_API void StartPhase(string phase);
 	DUCKDB_API void EndPhase();
@@ -171,19 +214,31 @@ public:
 	DUCKDB_API void Print();
 
 	DUCKDB_API string ToJSON() const;
+	DUCKDB_API string ToChromeTrace() const;
 	DUCKDB_API void WriteToFile(const char *path, string &info) const;
 
 	idx_t OperatorSize() {
 		return tree_map.size();
 	}
 
+	//! Whether or not the execution of the query is recorded in a trace
+	bool IsTracing() const {
+		return running && tracing;
+	}
+	//! Returns the time in microseconds since the start of the query
+	int64_t TraceTimestamp() const;
+	//! Adds a span of work that ran on the calling thread since start to the trace
+	void TraceSpan(string name, const char *category, int64_t start);
+	//! Adds the begin or end of an asynchronous span to the trace, the span can begin and end on different threads
+	void TraceAsync(string name, const char *category, bool begin, idx_t span_id);
+
 	void Finalize(TreeNode &node);
 
 private:
 	ClientContext &context;
 
-	//! Whether or not the query profiler is running
-	bool running;
+	//! Whether or not the query profiler is running, this is checked by the threads that flush into the profiler
+	atomic<bool> running;
 	//! The lock used for flushing information from a thread into the global query profiler
 	mutex flush_lock;
 
@@ -200,6 +255,16 @@ private:
 	TreeMap tree_map;
 	//! Whether or not we are running as part of a explain_analyze query
 	bool is_explain_analyze;
+	//! Whether or not the execution of the query is traced
+	bool tracing;
+	//! Whether or not hardware performance counters are collected for the query
+	bool hardware_counters;
+	//! The lock protecting the trace of the query
+	mutex trace_lock;
+	//! The entries in the execution trace of the query
+	vector<TraceEvent> trace_events;
+	//! The mapping of threads to the identifiers used in the trace
+	unordered_map<std::thread::id, idx_t> trace_threads;
 
 public:
 	const TreeMap &GetTreeMap() const {
@@ -218,6 +283,8 @@ private:
 
 private:
 	vector<PhaseTimingItem> GetOrderedPhaseTimings() const;
+	//! Adds an entry to the trace, recording the calling thread
+	void AddTraceEvent(TraceEvent event);
 
 	//! Check whether or not an operator type requires query profiling. If none of the ops in a query require profiling
 	//! no profiling information is output.
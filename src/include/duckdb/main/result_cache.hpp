@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/result_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/enums/statement_type.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <list>
+
+namespace duckdb {
+class BlockHandle;
+class ClientContext;
+class DatabaseInstance;
+class LogicalOperator;
+class MaterializedQueryResult;
+struct DataTableInfo;
+
+//! The tables that the result of a query depends on, and the commits of those tables that the result reflects
+struct ResultCacheDependencies {
+	//! The catalog version that the query was bound at
+	idx_t catalog_version;
+	//! The tables that are scanned by the query
+	vector<shared_ptr<DataTableInfo>> tables;
+	//! The id of the last commit that changed each of the tables
+	vector<transaction_t> commit_ids;
+};
+
+//! The ResultCache keeps the results of read-only queries whose result only depends on the contents of the tables
+//! they scan. A repeated query is answered from the cache as long as none of these tables were changed by a commit.
+//! The results are serialized into buffers of the buffer manager, which destroys them when it needs the memory.
+class ResultCache {
+public:
+	explicit ResultCache(DatabaseInstance &db);
+	~ResultCache();
+
+	//! Looks up the result of a query for the current transaction of the client. The transaction must be able to use
+	//! the cache.
+	unique_ptr<MaterializedQueryResult> Lookup(ClientContext &context, const string &key);
+	//! Adds the result of a query to the cache, unless the tables it depends on were changed while it was running
+	void Insert(const string &key, const ResultCacheDependencies &dependencies, MaterializedQueryResult &result);
+	//! Removes all results from the cache
+	void Clear();
+	//! Returns the amount of results in the cache
+	idx_t Count();
+	//! Returns the serialized size of the results in the cache
+	idx_t CachedBytes();
+
+	//! Returns the cache key of the query for the given client, or an empty string if results are not cached
+	static string GetCacheKey(ClientContext &context, const string &query);
+	//! Returns whether the current transaction of the client sees the same tables as the cached results
+	static bool CanUseCache(ClientContext &context);
+	//! Returns the dependencies of a bound (unoptimized) plan, or nullptr if the result of the plan cannot be cached
+	//! because it does not only depend on the contents of the tables it scans. Requires an active transaction that
+	//! can use the cache.
+	static unique_ptr<ResultCacheDependencies> GetDependencies(ClientContext &context, LogicalOperator &plan);
+
+	static ResultCache &Get(ClientContext &context);
+
+private:
+	struct CachedResult {
+		ResultCacheDependencies dependencies;
+		StatementType statement_type;
+		vector<LogicalType> types;
+		vector<string> names;
+		//! The buffer holding the serialized result, and the location of the result within the buffer
+		shared_ptr<BlockHandle> block;
+		idx_t offset;
+		idx_t size;
+		//! The position of the key in the LRU list
+		std::list<string>::iterator lru_position;
+	};
+
+	//! Removes all results from the cache if the catalog was modified since they were added
+	void InvalidateIfStale(idx_t current_version);
+	//! Removes a result from the cache
+	void EraseEntry(unordered_map<string, CachedResult>::iterator entry);
+	//! Writes a serialized result into a buffer
+	void WriteResult(data_ptr_t data, idx_t size, shared_ptr<BlockHandle> &block, idx_t &offset);
+
+	DatabaseInstance &db;
+	mutex cache_lock;
+	//! The catalog version that the cached results were bound at
+	idx_t catalog_version;
+	//! The cached results by key
+	unordered_map<string, CachedResult> entries;
+	//! The keys in order of use, most recently used first
+	std::list<string> lru;
+	//! The serialized size of all cached results
+	idx_t cached_bytes;
+	//! The buffer that small results are currently written to, and the amount of bytes of it that is used
+	shared_ptr<BlockHandle> current_page;
+	idx_t page_offset;
+};
+
+} // namespace duckdb
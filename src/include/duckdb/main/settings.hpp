@@ -33,6 +33,34 @@ struct CheckpointThresholdSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct CompressionConfidenceThresholdSetting {
+	static constexpr const char *Name = "compression_confidence_threshold";
+	static constexpr const char *Description =
+	    "The relative margin by which the best compression method must win on the sampled vectors, otherwise all "
+	    "vectors are analyzed (default: 0.1)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct CompressionReuseChoiceSetting {
+	static constexpr const char *Name = "compression_reuse_choice";
+	static constexpr const char *Description =
+	    "Whether to reuse the compression method chosen for the previous row group of a column when checkpointing";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
+struct CompressionSampleRateSetting {
+	static constexpr const char *Name = "compression_sample_rate";
+	static constexpr const char *Description =
+	    "The fraction of vectors analyzed to choose the compression method of a column when checkpointing (default: 1)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::DOUBLE;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct DebugCheckpointAbort {
 	static constexpr const char *Name = "debug_checkpoint_abort";
 	static constexpr const char *Description =
@@ -121,7 +149,7 @@ struct EnableObjectCacheSetting {
 struct EnableProfilingSetting {
 	static constexpr const char *Name = "enable_profiling";
 	static constexpr const char *Description =
-	    "Enables profiling, and sets the output format (JSON, QUERY_TREE, QUERY_TREE_OPTIMIZER)";
+	    "Enables profiling, and sets the output format (JSON, QUERY_TREE, QUERY_TREE_OPTIMIZER, CHROME_TRACE)";
 	static constexpr const LogicalTypeId InputType = LogicalTypeId::VARCHAR;
 	static void SetLocal(ClientContext &context, const Value &parameter);
 	static Value GetSetting(ClientContext &context);
@@ -177,6 +205,16 @@ struct MaximumMemorySetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct NumaNodesSetting {
+	static constexpr const char *Name = "numa_nodes";
+	static constexpr const char *Description =
+	    "The NUMA nodes worker threads are pinned to: 0 disables NUMA mode, -1 detects the topology of the machine and "
+	    "N > 0 simulates N nodes (default: 0)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct PerfectHashThresholdSetting {
 	static constexpr const char *Name = "perfect_ht_threshold";
 	static constexpr const char *Description = "Threshold in bytes for when to use a perfect hash table (default: 12)";
@@ -185,6 +223,16 @@ struct PerfectHashThresholdSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct PreparedStatementCacheSizeSetting {
+	static constexpr const char *Name = "prepared_statement_cache_size";
+	static constexpr const char *Description =
+	    "The maximum amount of plans of prepared statements that are shared between connections preparing the same "
+	    "query (default: 0, disabled)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct PreserveIdentifierCase {
 	static constexpr const char *Name = "preserve_identifier_case";
 	static constexpr const char *Description =
@@ -194,6 +242,16 @@ struct PreserveIdentifierCase {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct ProfilerHardwareCountersSetting {
+	static constexpr const char *Name = "profiler_hardware_counters";
+	static constexpr const char *Description =
+	    "Whether or not the profiler collects hardware performance counters (cycles, instructions, cache, branch and "
+	    "TLB misses) per operator, if supported by the system";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct ProfilerHistorySize {
 	static constexpr const char *Name = "profiler_history_size";
 	static constexpr const char *Description = "Sets the profiler history size";
@@ -228,6 +286,16 @@ struct ProgressBarTimeSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct ResultCacheSizeSetting {
+	static constexpr const char *Name = "result_cache_size";
+	static constexpr const char *Description =
+	    "The maximum amount of memory used to cache the results of repeated read-only queries, e.g. 1GB (default: 0, "
+	    "disabled)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::VARCHAR;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct SchemaSetting {
 	static constexpr const char *Name = "schema";
 	static constexpr const char *Description =
@@ -246,6 +314,16 @@ struct SearchPathSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct TaskPrioritySetting {
+	static constexpr const char *Name = "task_priority";
+	static constexpr const char *Description =
+	    "The relative share of the worker threads that queries of this connection receive while other queries are "
+	    "running (1-100, default: 10)";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BIGINT;
+	static void SetLocal(ClientContext &context, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 struct TempDirectorySetting {
 	static constexpr const char *Name = "temp_directory";
 	static constexpr const char *Description = "Set the directory to which to write temp files";
@@ -262,4 +340,13 @@ struct ThreadsSetting {
 	static Value GetSetting(ClientContext &context);
 };
 
+struct VectorStatisticsSetting {
+	static constexpr const char *Name = "vector_statistics";
+	static constexpr const char *Description =
+	    "Whether to store the min/max statistics of every vector when checkpointing, which lets table scans skip vectors";
+	static constexpr const LogicalTypeId InputType = LogicalTypeId::BOOLEAN;
+	static void SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &parameter);
+	static Value GetSetting(ClientContext &context);
+};
+
 } // namespace duckdb
@@ -0,0 +1,26 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/optimizer/rule/contains_disjunction.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/optimizer/rule.hpp"
+
+namespace duckdb {
+
+// The Contains Disjunction rule fuses a disjunction of CONTAINS calls with constant needles on the same string into a
+// single multi-needle search (e.g. CONTAINS(x, 'a') OR CONTAINS(x, 'b') => CONTAINS_ANY(x) with needles ['a', 'b'])
+// LIKE '%a%' is rewritten to CONTAINS by the LikeOptimizationRule, so this also applies to disjunctions of LIKE
+class ContainsDisjunctionRule : public Rule {
+public:
+	explicit ContainsDisjunctionRule(ExpressionRewriter &rewriter);
+
+	unique_ptr<Expression> Apply(LogicalOperator &op, vector<Expression *> &bindings, bool &changes_made,
+	                             bool is_root) override;
+};
+
+} // namespace duckdb
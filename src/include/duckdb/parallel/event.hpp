@@ -47,6 +47,13 @@ public:
 		return finished;
 	}
 
+	//! Returns the name of the event in the execution trace
+	virtual string GetName() const {
+		return "Event";
+	}
+	//! Records the start of the event in the execution trace (if the query is traced)
+	void TraceStart();
+
 protected:
 	Executor &executor;
 	//! The current threads working on the event
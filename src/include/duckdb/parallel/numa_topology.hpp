@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/parallel/numa_topology.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+//! The NUMA nodes of the machine and the CPUs that belong to them
+struct NumaTopology {
+	//! The CPUs of every node
+	vector<vector<idx_t>> nodes;
+
+	idx_t NodeCount() const {
+		return nodes.size();
+	}
+
+	//! A single node with all CPUs of the machine, i.e. NUMA-awareness disabled
+	static NumaTopology SingleNode();
+	//! Reads the topology of the machine from /sys/devices/system/node (Linux only), falls back to a single node
+	static NumaTopology Detect();
+	//! Splits the CPUs of the machine evenly over node_count simulated nodes, e.g. to test NUMA mode on a single node
+	static NumaTopology Simulate(idx_t node_count);
+	//! Creates the topology for the numa_nodes setting: 0 disables, -1 detects the topology, N > 0 simulates N nodes
+	static NumaTopology FromSetting(int64_t numa_nodes);
+
+	//! Parses a Linux CPU list, e.g. "0-3,8-11"
+	static vector<idx_t> ParseCPUList(const string &cpu_list);
+	//! Restricts the calling thread to the CPUs of the given node, returns false if this is not supported
+	bool PinCurrentThread(idx_t node) const;
+};
+
+} // namespace duckdb
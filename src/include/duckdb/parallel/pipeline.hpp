@@ -46,6 +46,8 @@ public:
 
 	string ToString() const;
 	void Print() const;
+	//! Returns a short description of the pipeline (its source and sink), as shown in the execution trace
+	string GetName() const;
 
 	//! Returns query progress
 	bool GetProgress(double &current_percentage);
@@ -22,6 +22,7 @@ public:
 public:
 	void Schedule() override;
 	void FinalizeFinish() override;
+	string GetName() const override;
 };
 
 } // namespace duckdb
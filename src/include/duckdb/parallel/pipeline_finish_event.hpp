@@ -24,6 +24,7 @@ public:
 public:
 	void Schedule() override;
 	void FinishEvent() override;
+	string GetName() const override;
 };
 
 } // namespace duckdb
@@ -44,6 +44,13 @@ public:
 public:
 	virtual TaskExecutionResult ExecuteTask(TaskExecutionMode mode) = 0;
 	TaskExecutionResult Execute(TaskExecutionMode mode) override;
+	//! Returns the name of the task in the execution trace
+	virtual string GetName() const {
+		return "Task";
+	}
+
+private:
+	TaskExecutionResult ExecuteInternal(TaskExecutionMode mode);
 };
 
 } // namespace duckdb
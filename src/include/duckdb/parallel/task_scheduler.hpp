@@ -13,6 +13,7 @@
 #include "duckdb/common/vector.hpp"
 #include "duckdb/parallel/task.hpp"
 #include "duckdb/common/atomic.hpp"
+#include "duckdb/parallel/numa_topology.hpp"
 
 namespace duckdb {
 
@@ -25,33 +26,48 @@ class TaskScheduler;
 struct SchedulerThread;
 
 struct ProducerToken {
-	ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerToken> token);
+	ProducerToken(TaskScheduler &scheduler, shared_ptr<QueueProducerToken> token);
 	~ProducerToken();
 
 	TaskScheduler &scheduler;
-	unique_ptr<QueueProducerToken> token;
-	mutex producer_lock;
+	//! The queue and the scheduling state of the producer. Worker threads can hold on to it while they look for a
+	//! task, so it can outlive the ProducerToken.
+	shared_ptr<QueueProducerToken> token;
 };
 
 //! The TaskScheduler is responsible for managing tasks and threads
+//! Every producer (i.e. every running query) has its own queue. Worker threads pick tasks from the producers in
+//! weighted round-robin order (stride scheduling): the producer with the lowest virtual time goes first, and the
+//! virtual time of a producer advances inversely proportional to its priority. A long-running query therefore cannot
+//! starve the queries of other connections, and a connection can raise or lower its share with "task_priority".
+//! In NUMA mode ("numa_nodes"), the worker threads are pinned to the CPUs of a node and every producer gets a home node:
+//! workers take the tasks of the producers of their own node first, and only then steal work from other nodes.
 class TaskScheduler {
 	// timeout for semaphore wait, default 5ms
 	constexpr static int64_t TASK_TIMEOUT_USECS = 5000;
 
 public:
+	//! The priority of a producer if none is specified
+	constexpr static idx_t DEFAULT_PRIORITY = 10;
+	//! The maximum priority of a producer
+	constexpr static idx_t MAXIMUM_PRIORITY = 100;
+	//! The virtual time a producer with priority 1 is charged for a task
+	constexpr static idx_t STRIDE = 1 << 20;
+
 	TaskScheduler(DatabaseInstance &db);
 	~TaskScheduler();
 
 	static TaskScheduler &GetScheduler(ClientContext &context);
 	static TaskScheduler &GetScheduler(DatabaseInstance &db);
 
-	unique_ptr<ProducerToken> CreateProducer();
+	unique_ptr<ProducerToken> CreateProducer(idx_t priority = DEFAULT_PRIORITY);
 	//! Schedule a task to be executed by the task scheduler
 	void ScheduleTask(ProducerToken &producer, unique_ptr<Task> task);
 	//! Fetches a task from a specific producer, returns true if successful or false if no tasks were available
 	bool GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task);
 	//! Run tasks forever until "marker" is set to false, "marker" must remain valid until the thread is joined
-	void ExecuteForever(atomic<bool> *marker);
+	//! Tasks of producers whose home node is "numa_node" are preferred
+	void ExecuteForever(atomic<bool> *marker, idx_t numa_node = 0);
 	//! Run tasks until `max_tasks` have been completed, or until there are no more tasks available
 	void ExecuteTasks(idx_t max_tasks);
 
@@ -60,9 +76,18 @@ public:
 	void SetThreads(int32_t n);
 	//! Returns the number of threads
 	int32_t NumberOfThreads();
+	//! Sets the NUMA topology that threads are pinned to: 0 disables NUMA mode, -1 detects the topology of the machine
+	//! and N > 0 simulates N nodes. The background threads are restarted.
+	void SetNumaNodes(int64_t numa_nodes);
+	//! Returns the number of NUMA nodes the threads are spread over (1 if NUMA mode is disabled)
+	idx_t NumaNodeCount();
 
 private:
+	friend struct ProducerToken;
+
 	void SetThreadsInternal(int32_t n);
+	//! Removes a producer from the set of producers that tasks are scheduled from
+	void RemoveProducer(ProducerToken &token);
 
 private:
 	DatabaseInstance &db;
@@ -72,6 +97,13 @@ private:
 	vector<unique_ptr<SchedulerThread>> threads;
 	//! Markers used by the various threads, if the markers are set to "false" the thread execution is stopped
 	vector<unique_ptr<atomic<bool>>> markers;
+	//! The NUMA topology the background threads are spread over. It is never modified: SetNumaNodes replaces it, and
+	//! the background threads keep a reference to the topology they were started with.
+	shared_ptr<const NumaTopology> topology;
+	//! Protects the topology pointer
+	mutex topology_lock;
+	//! Producers are assigned their home node in round-robin order
+	atomic<idx_t> next_producer_node;
 };
 
 } // namespace duckdb
@@ -13,7 +13,24 @@
 namespace duckdb {
 
 struct VacuumInfo : public ParseInfo {
-	// nothing for now
+	//! Whether or not the statement is a VACUUM; a plain ANALYZE is a no-op
+	bool vacuum = true;
+	//! Whether or not a single table is vacuumed; if not all tables of the database are vacuumed
+	bool has_table = false;
+	//! The schema of the table to vacuum
+	string schema;
+	//! The name of the table to vacuum
+	string table;
+
+public:
+	unique_ptr<VacuumInfo> Copy() const {
+		auto result = make_unique<VacuumInfo>();
+		result->vacuum = vacuum;
+		result->has_table = has_table;
+		result->schema = schema;
+		result->table = table;
+		return result;
+	}
 };
 
 } // namespace duckdb
@@ -21,7 +21,7 @@ public:
 	unique_ptr<VacuumInfo> info;
 
 protected:
-	VacuumStatement(const VacuumStatement &other) : SQLStatement(other) {};
+	VacuumStatement(const VacuumStatement &other) : SQLStatement(other), info(other.info->Copy()) {};
 
 public:
 	unique_ptr<SQLStatement> Copy() const override;
@@ -18,6 +18,7 @@ class BufferHandle;
 class BufferManager;
 class DatabaseInstance;
 class FileBuffer;
+struct MemoryAccount;
 
 enum class BlockState : uint8_t { BLOCK_UNLOADED = 0, BLOCK_LOADED = 1 };
 
@@ -64,6 +65,8 @@ private:
 	const bool can_destroy;
 	//! The memory usage of the block
 	idx_t memory_usage;
+	//! The account the memory of the loaded block is charged to (if any)
+	shared_ptr<MemoryAccount> memory_account;
 };
 
 } // namespace duckdb
@@ -51,6 +51,7 @@ public:
 	//! Reallocate an in-memory buffer that is pinned.
 	void ReAllocate(shared_ptr<BlockHandle> &handle, idx_t block_size);
 
+	//! Pins a block. Returns nullptr if the block was a buffer that was destroyed when it was evicted.
 	unique_ptr<BufferHandle> Pin(shared_ptr<BlockHandle> &handle);
 	void Unpin(shared_ptr<BlockHandle> &handle);
 
@@ -69,6 +70,26 @@ public:
 	idx_t GetMaxMemory() {
 		return maximum_memory;
 	}
+	//! Returns the highest amount of memory used since the creation of the buffer manager or the last call to
+	//! ResetPeakMemory
+	idx_t GetPeakMemory() {
+		return peak_memory;
+	}
+	void ResetPeakMemory() {
+		peak_memory = current_memory.load();
+	}
+	//! Returns the total amount of bytes written to temporary files
+	idx_t GetTemporaryBytesWritten() {
+		return temporary_bytes_written;
+	}
+	//! Returns the total amount of bytes read back from temporary files
+	idx_t GetTemporaryBytesRead() {
+		return temporary_bytes_read;
+	}
+
+	DatabaseInstance &GetDatabase() {
+		return db;
+	}
 
 	const string &GetTemporaryDirectory() {
 		return temp_directory;
@@ -108,6 +129,11 @@ private:
 	atomic<idx_t> current_memory;
 	//! The maximum amount of memory that the buffer manager can keep (in bytes)
 	atomic<idx_t> maximum_memory;
+	//! The highest amount of memory that was occupied by the buffer manager (in bytes)
+	atomic<idx_t> peak_memory;
+	//! The total amount of bytes written to and read from temporary files
+	atomic<idx_t> temporary_bytes_written;
+	atomic<idx_t> temporary_bytes_read;
 	//! The directory name where temporary files are stored
 	string temp_directory;
 	//! Lock for creating the temp handle
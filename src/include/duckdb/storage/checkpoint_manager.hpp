@@ -10,6 +10,7 @@
 
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/map.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/meta_block_writer.hpp"
@@ -75,6 +76,12 @@ public:
 	//! Flush any remaining partial segments to disk
 	void FlushPartialSegments();
 
+	//! Serializes the placement of segments into (partial) blocks while columns are checkpointed in parallel
+	mutex block_lock;
+	//! Persistent segments stored in a block with an id of at least this threshold are rewritten, even if they have
+	//! no changes; used by VACUUM to move data towards the start of the file
+	block_id_t relocate_block_threshold = MAXIMUM_BLOCK;
+
 private:
 	void WriteSchema(SchemaCatalogEntry &schema);
 	void WriteTable(TableCatalogEntry &table);
@@ -24,6 +24,8 @@ struct DataPointer {
 	CompressionType compression_type;
 	//! Type-specific statistics of the segment
 	unique_ptr<BaseStatistics> statistics;
+	//! Statistics of the vectors stored entirely within the segment (if any)
+	vector<unique_ptr<BaseStatistics>> vector_statistics;
 };
 
 struct RowGroupPointer {
@@ -86,7 +86,7 @@ private:
 
 struct DataTableInfo {
 	DataTableInfo(DatabaseInstance &db, string schema, string table)
-	    : db(db), cardinality(0), schema(move(schema)), table(move(table)) {
+	    : db(db), cardinality(0), last_commit_id(0), schema(move(schema)), table(move(table)) {
 	}
 
 	//! The database instance of the table
@@ -94,6 +94,8 @@ struct DataTableInfo {
 	//! The amount of elements in the table. Note that this number signifies the amount of COMMITTED entries in the
 	//! table. It can be inaccurate inside of transactions. More work is needed to properly support that.
 	atomic<idx_t> cardinality;
+	//! The commit id of the last transaction that appended, deleted or updated rows of the table
+	atomic<transaction_t> last_commit_id;
 	// schema of the table
 	string schema;
 	// name of the table
@@ -116,6 +118,12 @@ struct ParallelTableScanState {
 
 //! DataTable represents a physical table on disk
 class DataTable {
+public:
+	//! VACUUM rewrites a row group when at least 1 / VACUUM_DELETE_RATIO of its rows are deleted
+	static constexpr const idx_t VACUUM_DELETE_RATIO = 10;
+	//! When compression methods are reused, a checkpoint task compresses a column of this many consecutive row groups
+	static constexpr const idx_t CHECKPOINT_REUSE_RUN_SIZE = 8;
+
 public:
 	//! Constructs a new data table from an (optional) set of persistent segments
 	DataTable(DatabaseInstance &db, const string &schema, const string &table,
@@ -194,6 +202,8 @@ public:
 	//! commit (e.g. because of an I/O exception)
 	void RevertAppend(idx_t start_row, idx_t count);
 	void RevertAppendInternal(idx_t start_row, idx_t count);
+	//! Called when a transaction that appended directly to the table has committed or rolled back
+	void EndDirectAppend(Transaction &transaction);
 
 	void ScanTableSegment(idx_t start_row, idx_t count, const std::function<void(DataChunk &chunk)> &function);
 
@@ -215,6 +225,10 @@ public:
 
 	//! Checkpoint the table to the specified table data writer
 	BlockPointer Checkpoint(TableDataWriter &writer);
+	//! Compacts the table: drops deleted rows and merges small row groups. This changes row ids (the indexes are updated
+	//! accordingly), and can only be done while no other transaction is active. Returns whether or not any row groups
+	//! were rewritten.
+	bool Vacuum(Transaction &transaction);
 	void CommitDropTable();
 	void CommitDropColumn(idx_t index);
 
@@ -228,6 +242,8 @@ public:
 private:
 	//! Verify constraints with a chunk from the Append containing all columns of the table
 	void VerifyAppendConstraints(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk);
+	//! Whether or not an append can bypass the transaction-local storage and write directly into the row groups
+	bool CanAppendDirect(ClientContext &context, Transaction &transaction);
 	//! Verify constraints with a chunk from the Update containing only the specified column_ids
 	void VerifyUpdateConstraints(TableCatalogEntry &table, DataChunk &chunk, const vector<column_t> &column_ids);
 	//! Verify constraints with a chunk from the Delete containing all columns of the table
@@ -249,6 +265,9 @@ private:
 	mutex append_lock;
 	//! The number of rows in the table
 	atomic<idx_t> total_rows;
+	//! The transaction that is appending directly to the row groups of the table (MAX_TRANSACTION_ID if none). Only
+	//! one transaction can do so at a time, so that its rows stay contiguous and can be truncated on rollback
+	atomic<transaction_t> direct_append_transaction;
 	//! The segment trees holding the various row_groups of the table
 	shared_ptr<SegmentTree> row_groups;
 	//! Column statistics
@@ -12,6 +12,7 @@
 #include "duckdb/storage/block_manager.hpp"
 #include "duckdb/storage/block.hpp"
 #include "duckdb/common/file_system.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/common/set.hpp"
 #include "duckdb/common/vector.hpp"
@@ -74,6 +75,8 @@ private:
 	unique_ptr<FileHandle> handle;
 	//! The buffer used to read/write to the headers
 	FileBuffer header_buffer;
+	//! Protects the free list and the block reference counts: blocks are allocated by multiple threads during a checkpoint
+	mutex block_lock;
 	//! The list of free blocks that can be written to currently
 	set<block_id_t> free_list;
 	//! The list of multi-use blocks (i.e. blocks that have >1 reference in the file)
@@ -23,6 +23,9 @@ public:
 
 	//! Type-specific statistics of the segment
 	unique_ptr<BaseStatistics> statistics;
+	//! Statistics of the vectors of the row group that are stored entirely within the segment (if any). The first
+	//! entry belongs to the first vector that starts within the segment.
+	vector<unique_ptr<BaseStatistics>> vector_statistics;
 
 public:
 	void Reset();
@@ -50,6 +50,9 @@ public:
 	}
 
 	void CreateCheckpoint(bool delete_wal = false, bool force_checkpoint = false);
+	//! Checkpoints the database after a VACUUM, and moves data from the end of the file into free blocks so the file
+	//! can be truncated
+	void VacuumCheckpoint();
 
 	string GetDBPath() {
 		return path;
@@ -30,6 +30,10 @@ struct ColumnCheckpointState {
 	SegmentTree new_tree;
 	vector<DataPointer> data_pointers;
 	unique_ptr<BaseStatistics> global_stats;
+	//! The statistics of the vectors of the row group that have been compressed so far (if they are gathered)
+	vector<unique_ptr<BaseStatistics>> vector_stats;
+	//! The amount of rows covered by vector_stats
+	idx_t vector_stats_count = 0;
 
 public:
 	virtual unique_ptr<BaseStatistics> GetStatistics() {
@@ -38,6 +42,10 @@ public:
 
 	virtual void FlushSegment(unique_ptr<ColumnSegment> segment, idx_t segment_size);
 	virtual void FlushToDisk();
+
+private:
+	//! Assigns the statistics of the vectors that are stored entirely within the segment to the segment
+	void AssignVectorStatistics(ColumnSegment &segment);
 };
 
 } // namespace duckdb
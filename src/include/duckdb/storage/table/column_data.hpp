@@ -16,7 +16,9 @@
 #include "duckdb/storage/table/persistent_table_data.hpp"
 #include "duckdb/storage/statistics/segment_statistics.hpp"
 #include "duckdb/storage/table/column_checkpoint_state.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
 class ColumnData;
@@ -28,9 +30,19 @@ class Transaction;
 
 struct DataTableInfo;
 
+//! The compression methods chosen for the (nested) columns of a row group
+struct ColumnCompressionChoices {
+	//! The chosen method, keyed by the path of the column
+	unordered_map<string, CompressionType> methods;
+};
+
 struct ColumnCheckpointInfo {
-	ColumnCheckpointInfo(CompressionType compression_type_p) : compression_type(compression_type_p) {};
+	ColumnCheckpointInfo(CompressionType compression_type_p, ColumnCompressionChoices *previous_choices_p = nullptr)
+	    : compression_type(compression_type_p), previous_choices(previous_choices_p) {};
 	CompressionType compression_type;
+	//! The methods chosen for the column in the row group that was checkpointed before this one by the same task, which
+	//! are reused and updated (nullptr if the choices are not reused)
+	ColumnCompressionChoices *previous_choices;
 };
 
 class ColumnData {
@@ -53,6 +65,9 @@ public:
 
 public:
 	virtual bool CheckZonemap(ColumnScanState &state, TableFilter &filter) = 0;
+	//! Checks the statistics of the next vector of the scan (if any), returns false if no row of the vector can pass
+	//! the filter
+	bool CheckVectorZonemap(ColumnScanState &state, TableFilter &filter);
 
 	DatabaseInstance &GetDatabase() const;
 	DataTableInfo &GetTableInfo() const;
@@ -126,8 +141,13 @@ protected:
 	//! Append a transient segment
 	void AppendTransientSegment(idx_t start_row);
 
+	//! Initializes the scan of the current segment and moves it forward to the row_index of the scan state
+	void BeginScanVector(ColumnScanState &state);
 	//! Scans a base vector from the column
 	idx_t ScanVector(ColumnScanState &state, Vector &result, idx_t remaining);
+	//! Evaluates a filter on the next vector using the compressed data of the current segment, if possible
+	bool FilterCompressed(ColumnScanState &state, SelectionVector &sel, idx_t &approved_tuple_count,
+	                      const TableFilter &filter);
 	//! Scans a vector from the column merged with any potential updates
 	//! If ALLOW_UPDATES is set to false, the function will instead throw an exception if any updates are found
 	template <bool SCAN_COMMITTED, bool ALLOW_UPDATES>
@@ -140,6 +160,8 @@ protected:
 	mutex update_lock;
 	//! The updates for this column segment
 	unique_ptr<UpdateSegment> updates;
+	//! Whether or not the column has updates, this can be checked without obtaining the update lock
+	atomic<bool> has_updates;
 };
 
 } // namespace duckdb
@@ -28,11 +28,31 @@ public:
 	void Checkpoint(unique_ptr<SegmentBase> segment);
 
 private:
-	void ScanSegments(const std::function<void(Vector &, idx_t)> &callback);
+	//! Scans the vectors of the column, vectors for which the filter (if any) returns false are skipped
+	void ScanSegments(const std::function<void(Vector &, idx_t)> &callback,
+	                  const std::function<bool(idx_t)> &scan_vector_filter = nullptr);
 	unique_ptr<AnalyzeState> DetectBestCompressionMethod(idx_t &compression_idx);
+	//! Runs the analyze step of the given compression functions over the sample (every sample_stride-th vector) of the
+	//! column, or over the vectors outside of it if skip_sample is set. Functions that cannot compress the data are
+	//! removed. The analyze states are initialized if they are empty.
+	void AnalyzeVectors(vector<CompressionFunction *> &functions, vector<unique_ptr<AnalyzeState>> &analyze_states,
+	                    idx_t sample_stride, bool skip_sample);
+	//! Finalizes the analysis of the compression functions and returns the index of the best one
+	idx_t ChooseCompressionMethod(vector<unique_ptr<AnalyzeState>> &analyze_states, idx_t &best_score,
+	                              idx_t &second_best_score);
+	//! Returns the compression method chosen for this column in the previous row group of the checkpoint task
+	bool GetPreviousCompression(CompressionType &result);
+	void SetPreviousCompression(idx_t compression_idx);
+	//! Analyzes all vectors with only the compression function of the given type, returns nullptr if it is not
+	//! available or cannot compress the data
+	unique_ptr<AnalyzeState> AnalyzeSingleMethod(CompressionType type, idx_t &compression_idx);
 	void WriteToDisk();
 	bool HasChanges();
 	void WritePersistentSegments();
+	//! Gathers the statistics of the vectors of the row group while the column is compressed, so that scans can skip
+	//! individual vectors
+	void UpdateVectorStatistics(Vector &scan_vector, idx_t count);
+	void FlushVectorStatistics();
 
 private:
 	ColumnData &col_data;
@@ -43,6 +63,12 @@ private:
 	unique_ptr<SegmentBase> owned_segment;
 	vector<CompressionFunction *> compression_functions;
 	ColumnCheckpointInfo &checkpoint_info;
+	//! Whether or not statistics are gathered for the individual vectors of the row group
+	bool gather_vector_stats;
+	//! The statistics of the vector that is currently being compressed
+	unique_ptr<SegmentStatistics> vector_stats;
+	//! The amount of rows in the vector that is currently being compressed
+	idx_t vector_count;
 };
 
 } // namespace duckdb
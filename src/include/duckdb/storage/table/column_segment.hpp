@@ -69,6 +69,15 @@ public:
 
 	static idx_t FilterSelection(SelectionVector &sel, Vector &result, const TableFilter &filter,
 	                             idx_t &approved_tuple_count, ValidityMask &mask);
+	//! Filter rows by the dictionary entry they reference (entries[entry_offset + row]). entry_passes holds whether or
+	//! not every entry passes the filter: if it is empty, the filter is evaluated on the dictionary to fill it.
+	static void FilterDictionarySelection(SelectionVector &sel, idx_t &approved_tuple_count,
+	                                      const SelectionVector &entries, idx_t entry_offset, Vector &dictionary,
+	                                      idx_t dictionary_size, const TableFilter &filter, vector<bool> &entry_passes);
+	//! Evaluate a filter on the next scan_count rows of the segment using the compressed data, if the compression
+	//! method supports this. Returns false if the filter could not be evaluated.
+	bool Filter(ColumnScanState &state, idx_t scan_count, SelectionVector &sel, idx_t &approved_tuple_count,
+	            const TableFilter &filter);
 
 	//! Skip a scan forward to the row_index specified in the scan state
 	void Skip(ColumnScanState &state);
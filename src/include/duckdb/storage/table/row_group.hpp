@@ -19,6 +19,8 @@
 
 namespace duckdb {
 class ColumnData;
+struct ColumnCheckpointState;
+struct ColumnCompressionChoices;
 class DatabaseInstance;
 class DataTable;
 struct DataTableInfo;
@@ -98,6 +100,8 @@ public:
 	idx_t GetSelVector(Transaction &transaction, idx_t vector_idx, SelectionVector &sel_vector, idx_t max_count);
 	idx_t GetCommittedSelVector(transaction_t start_time, transaction_t transaction_id, idx_t vector_idx,
 	                            SelectionVector &sel_vector, idx_t max_count);
+	//! Returns the number of rows of the row group that are visible to the given transaction
+	idx_t GetVisibleRowCount(Transaction &transaction);
 
 	//! For a specific row, returns true if it should be used for the transaction and false otherwise.
 	bool Fetch(Transaction &transaction, idx_t row);
@@ -116,10 +120,21 @@ public:
 	idx_t Delete(Transaction &transaction, DataTable *table, row_t *row_ids, idx_t count);
 
 	RowGroupPointer Checkpoint(TableDataWriter &writer, vector<unique_ptr<BaseStatistics>> &global_stats);
+	//! Compresses a single column of the row group into new blocks; different columns (and row groups) can be
+	//! checkpointed in parallel. If previous_choices is set, the compression methods chosen for the column in the
+	//! previous row group are reused, and the choices for this row group are stored in it.
+	unique_ptr<ColumnCheckpointState> CheckpointColumn(TableDataWriter &writer, idx_t column_idx,
+	                                                   ColumnCompressionChoices *previous_choices = nullptr);
+	//! Writes the metadata of the checkpointed columns, and merges their statistics into the global statistics
+	RowGroupPointer WriteToDisk(TableDataWriter &writer, vector<unique_ptr<ColumnCheckpointState>> &states,
+	                            vector<unique_ptr<BaseStatistics>> &global_stats);
 	static void Serialize(RowGroupPointer &pointer, Serializer &serializer);
 	static RowGroupPointer Deserialize(Deserializer &source, const vector<ColumnDefinition> &columns);
 
 	void InitializeAppend(Transaction &transaction, RowGroupAppendState &append_state, idx_t remaining_append_count);
+	//! Initialize an append without version info, i.e. the appended rows are visible to every transaction. The caller
+	//! is responsible for increasing the count of the row group.
+	void InitializeAppend(RowGroupAppendState &append_state);
 	void Append(RowGroupAppendState &append_state, DataChunk &chunk, idx_t append_count);
 
 	void Update(Transaction &transaction, DataChunk &updates, row_t *ids, idx_t offset, idx_t count,
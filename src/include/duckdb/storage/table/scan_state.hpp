@@ -46,6 +46,9 @@ struct ColumnScanState {
 	idx_t internal_index;
 	//! Segment scan state
 	unique_ptr<SegmentScanState> scan_state;
+	//! The scan states of the previous segments that the current vector was scanned from, the scanned values can
+	//! point into their pinned buffers (e.g. strings)
+	vector<unique_ptr<SegmentScanState>> previous_states;
 	//! Child states of the vector
 	vector<ColumnScanState> child_states;
 	//! Whether or not InitializeState has been called for this segment
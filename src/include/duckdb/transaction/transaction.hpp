@@ -64,6 +64,8 @@ public:
 	unordered_map<SequenceCatalogEntry *, SequenceValue> sequence_usage;
 	//! Whether or not the transaction has been invalidated
 	bool is_invalidated;
+	//! The tables that this transaction appended to directly, bypassing the transaction-local storage
+	vector<DataTable *> direct_appends;
 
 public:
 	static Transaction &GetTransaction(ClientContext &context);
@@ -77,9 +79,7 @@ public:
 	bool AutomaticCheckpoint(DatabaseInstance &db);
 
 	//! Rollback
-	void Rollback() noexcept {
-		undo_buffer.Rollback();
-	}
+	void Rollback() noexcept;
 	//! Cleanup the undo buffer
 	void Cleanup() {
 		undo_buffer.Cleanup();
@@ -106,6 +106,9 @@ private:
 	//! or deleted
 	UndoBuffer undo_buffer;
 
+	//! Allows other transactions to append directly to the tables this transaction appended to directly
+	void EndDirectAppends() noexcept;
+
 	Transaction(const Transaction &) = delete;
 };
 
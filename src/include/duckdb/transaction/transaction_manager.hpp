@@ -21,6 +21,7 @@ class ClientContext;
 class Catalog;
 struct ClientLockWrapper;
 class DatabaseInstance;
+class TableCatalogEntry;
 class Transaction;
 
 struct StoredCatalogSet {
@@ -55,8 +56,15 @@ public:
 	transaction_t LowestActiveStart() {
 		return lowest_active_start;
 	}
+	//! The start timestamp of the next transaction
+	transaction_t NextStartTimestamp() {
+		return current_start_timestamp;
+	}
 
 	void Checkpoint(ClientContext &context, bool force = false);
+	//! Compacts the given tables and checkpoints the database. Like a checkpoint this requires that no other
+	//! transactions are running.
+	void Vacuum(ClientContext &context, const vector<TableCatalogEntry *> &tables);
 
 	static TransactionManager &Get(ClientContext &context);
 	static TransactionManager &Get(DatabaseInstance &db);
@@ -72,7 +80,7 @@ private:
 	//! The current query number
 	atomic<transaction_t> current_query_number;
 	//! The current start timestamp used by transactions
-	transaction_t current_start_timestamp;
+	atomic<transaction_t> current_start_timestamp;
 	//! The current transaction ID used by transactions
 	transaction_t current_transaction_id;
 	//! The lowest active transaction id
@@ -45,6 +45,8 @@ public:
 	//! Reserve space for an entry of the specified type and length in the undo
 	//! buffer
 	data_ptr_t CreateEntry(UndoFlags type, idx_t len);
+	//! Returns the most recently created entry if it is of the specified type, or nullptr otherwise
+	data_ptr_t GetLastEntry(UndoFlags type);
 
 	bool ChangesMade();
 	idx_t EstimatedSize();
@@ -62,6 +64,10 @@ public:
 private:
 	unique_ptr<UndoChunk> head;
 	UndoChunk *tail;
+	//! The type of the most recently created entry
+	UndoFlags last_type;
+	//! The data of the most recently created entry
+	data_ptr_t last_entry;
 
 private:
 	template <class T>
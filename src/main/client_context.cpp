@@ -10,6 +10,8 @@
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
+#include "duckdb/main/result_cache.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/query_result.hpp"
 #include "duckdb/main/stream_query_result.hpp"
@@ -116,7 +118,8 @@ void ClientContext::BeginTransactionInternal(ClientContextLock &lock, bool requi
 		throw Exception("Failed: transaction has been invalidated!");
 	}
 	active_query = make_unique<ActiveQueryContext>();
-	if (transaction.IsAutoCommit()) {
+	if (transaction.IsAutoCommit() && !transaction.HasActiveTransaction()) {
+		// the transaction might already have been started by the lookup in the result cache
 		transaction.BeginTransaction();
 	}
 }
@@ -267,6 +270,10 @@ shared_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(ClientC
 	result->value_map = move(planner.value_map);
 	result->catalog_version = Transaction::GetTransaction(*this).catalog_version;
 	result->bound_all_parameters = planner.bound_all_parameters;
+	if (statement_type == StatementType::SELECT_STATEMENT && db->config.result_cache_size > 0) {
+		// the dependencies are collected before optimization, while the plan still has all table scans
+		result->result_dependencies = ResultCache::GetDependencies(*this, *plan);
+	}
 
 	if (config.enable_optimizer) {
 		profiler.StartPhase("optimizer");
@@ -438,6 +445,32 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(const string &query) {
 	try {
 		InitialCleanup(*lock);
 
+		// check if another prepared statement of the same query left a plan in the prepared statement cache
+		auto cache_key = PreparedStatementCache::GetCacheKey(*this, query);
+		if (!cache_key.empty()) {
+			shared_ptr<PreparedStatementData> cached_data;
+			RunFunctionInTransactionInternal(
+			    *lock,
+			    [&]() {
+				    if (PreparedStatementCache::HasTemporaryObjects(*this)) {
+					    // temporary objects can change what the query binds to: do not share plans
+					    cache_key = string();
+					    return;
+				    }
+				    auto catalog_version = Catalog::GetCatalog(*this).GetCatalogVersion();
+				    if (Transaction::GetTransaction(*this).catalog_version != catalog_version) {
+					    // the catalog was modified after our transaction started
+					    return;
+				    }
+				    cached_data = PreparedStatementCache::Get(*this).Take(cache_key, catalog_version);
+			    },
+			    false);
+			if (cached_data) {
+				auto n_param = cached_data->unbound_statement->n_param;
+				return make_unique<PreparedStatement>(shared_from_this(), move(cached_data), query, n_param);
+			}
+		}
+
 		// first parse the query
 		auto statements = ParseStatementsInternal(*lock, query);
 		if (statements.empty()) {
@@ -446,7 +479,9 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(const string &query) {
 		if (statements.size() > 1) {
 			throw Exception("Cannot prepare multiple statements at once!");
 		}
-		return PrepareInternal(*lock, move(statements[0]));
+		auto result = PrepareInternal(*lock, move(statements[0]));
+		result->data->cache_key = move(cache_key);
+		return result;
 	} catch (std::exception &ex) {
 		return make_unique<PreparedStatement>(ex.what());
 	}
@@ -636,15 +671,53 @@ unique_ptr<QueryResult> ClientContext::Query(unique_ptr<SQLStatement> statement,
 unique_ptr<QueryResult> ClientContext::Query(const string &query, bool allow_stream_result) {
 	auto lock = LockContext();
 
+	string result_cache_key;
+	if (!allow_stream_result) {
+		result_cache_key = ResultCache::GetCacheKey(*this, query);
+	}
+	if (!result_cache_key.empty()) {
+		unique_ptr<MaterializedQueryResult> cached_result;
+		try {
+			InitialCleanup(*lock);
+			if (transaction.IsAutoCommit()) {
+				// the lookup runs in the transaction of the query: if the result is not cached, the query uses it
+				transaction.BeginTransaction();
+			}
+			if (transaction.ActiveTransaction().IsInvalidated() || !ResultCache::CanUseCache(*this)) {
+				result_cache_key = string();
+			} else {
+				cached_result = ResultCache::Get(*this).Lookup(*this, result_cache_key);
+			}
+			if (cached_result && transaction.IsAutoCommit()) {
+				transaction.Commit();
+			}
+		} catch (std::exception &ex) {
+			// the query is executed normally: it reports the error if there is one
+			cached_result.reset();
+			result_cache_key = string();
+		}
+		if (cached_result) {
+			return move(cached_result);
+		}
+	}
+
 	string error;
 	vector<unique_ptr<SQLStatement>> statements;
-	if (!ParseStatements(*lock, query, statements, error)) {
-		return make_unique<MaterializedQueryResult>(move(error));
-	}
-	if (statements.empty()) {
+	if (!ParseStatements(*lock, query, statements, error) || statements.empty()) {
+		if (transaction.IsAutoCommit() && transaction.HasActiveTransaction()) {
+			// no query runs in the transaction that was started by the lookup in the result cache
+			transaction.Rollback();
+		}
+		if (!error.empty()) {
+			return make_unique<MaterializedQueryResult>(move(error));
+		}
 		// no statements, return empty successful result
 		return make_unique<MaterializedQueryResult>(StatementType::INVALID_STATEMENT);
 	}
+	if (statements.size() != 1 || statements[0]->type != StatementType::SELECT_STATEMENT) {
+		// only the results of single SELECT statements are cached
+		result_cache_key = string();
+	}
 
 	unique_ptr<QueryResult> result;
 	QueryResult *last_result = nullptr;
@@ -657,7 +730,16 @@ unique_ptr<QueryResult> ClientContext::Query(const string &query, bool allow_str
 		if (!pending_query->success) {
 			current_result = make_unique<MaterializedQueryResult>(pending_query->error);
 		} else {
+			shared_ptr<PreparedStatementData> prepared;
+			if (!result_cache_key.empty()) {
+				prepared = active_query->prepared;
+			}
 			current_result = ExecutePendingQueryInternal(*lock, *pending_query, stream_result);
+			if (prepared && prepared->result_dependencies && current_result->success &&
+			    current_result->type == QueryResultType::MATERIALIZED_RESULT) {
+				ResultCache::Get(*this).Insert(result_cache_key, *prepared->result_dependencies,
+				                               (MaterializedQueryResult &)*current_result);
+			}
 		}
 		// now append the result to the list of results
 		if (!last_result) {
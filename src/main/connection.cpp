@@ -34,6 +34,8 @@ string Connection::GetProfilingInformation(ProfilerPrintFormat format) {
 	auto &profiler = QueryProfiler::Get(*context);
 	if (format == ProfilerPrintFormat::JSON) {
 		return profiler.ToJSON();
+	} else if (format == ProfilerPrintFormat::CHROME_TRACE) {
+		return profiler.ToChromeTrace();
 	} else {
 		return profiler.ToString();
 	}
@@ -6,6 +6,8 @@
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
+#include "duckdb/main/result_cache.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/main/connection_manager.hpp"
 #include "duckdb/function/compression_function.hpp"
@@ -128,12 +130,15 @@ void DatabaseInstance::Initialize(const char *path, DBConfig *new_config) {
 	transaction_manager = make_unique<TransactionManager>(*this);
 	scheduler = make_unique<TaskScheduler>(*this);
 	object_cache = make_unique<ObjectCache>();
+	prepared_statement_cache = make_unique<PreparedStatementCache>(*this);
+	result_cache = make_unique<ResultCache>(*this);
 	connection_manager = make_unique<ConnectionManager>();
 
 	// initialize the database
 	storage->Initialize();
 
 	// only increase thread count after storage init because we get races on catalog otherwise
+	scheduler->SetNumaNodes(config.numa_nodes);
 	scheduler->SetThreads(config.maximum_threads);
 }
 
@@ -173,6 +178,14 @@ ObjectCache &DatabaseInstance::GetObjectCache() {
 	return *object_cache;
 }
 
+PreparedStatementCache &DatabaseInstance::GetPreparedStatementCache() {
+	return *prepared_statement_cache;
+}
+
+ResultCache &DatabaseInstance::GetResultCache() {
+	return *result_cache;
+}
+
 FileSystem &DatabaseInstance::GetFileSystem() {
 	return *config.file_system;
 }
@@ -230,6 +243,13 @@ void DatabaseInstance::Configure(DBConfig &new_config) {
 	config.replacement_scans = move(new_config.replacement_scans);
 	config.initialize_default_database = new_config.initialize_default_database;
 	config.disabled_optimizers = move(new_config.disabled_optimizers);
+	config.numa_nodes = new_config.numa_nodes;
+	config.compression_sample_rate = new_config.compression_sample_rate;
+	config.compression_confidence_threshold = new_config.compression_confidence_threshold;
+	config.compression_reuse_choice = new_config.compression_reuse_choice;
+	config.vector_statistics = new_config.vector_statistics;
+	config.prepared_statement_cache_size = new_config.prepared_statement_cache_size;
+	config.result_cache_size = new_config.result_cache_size;
 }
 
 DBConfig &DBConfig::GetConfig(ClientContext &context) {
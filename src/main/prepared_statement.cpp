@@ -1,6 +1,8 @@
 #include "duckdb/main/prepared_statement.hpp"
+#include "duckdb/catalog/catalog.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
 #include "duckdb/main/prepared_statement_data.hpp"
 
 namespace duckdb {
@@ -15,6 +17,11 @@ PreparedStatement::PreparedStatement(string error) : context(nullptr), success(f
 }
 
 PreparedStatement::~PreparedStatement() {
+	if (context && data && !data->cache_key.empty() && data.use_count() == 1) {
+		// no pending query uses the plan anymore: hand it to the next connection that prepares the same query
+		auto catalog_version = Catalog::GetCatalog(*context).GetCatalogVersion();
+		PreparedStatementCache::Get(*context).Return(move(data), catalog_version);
+	}
 }
 
 idx_t PreparedStatement::ColumnCount() {
@@ -0,0 +1,229 @@
+#include "duckdb/main/prepared_statement_cache.hpp"
+
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_search_path.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/client_data.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
+#include "duckdb/parser/sql_statement.hpp"
+
+namespace duckdb {
+
+PreparedStatementCache::PreparedStatementCache(DatabaseInstance &db) : db(db), catalog_version(0), plan_count(0) {
+}
+
+shared_ptr<PreparedStatementData> PreparedStatementCache::Take(const string &key, idx_t current_version) {
+	lock_guard<mutex> guard(cache_lock);
+	InvalidateIfStale(current_version);
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	D_ASSERT(!entry->second.plans.empty());
+	auto result = move(entry->second.plans.back());
+	entry->second.plans.pop_back();
+	plan_count--;
+	if (entry->second.plans.empty()) {
+		EraseEntry(entry);
+	}
+	return result;
+}
+
+void PreparedStatementCache::Return(shared_ptr<PreparedStatementData> data, idx_t current_version) {
+	D_ASSERT(data);
+	if (data->cache_key.empty() || !data->bound_all_parameters || !data->unbound_statement || !data->plan) {
+		return;
+	}
+	switch (data->statement_type) {
+	case StatementType::SELECT_STATEMENT:
+	case StatementType::INSERT_STATEMENT:
+	case StatementType::UPDATE_STATEMENT:
+	case StatementType::DELETE_STATEMENT:
+		break;
+	default:
+		// other statements are cheap to plan or modify the catalog
+		return;
+	}
+	auto capacity = db.config.prepared_statement_cache_size;
+	lock_guard<mutex> guard(cache_lock);
+	InvalidateIfStale(current_version);
+	if (capacity == 0 || data->catalog_version != current_version) {
+		// the cache is disabled, or the plan was bound before the last catalog change
+		return;
+	}
+	auto key = data->cache_key;
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		lru.push_front(key);
+		CacheEntry new_entry;
+		new_entry.lru_position = lru.begin();
+		entry = entries.insert(make_pair(move(key), move(new_entry))).first;
+	} else {
+		// move the key to the front of the LRU list
+		lru.splice(lru.begin(), lru, entry->second.lru_position);
+	}
+	entry->second.plans.push_back(move(data));
+	plan_count++;
+	// evict the plans of the least recently used keys until we are within the capacity again
+	while (plan_count > capacity) {
+		D_ASSERT(!lru.empty());
+		auto victim = entries.find(lru.back());
+		D_ASSERT(victim != entries.end());
+		EraseEntry(victim);
+	}
+}
+
+void PreparedStatementCache::Clear() {
+	lock_guard<mutex> guard(cache_lock);
+	entries.clear();
+	lru.clear();
+	plan_count = 0;
+}
+
+idx_t PreparedStatementCache::Count() {
+	lock_guard<mutex> guard(cache_lock);
+	return plan_count;
+}
+
+void PreparedStatementCache::InvalidateIfStale(idx_t current_version) {
+	if (current_version == catalog_version) {
+		return;
+	}
+	// the catalog was modified: none of the cached plans can be used anymore
+	entries.clear();
+	lru.clear();
+	plan_count = 0;
+	catalog_version = current_version;
+}
+
+void PreparedStatementCache::EraseEntry(unordered_map<string, CacheEntry>::iterator entry) {
+	plan_count -= entry->second.plans.size();
+	lru.erase(entry->second.lru_position);
+	entries.erase(entry);
+}
+
+bool PreparedStatementCache::HasTemporaryObjects(ClientContext &context) {
+	// temporary objects can shadow the objects that a plan of another connection was bound to
+	auto &temporary_objects = *ClientData::Get(context).temporary_objects;
+	bool found = false;
+	for (auto type : {CatalogType::TABLE_ENTRY, CatalogType::SEQUENCE_ENTRY, CatalogType::MACRO_ENTRY,
+	                  CatalogType::TYPE_ENTRY}) {
+		temporary_objects.Scan(context, type, [&](CatalogEntry *entry) { found = true; });
+		if (found) {
+			return true;
+		}
+	}
+	return false;
+}
+
+string PreparedStatementCache::GetCacheKey(ClientContext &context, const string &query) {
+	auto &db_config = DBConfig::GetConfig(context);
+	auto &config = ClientConfig::GetConfig(context);
+	if (db_config.prepared_statement_cache_size == 0 || config.query_verification_enabled) {
+		return string();
+	}
+	return GetPlanFingerprint(context, query);
+}
+
+string PreparedStatementCache::GetPlanFingerprint(ClientContext &context, const string &query) {
+	auto &config = ClientConfig::GetConfig(context);
+	auto key = NormalizeQuery(query);
+	if (key.empty()) {
+		return key;
+	}
+	// the client settings that influence binding and planning are part of the key
+	key += '\0';
+	key += StringUtil::Join(ClientData::Get(context).catalog_search_path->Get(), ",");
+	key += '\0';
+	key += config.enable_optimizer ? "O" : "o";
+	key += config.preserve_identifier_case ? "C" : "c";
+	key += config.force_index_join ? "I" : "i";
+	key += config.force_external ? "E" : "e";
+	key += config.verify_parallelism ? "P" : "p";
+	key += to_string(config.perfect_ht_threshold);
+	key += '\0';
+	key += to_string(uint8_t(config.explain_output_type));
+	vector<string> variables;
+	for (auto &entry : config.set_variables) {
+		variables.push_back(StringUtil::Lower(entry.first) + "=" + entry.second.ToString());
+	}
+	std::sort(variables.begin(), variables.end());
+	for (auto &variable : variables) {
+		key += '\0';
+		key += variable;
+	}
+	return key;
+}
+
+string PreparedStatementCache::NormalizeQuery(const string &query) {
+	string result;
+	result.reserve(query.size());
+	// the pending whitespace: a newline if the whitespace run contained one (so that string continuations across
+	// lines keep their meaning), a space otherwise
+	char pending = '\0';
+	idx_t i = 0;
+	while (i < query.size()) {
+		char c = query[i];
+		if (c == '\\') {
+			// escape sequences (e.g. in E'' strings) are not normalized
+			return string();
+		}
+		if (c == '$' && (i + 1 >= query.size() || !StringUtil::CharacterIsDigit(query[i + 1]))) {
+			// dollar-quoted strings are not normalized
+			return string();
+		}
+		if (StringUtil::CharacterIsSpace(c)) {
+			pending = c == '\n' || pending == '\n' ? '\n' : ' ';
+			i++;
+			continue;
+		}
+		if (c == '-' && i + 1 < query.size() && query[i + 1] == '-') {
+			// line comment: skip until the end of the line
+			while (i < query.size() && query[i] != '\n') {
+				i++;
+			}
+			pending = '\n';
+			continue;
+		}
+		if (c == '/' && i + 1 < query.size() && query[i + 1] == '*') {
+			// block comment: skip until the end of the comment
+			auto end = query.find("*/", i + 2);
+			if (end == string::npos || query.find("/*", i + 2) < end) {
+				// unterminated or nested comments are not normalized
+				return string();
+			}
+			i = end + 2;
+			if (pending != '\n') {
+				pending = ' ';
+			}
+			continue;
+		}
+		if (pending != '\0') {
+			if (!result.empty()) {
+				result += pending;
+			}
+			pending = '\0';
+		}
+		if (c == '\'' || c == '"') {
+			// string literal or quoted identifier: copy it verbatim
+			auto end = query.find(c, i + 1);
+			if (end == string::npos) {
+				return string();
+			}
+			result.append(query, i, end - i + 1);
+			i = end + 1;
+			continue;
+		}
+		result += c;
+		i++;
+	}
+	return result;
+}
+
+PreparedStatementCache &PreparedStatementCache::Get(ClientContext &context) {
+	return DatabaseInstance::GetDatabase(context).GetPreparedStatementCache();
+}
+
+} // namespace duckdb
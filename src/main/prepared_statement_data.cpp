@@ -1,5 +1,6 @@
 #include "duckdb/main/prepared_statement_data.hpp"
 #include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/main/result_cache.hpp"
 #include "duckdb/parser/sql_statement.hpp"
 
 namespace duckdb {
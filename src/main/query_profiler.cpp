@@ -19,7 +19,8 @@
 namespace duckdb {
 
 QueryProfiler::QueryProfiler(ClientContext &context_p)
-    : context(context_p), running(false), query_requires_profiling(false), is_explain_analyze(false) {
+    : context(context_p), running(false), query_requires_profiling(false), is_explain_analyze(false), tracing(false),
+      hardware_counters(false) {
 }
 
 bool QueryProfiler::IsEnabled() const {
@@ -30,6 +31,10 @@ bool QueryProfiler::IsDetailedEnabled() const {
 	return is_explain_analyze ? false : ClientConfig::GetConfig(context).enable_detailed_profiling;
 }
 
+bool QueryProfiler::HardwareCountersEnabled() const {
+	return hardware_counters;
+}
+
 ProfilerPrintFormat QueryProfiler::GetPrintFormat() const {
 	return is_explain_analyze ? ProfilerPrintFormat::NONE : ClientConfig::GetConfig(context).profiler_print_format;
 }
@@ -55,6 +60,12 @@ void QueryProfiler::StartQuery(string query, bool is_explain_analyze) {
 	root = nullptr;
 	phase_timings.clear();
 	phase_stack.clear();
+	tracing = GetPrintFormat() == ProfilerPrintFormat::CHROME_TRACE;
+	// hardware counters are only collected if the system permits it, otherwise they are silently left out
+	hardware_counters =
+	    ClientConfig::GetConfig(context).enable_hardware_counters && HardwareCounters::Get().IsAvailable();
+	trace_events.clear();
+	trace_threads.clear();
 
 	main_query.Start();
 }
@@ -95,6 +106,9 @@ bool QueryProfiler::OperatorRequiresProfiling(PhysicalOperatorType op_type) {
 }
 
 void QueryProfiler::Finalize(TreeNode &node) {
+	if (node.memory_account) {
+		node.info.metrics.peak_memory = node.memory_account->peak_memory;
+	}
 	for (auto &child : node.children) {
 		Finalize(*child);
 		if (node.type == PhysicalOperatorType::UNION) {
@@ -113,6 +127,9 @@ void QueryProfiler::EndQuery() {
 		return;
 	}
 
+	if (IsTracing()) {
+		TraceSpan("Query", "query", 0);
+	}
 	main_query.End();
 	if (root) {
 		Finalize(*root);
@@ -129,6 +146,8 @@ void QueryProfiler::EndQuery() {
 			query_info = ToString();
 		} else if (automatic_print_format == ProfilerPrintFormat::QUERY_TREE_OPTIMIZER) {
 			query_info = ToString(true);
+		} else if (automatic_print_format == ProfilerPrintFormat::CHROME_TRACE) {
+			query_info = ToChromeTrace();
 		}
 		auto save_location = GetSaveLocation();
 		if (save_location.empty()) {
@@ -201,7 +220,9 @@ void QueryProfiler::Initialize(PhysicalOperator *root_op) {
 	}
 }
 
-OperatorProfiler::OperatorProfiler(bool enabled_p) : enabled(enabled_p), active_operator(nullptr) {
+OperatorProfiler::OperatorProfiler(bool enabled_p, bool hardware_counters_p, QueryProfiler *query_profiler_p)
+    : enabled(enabled_p), hardware_counters(enabled_p && hardware_counters_p), query_profiler(query_profiler_p),
+      active_operator(nullptr) {
 }
 
 void OperatorProfiler::StartOperator(const PhysicalOperator *phys_op) {
@@ -215,6 +236,16 @@ void OperatorProfiler::StartOperator(const PhysicalOperator *phys_op) {
 
 	active_operator = phys_op;
 
+	// snapshot the I/O counters of this thread, and charge the blocks it loads to the operator
+	auto &metrics = ThreadMetrics::Get();
+	start_metrics = metrics;
+	if (query_profiler) {
+		metrics.memory_account = query_profiler->GetMemoryAccount(phys_op);
+	}
+	if (hardware_counters) {
+		HardwareCounters::Get().Read(start_counters);
+	}
+
 	// start timing for current element
 	op.Start();
 }
@@ -231,11 +262,28 @@ void OperatorProfiler::EndOperator(DataChunk *chunk) {
 	// finish timing for the current element
 	op.End();
 
-	AddTiming(active_operator, op.Elapsed(), chunk ? chunk->size() : 0);
+	// compute the memory and I/O activity of the operator
+	auto &metrics = ThreadMetrics::Get();
+	metrics.memory_account.reset();
+	ThreadMetrics delta;
+	delta.bytes_spilled = metrics.bytes_spilled - start_metrics.bytes_spilled;
+	delta.bytes_reloaded = metrics.bytes_reloaded - start_metrics.bytes_reloaded;
+	delta.pin_hits = metrics.pin_hits - start_metrics.pin_hits;
+	delta.pin_misses = metrics.pin_misses - start_metrics.pin_misses;
+	delta.bytes_read = metrics.bytes_read - start_metrics.bytes_read;
+	delta.rows_scanned = metrics.rows_scanned - start_metrics.rows_scanned;
+
+	HardwareCounterValues counters;
+	if (hardware_counters && HardwareCounters::Get().Read(counters)) {
+		counters.Subtract(start_counters);
+	}
+
+	AddTiming(active_operator, op.Elapsed(), chunk ? chunk->size() : 0, delta, counters);
 	active_operator = nullptr;
 }
 
-void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t elements) {
+void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t elements,
+                                 const ThreadMetrics &metrics, const HardwareCounterValues &counters) {
 	if (!enabled) {
 		return;
 	}
@@ -246,10 +294,14 @@ void OperatorProfiler::AddTiming(const PhysicalOperator *op, double time, idx_t
 	if (entry == timings.end()) {
 		// add new entry
 		timings[op] = OperatorInformation(time, elements);
+		timings[op].metrics = metrics;
+		timings[op].hardware_counters = counters;
 	} else {
 		// add to existing entry
 		entry->second.time += time;
 		entry->second.elements += elements;
+		entry->second.metrics.Combine(metrics);
+		entry->second.hardware_counters.Combine(counters);
 	}
 }
 void OperatorProfiler::Flush(const PhysicalOperator *phys_op, ExpressionExecutor *expression_executor,
@@ -266,6 +318,14 @@ void OperatorProfiler::Flush(const PhysicalOperator *phys_op, ExpressionExecutor
 	operator_timing.name = phys_op->GetName();
 }
 
+shared_ptr<MemoryAccount> QueryProfiler::GetMemoryAccount(const PhysicalOperator *op) const {
+	auto entry = tree_map.find(op);
+	if (entry == tree_map.end()) {
+		return nullptr;
+	}
+	return entry->second->memory_account;
+}
+
 void QueryProfiler::Flush(OperatorProfiler &profiler) {
 	lock_guard<mutex> guard(flush_lock);
 	if (!IsEnabled() || !running) {
@@ -277,6 +337,8 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 
 		entry->second->info.time += node.second.time;
 		entry->second->info.elements += node.second.elements;
+		entry->second->info.metrics.Combine(node.second.metrics);
+		entry->second->info.hardware_counters.Combine(node.second.hardware_counters);
 		if (!IsDetailedEnabled()) {
 			continue;
 		}
@@ -466,11 +528,27 @@ static void ExtractFunctions(std::ostream &ss, ExpressionInfo &info, int &fun_id
 	}
 }
 
-static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, int depth = 1) {
+static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, bool hardware_counters,
+                            int depth = 1) {
 	ss << string(depth * 3, ' ') << " {\n";
 	ss << string(depth * 3, ' ') << "   \"name\": \"" + JSONSanitize(node.name) + "\",\n";
 	ss << string(depth * 3, ' ') << "   \"timing\":" + to_string(node.info.time) + ",\n";
 	ss << string(depth * 3, ' ') << "   \"cardinality\":" + to_string(node.info.elements) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"peak_memory\":" + to_string(node.info.metrics.peak_memory) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"bytes_spilled\":" + to_string(node.info.metrics.bytes_spilled) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"bytes_reloaded\":" + to_string(node.info.metrics.bytes_reloaded) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"pin_hits\":" + to_string(node.info.metrics.pin_hits) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"pin_misses\":" + to_string(node.info.metrics.pin_misses) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"bytes_read\":" + to_string(node.info.metrics.bytes_read) + ",\n";
+	ss << string(depth * 3, ' ') << "   \"rows_scanned\":" + to_string(node.info.metrics.rows_scanned) + ",\n";
+	if (hardware_counters) {
+		auto &counters = node.info.hardware_counters;
+		ss << string(depth * 3, ' ') << "   \"cycles\":" + to_string(counters.cycles) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"instructions\":" + to_string(counters.instructions) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"cache_misses\":" + to_string(counters.cache_misses) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"branch_misses\":" + to_string(counters.branch_misses) + ",\n";
+		ss << string(depth * 3, ' ') << "   \"tlb_misses\":" + to_string(counters.tlb_misses) + ",\n";
+	}
 	ss << string(depth * 3, ' ') << "   \"extra_info\": \"" + JSONSanitize(node.extra_info) + "\",\n";
 	ss << string(depth * 3, ' ') << "   \"timings\": [";
 	int32_t function_counter = 1;
@@ -501,7 +579,7 @@ static void ToJSONRecursive(QueryProfiler::TreeNode &node, std::ostream &ss, int
 			if (i > 0) {
 				ss << ",\n";
 			}
-			ToJSONRecursive(*node.children[i], ss, depth + 1);
+			ToJSONRecursive(*node.children[i], ss, hardware_counters, depth + 1);
 		}
 		ss << string(depth * 3, ' ') << "   ]\n";
 	}
@@ -543,7 +621,76 @@ string QueryProfiler::ToJSON() const {
 	ss << "   ],\n";
 	// recursively print the physical operator tree
 	ss << "   \"children\": [\n";
-	ToJSONRecursive(*root, ss);
+	ToJSONRecursive(*root, ss, hardware_counters);
+	ss << "   ]\n";
+	ss << "}";
+	return ss.str();
+}
+
+int64_t QueryProfiler::TraceTimestamp() const {
+	return int64_t(main_query.Elapsed() * 1000000);
+}
+
+void QueryProfiler::AddTraceEvent(TraceEvent event) {
+	lock_guard<mutex> guard(trace_lock);
+	auto thread_id = std::this_thread::get_id();
+	auto entry = trace_threads.find(thread_id);
+	if (entry == trace_threads.end()) {
+		// threads are numbered in the order in which they first show up in the trace
+		entry = trace_threads.insert(make_pair(thread_id, trace_threads.size())).first;
+	}
+	event.thread_id = entry->second;
+	trace_events.push_back(move(event));
+}
+
+void QueryProfiler::TraceSpan(string name, const char *category, int64_t start) {
+	TraceEvent event;
+	event.name = move(name);
+	event.category = category;
+	event.phase = 'X';
+	event.timestamp = start;
+	event.duration = TraceTimestamp() - start;
+	event.span_id = 0;
+	AddTraceEvent(move(event));
+}
+
+void QueryProfiler::TraceAsync(string name, const char *category, bool begin, idx_t span_id) {
+	TraceEvent event;
+	event.name = move(name);
+	event.category = category;
+	event.phase = begin ? 'b' : 'e';
+	event.timestamp = TraceTimestamp();
+	event.duration = 0;
+	event.span_id = span_id;
+	AddTraceEvent(move(event));
+}
+
+string QueryProfiler::ToChromeTrace() const {
+	std::stringstream ss;
+	ss << "{\n";
+	ss << "   \"displayTimeUnit\": \"ms\",\n";
+	ss << "   \"otherData\": { \"query\": \"" + JSONSanitize(query) + "\" },\n";
+	ss << "   \"traceEvents\": [\n";
+	// name the threads, so that the viewer shows them in order
+	for (idx_t thread_idx = 0; thread_idx < trace_threads.size(); thread_idx++) {
+		ss << "      { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread_idx
+		   << ", \"args\": { \"name\": \"Thread " << thread_idx << "\" } },\n";
+		ss << "      { \"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << thread_idx
+		   << ", \"args\": { \"sort_index\": " << thread_idx << " } }";
+		ss << (thread_idx + 1 < trace_threads.size() || !trace_events.empty() ? ",\n" : "\n");
+	}
+	for (idx_t i = 0; i < trace_events.size(); i++) {
+		auto &event = trace_events[i];
+		ss << "      { \"name\": \"" << JSONSanitize(event.name) << "\", \"cat\": \"" << event.category
+		   << "\", \"ph\": \"" << event.phase << "\", \"ts\": " << event.timestamp;
+		if (event.phase == 'X') {
+			ss << ", \"dur\": " << event.duration;
+		} else {
+			ss << ", \"id\": " << event.span_id;
+		}
+		ss << ", \"pid\": 1, \"tid\": " << event.thread_id << " }";
+		ss << (i + 1 < trace_events.size() ? ",\n" : "\n");
+	}
 	ss << "   ]\n";
 	ss << "}";
 	return ss.str();
@@ -568,6 +715,7 @@ unique_ptr<QueryProfiler::TreeNode> QueryProfiler::CreateTree(PhysicalOperator *
 	node->name = root->GetName();
 	node->extra_info = root->ParamsToString();
 	node->depth = depth;
+	node->memory_account = make_shared<MemoryAccount>();
 	tree_map[root] = node.get();
 	for (auto &child : root->children) {
 		auto child_node = CreateTree(child.get(), depth + 1);
@@ -0,0 +1,332 @@
+#include "duckdb/main/result_cache.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/serializer/buffered_deserializer.hpp"
+#include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
+#include "duckdb/planner/expression/list.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/logical_operator_visitor.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/transaction/transaction.hpp"
+
+namespace duckdb {
+
+ResultCache::ResultCache(DatabaseInstance &db) : db(db), catalog_version(0), cached_bytes(0), page_offset(0) {
+}
+
+ResultCache::~ResultCache() {
+}
+
+bool ResultCache::CanUseCache(ClientContext &context) {
+	auto &transaction = Transaction::GetTransaction(context);
+	if (transaction.catalog_version != Catalog::GetCatalog(context).GetCatalogVersion() ||
+	    transaction.ChangesMade()) {
+		// the transaction does not see the same tables as the cached results
+		return false;
+	}
+	// temporary objects can shadow the tables that the cached results were computed from
+	return !PreparedStatementCache::HasTemporaryObjects(context);
+}
+
+unique_ptr<MaterializedQueryResult> ResultCache::Lookup(ClientContext &context, const string &key) {
+	auto &transaction = Transaction::GetTransaction(context);
+	auto current_version = Catalog::GetCatalog(context).GetCatalogVersion();
+	unique_ptr<BufferHandle> handle;
+	unique_ptr<MaterializedQueryResult> result;
+	idx_t offset, size;
+	{
+		lock_guard<mutex> guard(cache_lock);
+		InvalidateIfStale(current_version);
+		auto entry = entries.find(key);
+		if (entry == entries.end()) {
+			return nullptr;
+		}
+		auto &cached = entry->second;
+		auto &dependencies = cached.dependencies;
+		for (idx_t i = 0; i < dependencies.tables.size(); i++) {
+			transaction_t last_commit_id = dependencies.tables[i]->last_commit_id;
+			if (last_commit_id != dependencies.commit_ids[i]) {
+				// the table was changed since the result was computed
+				EraseEntry(entry);
+				return nullptr;
+			}
+			if (last_commit_id >= transaction.start_time) {
+				// the table was changed after our transaction started: we do not see the cached result
+				return nullptr;
+			}
+		}
+		handle = BufferManager::GetBufferManager(db).Pin(cached.block);
+		if (!handle) {
+			// the buffer manager destroyed the result to free up memory
+			EraseEntry(entry);
+			return nullptr;
+		}
+		lru.splice(lru.begin(), lru, cached.lru_position);
+		result = make_unique<MaterializedQueryResult>(cached.statement_type, cached.types, cached.names);
+		offset = cached.offset;
+		size = cached.size;
+	}
+	// deserialize the result while the buffer is pinned
+	BufferedDeserializer source(handle->Ptr() + offset, size);
+	auto chunk_count = source.Read<idx_t>();
+	for (idx_t chunk_idx = 0; chunk_idx < chunk_count; chunk_idx++) {
+		DataChunk chunk;
+		chunk.Deserialize(source);
+		result->collection.Append(chunk);
+	}
+	return result;
+}
+
+void ResultCache::Insert(const string &key, const ResultCacheDependencies &dependencies,
+                         MaterializedQueryResult &result) {
+	auto capacity = db.config.result_cache_size;
+	if (!result.success || capacity == 0) {
+		return;
+	}
+	for (idx_t i = 0; i < dependencies.tables.size(); i++) {
+		if (dependencies.tables[i]->last_commit_id != dependencies.commit_ids[i]) {
+			// a commit changed the table while the query was running: the result might not reflect it
+			return;
+		}
+	}
+	BufferedSerializer serializer;
+	try {
+		serializer.Write<idx_t>(result.collection.ChunkCount());
+		for (auto &chunk : result.collection.Chunks()) {
+			chunk->Serialize(serializer);
+		}
+	} catch (std::exception &ex) {
+		// not all types can be serialized
+		return;
+	}
+	auto data = serializer.GetData();
+	if (data.size > capacity) {
+		return;
+	}
+	auto current_version = Catalog::GetCatalog(db).GetCatalogVersion();
+
+	lock_guard<mutex> guard(cache_lock);
+	InvalidateIfStale(current_version);
+	if (dependencies.catalog_version != current_version) {
+		return;
+	}
+	shared_ptr<BlockHandle> block;
+	idx_t offset;
+	try {
+		WriteResult(data.data.get(), data.size, block, offset);
+	} catch (OutOfMemoryException &ex) {
+		// there is no memory left to cache the result
+		return;
+	}
+	auto entry = entries.find(key);
+	if (entry != entries.end()) {
+		EraseEntry(entry);
+	}
+	lru.push_front(key);
+	CachedResult cached;
+	cached.dependencies = dependencies;
+	cached.statement_type = result.statement_type;
+	cached.types = result.types;
+	cached.names = result.names;
+	cached.block = move(block);
+	cached.offset = offset;
+	cached.size = data.size;
+	cached.lru_position = lru.begin();
+	entries.insert(make_pair(key, move(cached)));
+	cached_bytes += data.size;
+	// evict the least recently used results until we are within the capacity again
+	while (cached_bytes > capacity) {
+		D_ASSERT(!lru.empty());
+		auto victim = entries.find(lru.back());
+		D_ASSERT(victim != entries.end());
+		EraseEntry(victim);
+	}
+}
+
+void ResultCache::WriteResult(data_ptr_t data, idx_t size, shared_ptr<BlockHandle> &block, idx_t &offset) {
+	auto &buffer_manager = BufferManager::GetBufferManager(db);
+	unique_ptr<BufferHandle> handle;
+	if (size > Storage::BLOCK_SIZE / 4) {
+		// large results get a buffer of their own
+		block = buffer_manager.RegisterMemory(MaxValue<idx_t>(size, Storage::BLOCK_SIZE), true);
+		offset = 0;
+		handle = buffer_manager.Pin(block);
+	} else {
+		// small results share a page
+		if (current_page && page_offset + size <= Storage::BLOCK_SIZE) {
+			handle = buffer_manager.Pin(current_page);
+		}
+		if (!handle) {
+			// the current page is full, or it was destroyed by the buffer manager: start a new one
+			current_page = buffer_manager.RegisterMemory(Storage::BLOCK_SIZE, true);
+			page_offset = 0;
+			handle = buffer_manager.Pin(current_page);
+		}
+		block = current_page;
+		offset = page_offset;
+		page_offset += size;
+	}
+	D_ASSERT(handle);
+	memcpy(handle->Ptr() + offset, data, size);
+}
+
+void ResultCache::Clear() {
+	lock_guard<mutex> guard(cache_lock);
+	entries.clear();
+	lru.clear();
+	cached_bytes = 0;
+	current_page.reset();
+}
+
+idx_t ResultCache::Count() {
+	lock_guard<mutex> guard(cache_lock);
+	return entries.size();
+}
+
+idx_t ResultCache::CachedBytes() {
+	lock_guard<mutex> guard(cache_lock);
+	return cached_bytes;
+}
+
+void ResultCache::InvalidateIfStale(idx_t current_version) {
+	if (current_version == catalog_version) {
+		return;
+	}
+	// the catalog was modified: the cached results might have been bound to tables that no longer exist
+	entries.clear();
+	lru.clear();
+	cached_bytes = 0;
+	catalog_version = current_version;
+}
+
+void ResultCache::EraseEntry(unordered_map<string, CachedResult>::iterator entry) {
+	cached_bytes -= entry->second.size;
+	lru.erase(entry->second.lru_position);
+	entries.erase(entry);
+}
+
+string ResultCache::GetCacheKey(ClientContext &context, const string &query) {
+	auto &db_config = DBConfig::GetConfig(context);
+	auto &config = ClientConfig::GetConfig(context);
+	if (db_config.result_cache_size == 0 || config.query_verification_enabled || config.enable_profiler) {
+		return string();
+	}
+	return PreparedStatementCache::GetPlanFingerprint(context, query);
+}
+
+static bool ExpressionIsCacheable(Expression &expr) {
+	switch (expr.expression_class) {
+	case ExpressionClass::BOUND_FUNCTION: {
+		auto &function = (BoundFunctionExpression &)expr;
+		if (function.function.has_side_effects || function.function.stability != FunctionStability::CONSISTENT) {
+			return false;
+		}
+		break;
+	}
+	case ExpressionClass::BOUND_AGGREGATE: {
+		auto &aggregate = (BoundAggregateExpression &)expr;
+		if (aggregate.function.has_side_effects) {
+			return false;
+		}
+		break;
+	}
+	case ExpressionClass::BOUND_WINDOW: {
+		auto &window = (BoundWindowExpression &)expr;
+		if (window.aggregate && window.aggregate->has_side_effects) {
+			return false;
+		}
+		break;
+	}
+	case ExpressionClass::BOUND_PARAMETER:
+		// the result depends on the values of the parameters
+		return false;
+	default:
+		break;
+	}
+	bool cacheable = true;
+	ExpressionIterator::EnumerateChildren(expr, [&](Expression &child) {
+		if (cacheable && !ExpressionIsCacheable(child)) {
+			cacheable = false;
+		}
+	});
+	return cacheable;
+}
+
+static bool CollectTables(LogicalOperator &op, vector<TableCatalogEntry *> &tables) {
+	switch (op.type) {
+	case LogicalOperatorType::LOGICAL_GET: {
+		auto &get = (LogicalGet &)op;
+		if (get.function.name != "seq_scan") {
+			// other table functions read files, system state or generate data
+			return false;
+		}
+		auto &bind_data = (TableScanBindData &)*get.bind_data;
+		if (std::find(tables.begin(), tables.end(), bind_data.table) == tables.end()) {
+			tables.push_back(bind_data.table);
+		}
+		break;
+	}
+	case LogicalOperatorType::LOGICAL_SAMPLE:
+	case LogicalOperatorType::LOGICAL_PRAGMA:
+	case LogicalOperatorType::LOGICAL_EXECUTE:
+	case LogicalOperatorType::LOGICAL_EXPLAIN:
+		return false;
+	default:
+		break;
+	}
+	bool cacheable = true;
+	LogicalOperatorVisitor::EnumerateExpressions(op, [&](unique_ptr<Expression> *expr) {
+		if (cacheable && !ExpressionIsCacheable(**expr)) {
+			cacheable = false;
+		}
+	});
+	if (!cacheable) {
+		return false;
+	}
+	for (auto &child : op.children) {
+		if (!CollectTables(*child, tables)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+unique_ptr<ResultCacheDependencies> ResultCache::GetDependencies(ClientContext &context, LogicalOperator &plan) {
+	auto &transaction = Transaction::GetTransaction(context);
+	auto current_version = Catalog::GetCatalog(context).GetCatalogVersion();
+	if (transaction.catalog_version != current_version || transaction.ChangesMade()) {
+		// the result would reflect changes to the catalog or the tables that other transactions do not see
+		return nullptr;
+	}
+	vector<TableCatalogEntry *> tables;
+	if (!CollectTables(plan, tables)) {
+		return nullptr;
+	}
+	auto result = make_unique<ResultCacheDependencies>();
+	result->catalog_version = current_version;
+	for (auto &table : tables) {
+		auto &info = table->storage->info;
+		transaction_t last_commit_id = info->last_commit_id;
+		if (last_commit_id >= transaction.start_time) {
+			// we do not see the latest commit to the table
+			return nullptr;
+		}
+		result->tables.push_back(info);
+		result->commit_ids.push_back(last_commit_id);
+	}
+	return result;
+}
+
+ResultCache &ResultCache::Get(ClientContext &context) {
+	return DatabaseInstance::GetDatabase(context).GetResultCache();
+}
+
+} // namespace duckdb
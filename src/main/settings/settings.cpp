@@ -3,6 +3,9 @@
 #include "duckdb/main/config.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_data.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
+#include "duckdb/main/result_cache.hpp"
 #include "duckdb/catalog/catalog_search_path.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
@@ -57,6 +60,50 @@ Value CheckpointThresholdSetting::GetSetting(ClientContext &context) {
 	return Value(StringUtil::BytesToHumanReadableString(config.checkpoint_wal_size));
 }
 
+//===--------------------------------------------------------------------===//
+// Compression Confidence Threshold
+//===--------------------------------------------------------------------===//
+void CompressionConfidenceThresholdSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto threshold = input.GetValue<double>();
+	if (threshold < 0) {
+		throw InvalidInputException("Compression confidence threshold must be at least 0");
+	}
+	config.compression_confidence_threshold = threshold;
+}
+
+Value CompressionConfidenceThresholdSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.compression_confidence_threshold);
+}
+
+//===--------------------------------------------------------------------===//
+// Compression Reuse Choice
+//===--------------------------------------------------------------------===//
+void CompressionReuseChoiceSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.compression_reuse_choice = input.GetValue<bool>();
+}
+
+Value CompressionReuseChoiceSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.compression_reuse_choice);
+}
+
+//===--------------------------------------------------------------------===//
+// Compression Sample Rate
+//===--------------------------------------------------------------------===//
+void CompressionSampleRateSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto sample_rate = input.GetValue<double>();
+	if (sample_rate <= 0 || sample_rate > 1) {
+		throw InvalidInputException("Compression sample rate must be within range (0, 1]");
+	}
+	config.compression_sample_rate = sample_rate;
+}
+
+Value CompressionSampleRateSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::DOUBLE(config.compression_sample_rate);
+}
+
 //===--------------------------------------------------------------------===//
 // Debug Checkpoint Abort
 //===--------------------------------------------------------------------===//
@@ -271,9 +318,12 @@ void EnableProfilingSetting::SetLocal(ClientContext &context, const Value &input
 		config.profiler_print_format = ProfilerPrintFormat::QUERY_TREE;
 	} else if (parameter == "query_tree_optimizer") {
 		config.profiler_print_format = ProfilerPrintFormat::QUERY_TREE_OPTIMIZER;
+	} else if (parameter == "chrome_trace") {
+		config.profiler_print_format = ProfilerPrintFormat::CHROME_TRACE;
 	} else {
 		throw ParserException(
-		    "Unrecognized print format %s, supported formats: [json, query_tree, query_tree_optimizer]", parameter);
+		    "Unrecognized print format %s, supported formats: [json, query_tree, query_tree_optimizer, chrome_trace]",
+		    parameter);
 	}
 	config.enable_profiler = true;
 }
@@ -292,6 +342,8 @@ Value EnableProfilingSetting::GetSetting(ClientContext &context) {
 		return Value("query_tree");
 	case ProfilerPrintFormat::QUERY_TREE_OPTIMIZER:
 		return Value("query_tree_optimizer");
+	case ProfilerPrintFormat::CHROME_TRACE:
+		return Value("chrome_trace");
 	default:
 		throw InternalException("Unsupported profiler print format");
 	}
@@ -407,6 +459,25 @@ Value MaximumMemorySetting::GetSetting(ClientContext &context) {
 	return Value(StringUtil::BytesToHumanReadableString(config.maximum_memory));
 }
 
+//===--------------------------------------------------------------------===//
+// NUMA Nodes
+//===--------------------------------------------------------------------===//
+void NumaNodesSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto numa_nodes = input.GetValue<int64_t>();
+	if (numa_nodes < -1) {
+		throw InvalidInputException("numa_nodes must be 0 (disabled), -1 (detect) or the number of nodes to simulate");
+	}
+	config.numa_nodes = numa_nodes;
+	if (db) {
+		TaskScheduler::GetScheduler(*db).SetNumaNodes(config.numa_nodes);
+	}
+}
+
+Value NumaNodesSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.numa_nodes);
+}
+
 //===--------------------------------------------------------------------===//
 // Perfect Hash Threshold
 //===--------------------------------------------------------------------===//
@@ -422,6 +493,26 @@ Value PerfectHashThresholdSetting::GetSetting(ClientContext &context) {
 	return Value::BIGINT(ClientConfig::GetConfig(context).perfect_ht_threshold);
 }
 
+//===--------------------------------------------------------------------===//
+// Prepared Statement Cache Size
+//===--------------------------------------------------------------------===//
+void PreparedStatementCacheSizeSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	auto cache_size = input.GetValue<int64_t>();
+	if (cache_size < 0) {
+		throw InvalidInputException("prepared_statement_cache_size must be 0 (disabled) or a positive number of plans");
+	}
+	config.prepared_statement_cache_size = cache_size;
+	if (db) {
+		// drop the cached plans: they are re-added on demand within the new capacity
+		db->GetPreparedStatementCache().Clear();
+	}
+}
+
+Value PreparedStatementCacheSizeSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BIGINT(config.prepared_statement_cache_size);
+}
+
 //===--------------------------------------------------------------------===//
 // PreserveIdentifierCase
 //===--------------------------------------------------------------------===//
@@ -433,6 +524,17 @@ Value PreserveIdentifierCase::GetSetting(ClientContext &context) {
 	return Value::BOOLEAN(ClientConfig::GetConfig(context).preserve_identifier_case);
 }
 
+//===--------------------------------------------------------------------===//
+// Profiler Hardware Counters
+//===--------------------------------------------------------------------===//
+void ProfilerHardwareCountersSetting::SetLocal(ClientContext &context, const Value &input) {
+	ClientConfig::GetConfig(context).enable_hardware_counters = input.GetValue<bool>();
+}
+
+Value ProfilerHardwareCountersSetting::GetSetting(ClientContext &context) {
+	return Value::BOOLEAN(ClientConfig::GetConfig(context).enable_hardware_counters);
+}
+
 //===--------------------------------------------------------------------===//
 // Profiler History Size
 //===--------------------------------------------------------------------===//
@@ -500,6 +602,22 @@ Value ProgressBarTimeSetting::GetSetting(ClientContext &context) {
 	return Value::BIGINT(ClientConfig::GetConfig(context).wait_time);
 }
 
+//===--------------------------------------------------------------------===//
+// Result Cache Size
+//===--------------------------------------------------------------------===//
+void ResultCacheSizeSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.result_cache_size = DBConfig::ParseMemoryLimit(input.ToString());
+	if (db) {
+		// drop the cached results: they are re-added on demand within the new capacity
+		db->GetResultCache().Clear();
+	}
+}
+
+Value ResultCacheSizeSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value(StringUtil::BytesToHumanReadableString(config.result_cache_size));
+}
+
 //===--------------------------------------------------------------------===//
 // Schema
 //===--------------------------------------------------------------------===//
@@ -527,6 +645,22 @@ Value SearchPathSetting::GetSetting(ClientContext &context) {
 	return Value(StringUtil::Join(client_data.catalog_search_path->GetSetPaths(), ","));
 }
 
+//===--------------------------------------------------------------------===//
+// Task Priority
+//===--------------------------------------------------------------------===//
+void TaskPrioritySetting::SetLocal(ClientContext &context, const Value &input) {
+	auto priority = input.GetValue<int64_t>();
+	if (priority < 1 || priority > int64_t(TaskScheduler::MAXIMUM_PRIORITY)) {
+		throw InvalidInputException("Task priority out of range: should be within range 1 - %llu",
+		                            TaskScheduler::MAXIMUM_PRIORITY);
+	}
+	ClientConfig::GetConfig(context).task_priority = priority;
+}
+
+Value TaskPrioritySetting::GetSetting(ClientContext &context) {
+	return Value::BIGINT(ClientConfig::GetConfig(context).task_priority);
+}
+
 //===--------------------------------------------------------------------===//
 // Temp Directory
 //===--------------------------------------------------------------------===//
@@ -559,4 +693,16 @@ Value ThreadsSetting::GetSetting(ClientContext &context) {
 	return Value::BIGINT(config.maximum_threads);
 }
 
+//===--------------------------------------------------------------------===//
+// Vector Statistics
+//===--------------------------------------------------------------------===//
+void VectorStatisticsSetting::SetGlobal(DatabaseInstance *db, DBConfig &config, const Value &input) {
+	config.vector_statistics = input.GetValue<bool>();
+}
+
+Value VectorStatisticsSetting::GetSetting(ClientContext &context) {
+	auto &config = DBConfig::GetConfig(context);
+	return Value::BOOLEAN(config.vector_statistics);
+}
+
 } // namespace duckdb
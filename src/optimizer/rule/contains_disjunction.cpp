@@ -0,0 +1,115 @@
+#include "duckdb/optimizer/rule/contains_disjunction.hpp"
+
+#include "duckdb/function/scalar/string_functions.hpp"
+#include "duckdb/optimizer/matcher/expression_matcher.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+
+namespace duckdb {
+
+ContainsDisjunctionRule::ContainsDisjunctionRule(ExpressionRewriter &rewriter) : Rule(rewriter) {
+	// we match on an OR expression
+	root = make_unique<ExpressionMatcher>();
+	root->expr_type = make_unique<SpecificExpressionTypeMatcher>(ExpressionType::CONJUNCTION_OR);
+}
+
+//! Checks whether the expression is CONTAINS(x, 'needle') with a constant, non-NULL needle, or a CONTAINS_ANY call
+//! created by an earlier application of this rule, and extracts the needles
+static bool GetContainsNeedles(Expression &expr, vector<string> &needles) {
+	if (expr.expression_class != ExpressionClass::BOUND_FUNCTION) {
+		return false;
+	}
+	auto &func = (BoundFunctionExpression &)expr;
+	if (func.function.name == "contains_any" && func.bind_info) {
+		// the disjunction can gain CONTAINS calls after it was fused, e.g. when a LIKE is rewritten
+		if (func.children[0]->HasSideEffects()) {
+			return false;
+		}
+		needles = ContainsFun::GetNeedles(*func.bind_info);
+		return true;
+	}
+	if (func.function.name != "contains" || func.children.size() != 2) {
+		return false;
+	}
+	if (func.children[0]->HasSideEffects() || func.children[1]->type != ExpressionType::VALUE_CONSTANT) {
+		return false;
+	}
+	auto &constant = ((BoundConstantExpression &)*func.children[1]).value;
+	if (constant.IsNull() || constant.type().id() != LogicalTypeId::VARCHAR) {
+		return false;
+	}
+	needles.push_back(StringValue::Get(constant));
+	return true;
+}
+
+unique_ptr<Expression> ContainsDisjunctionRule::Apply(LogicalOperator &op, vector<Expression *> &bindings,
+                                                      bool &changes_made, bool is_root) {
+	auto &disjunction = (BoundConjunctionExpression &)*bindings[0];
+
+	// find the CONTAINS calls with constant needles, grouped by the string they search in
+	vector<vector<idx_t>> groups;
+	vector<vector<string>> needles(disjunction.children.size());
+	for (idx_t child_idx = 0; child_idx < disjunction.children.size(); child_idx++) {
+		auto &child = *disjunction.children[child_idx];
+		if (!GetContainsNeedles(child, needles[child_idx])) {
+			continue;
+		}
+		auto &haystack = ((BoundFunctionExpression &)child).children[0];
+		bool found = false;
+		for (auto &group : groups) {
+			auto &group_haystack = ((BoundFunctionExpression &)*disjunction.children[group[0]]).children[0];
+			if (Expression::Equals(haystack.get(), group_haystack.get())) {
+				group.push_back(child_idx);
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			groups.push_back(vector<idx_t> {child_idx});
+		}
+	}
+
+	// replace every group of two or more CONTAINS calls on the same string with a single CONTAINS_ANY call
+	bool fused = false;
+	for (auto &group : groups) {
+		if (group.size() < 2) {
+			continue;
+		}
+		vector<string> group_needles;
+		for (auto &child_idx : group) {
+			group_needles.insert(group_needles.end(), needles[child_idx].begin(), needles[child_idx].end());
+		}
+		auto &first = (BoundFunctionExpression &)*disjunction.children[group[0]];
+		auto bind_data = ContainsFun::BindNeedles(move(group_needles));
+		vector<unique_ptr<Expression>> children;
+		children.push_back(move(first.children[0]));
+		for (auto &needle : ContainsFun::GetNeedles(*bind_data)) {
+			children.push_back(make_unique<BoundConstantExpression>(Value(needle)));
+		}
+		disjunction.children[group[0]] = make_unique<BoundFunctionExpression>(
+		    LogicalType::BOOLEAN, ContainsFun::GetAnyFunction(), move(children), move(bind_data));
+		for (idx_t i = 1; i < group.size(); i++) {
+			disjunction.children[group[i]] = nullptr;
+		}
+		fused = true;
+	}
+	if (!fused) {
+		return nullptr;
+	}
+	vector<unique_ptr<Expression>> new_children;
+	for (auto &child : disjunction.children) {
+		if (child) {
+			new_children.push_back(move(child));
+		}
+	}
+	if (new_children.size() == 1) {
+		// all children of the OR were fused into one
+		return move(new_children[0]);
+	}
+	disjunction.children = move(new_children);
+	changes_made = true;
+	return nullptr;
+}
+
+} // namespace duckdb
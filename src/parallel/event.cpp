@@ -3,6 +3,7 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/execution/executor.hpp"
+#include "duckdb/main/query_profiler.hpp"
 
 namespace duckdb {
 
@@ -17,6 +18,7 @@ void Event::CompleteDependency() {
 	if (current_finished == total_dependencies) {
 		// all dependencies have been completed: schedule the event
 		D_ASSERT(total_tasks == 0);
+		TraceStart();
 		Schedule();
 		if (total_tasks == 0) {
 			Finish();
@@ -28,6 +30,10 @@ void Event::Finish() {
 	D_ASSERT(!finished);
 	FinishEvent();
 	finished = true;
+	auto &profiler = executor.GetProfiler();
+	if (profiler.IsTracing()) {
+		profiler.TraceAsync(GetName(), "event", false, idx_t(this));
+	}
 	// finished processing the pipeline, now we can schedule pipelines that depend on this pipeline
 	for (auto &parent_entry : parents) {
 		auto parent = parent_entry.lock();
@@ -40,6 +46,13 @@ void Event::Finish() {
 	FinalizeFinish();
 }
 
+void Event::TraceStart() {
+	auto &profiler = executor.GetProfiler();
+	if (profiler.IsTracing()) {
+		profiler.TraceAsync(GetName(), "event", true, idx_t(this));
+	}
+}
+
 void Event::AddDependency(Event &event) {
 	total_dependencies++;
 	event.parents.push_back(weak_ptr<Event>(shared_from_this()));
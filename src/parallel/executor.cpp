@@ -182,6 +182,7 @@ void Executor::ScheduleEventsInternal(const vector<shared_ptr<Pipeline>> &pipeli
 	// schedule the pipelines that do not have dependencies
 	for (auto &event : events) {
 		if (!event->HasDependencies()) {
+			event->TraceStart();
 			event->Schedule();
 		}
 	}
@@ -267,7 +268,7 @@ void Executor::Initialize(PhysicalOperator *plan) {
 
 		this->profiler = ClientData::Get(context).profiler;
 		profiler->Initialize(physical_plan);
-		this->producer = scheduler.CreateProducer();
+		this->producer = scheduler.CreateProducer(ClientConfig::GetConfig(context).task_priority);
 
 		auto root_pipeline = make_shared<Pipeline>(*this);
 		root_pipeline->sink = nullptr;
@@ -706,6 +707,10 @@ void Executor::ThrowExceptionInternal() { // LCOV_EXCL_START
 	}
 } // LCOV_EXCL_STOP
 
+QueryProfiler &Executor::GetProfiler() {
+	return *profiler;
+}
+
 void Executor::Flush(ThreadContext &tcontext) {
 	profiler->Flush(tcontext.profiler);
 }
@@ -1,5 +1,6 @@
 #include "duckdb/parallel/task.hpp"
 #include "duckdb/execution/executor.hpp"
+#include "duckdb/main/query_profiler.hpp"
 
 namespace duckdb {
 
@@ -13,6 +14,18 @@ ExecutorTask::~ExecutorTask() {
 }
 
 TaskExecutionResult ExecutorTask::Execute(TaskExecutionMode mode) {
+	auto &profiler = executor.GetProfiler();
+	if (!profiler.IsTracing()) {
+		return ExecuteInternal(mode);
+	}
+	// record the time the task spent on this thread in the execution trace
+	auto start = profiler.TraceTimestamp();
+	auto result = ExecuteInternal(mode);
+	profiler.TraceSpan(GetName(), "task", start);
+	return result;
+}
+
+TaskExecutionResult ExecutorTask::ExecuteInternal(TaskExecutionMode mode) {
 	try {
 		return ExecuteTask(mode);
 	} catch (Exception &ex) {
@@ -0,0 +1,122 @@
+#include "duckdb/parallel/numa_topology.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/fstream.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <thread>
+
+#if defined(__linux__) && !defined(DUCKDB_NO_THREADS)
+#include <pthread.h>
+#include <sched.h>
+#define DUCKDB_NUMA_PINNING
+#endif
+
+namespace duckdb {
+
+static idx_t GetCPUCount() {
+	auto cpu_count = std::thread::hardware_concurrency();
+	return cpu_count == 0 ? 1 : cpu_count;
+}
+
+NumaTopology NumaTopology::SingleNode() {
+	NumaTopology result;
+	result.nodes.emplace_back();
+	for (idx_t cpu = 0; cpu < GetCPUCount(); cpu++) {
+		result.nodes[0].push_back(cpu);
+	}
+	return result;
+}
+
+vector<idx_t> NumaTopology::ParseCPUList(const string &cpu_list) {
+	vector<idx_t> result;
+	for (auto &range : StringUtil::Split(cpu_list, ',')) {
+		auto bounds = StringUtil::Split(range, '-');
+		if (bounds.empty() || bounds.size() > 2) {
+			throw InvalidInputException("Invalid CPU list \"%s\"", cpu_list);
+		}
+		idx_t start = std::stoull(bounds[0]);
+		idx_t end = bounds.size() == 2 ? std::stoull(bounds[1]) : start;
+		for (idx_t cpu = start; cpu <= end; cpu++) {
+			result.push_back(cpu);
+		}
+	}
+	return result;
+}
+
+NumaTopology NumaTopology::Detect() {
+	NumaTopology result;
+#ifdef __linux__
+	// nodes are numbered consecutively, stop at the first node that does not exist
+	for (idx_t node = 0;; node++) {
+		ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+		if (!cpu_list_file.is_open()) {
+			break;
+		}
+		string cpu_list;
+		std::getline(cpu_list_file, cpu_list);
+		StringUtil::Trim(cpu_list);
+		if (cpu_list.empty()) {
+			// memory-only node
+			continue;
+		}
+		try {
+			result.nodes.push_back(ParseCPUList(cpu_list));
+		} catch (std::exception &ex) {
+			return SingleNode();
+		}
+	}
+#endif
+	if (result.nodes.empty()) {
+		return SingleNode();
+	}
+	return result;
+}
+
+NumaTopology NumaTopology::Simulate(idx_t node_count) {
+	D_ASSERT(node_count > 0);
+	auto cpu_count = GetCPUCount();
+	NumaTopology result;
+	result.nodes.resize(node_count);
+	for (idx_t node = 0; node < node_count; node++) {
+		// with fewer CPUs than nodes, the nodes share the CPUs
+		auto start = node * cpu_count / node_count;
+		auto end = MaxValue<idx_t>((node + 1) * cpu_count / node_count, start + 1);
+		for (idx_t cpu = start; cpu < end && cpu < cpu_count; cpu++) {
+			result.nodes[node].push_back(cpu);
+		}
+		if (result.nodes[node].empty()) {
+			result.nodes[node].push_back(cpu_count - 1);
+		}
+	}
+	return result;
+}
+
+NumaTopology NumaTopology::FromSetting(int64_t numa_nodes) {
+	if (numa_nodes == 0) {
+		return SingleNode();
+	} else if (numa_nodes == -1) {
+		return Detect();
+	} else if (numa_nodes > 0) {
+		return Simulate(numa_nodes);
+	}
+	throw InvalidInputException("numa_nodes must be 0 (disabled), -1 (detect) or the number of nodes to simulate");
+}
+
+bool NumaTopology::PinCurrentThread(idx_t node) const {
+	D_ASSERT(node < NodeCount());
+#ifdef DUCKDB_NUMA_PINNING
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	for (auto &cpu : nodes[node]) {
+		if (cpu < CPU_SETSIZE) {
+			CPU_SET(cpu, &cpu_set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+#else
+	return false;
+#endif
+}
+
+} // namespace duckdb
@@ -34,6 +34,10 @@ public:
 	unique_ptr<PipelineExecutor> pipeline_executor;
 
 public:
+	string GetName() const override {
+		return pipeline.GetName();
+	}
+
 	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
 		if (!pipeline_executor) {
 			pipeline_executor = make_unique<PipelineExecutor>(pipeline.GetClientContext(), pipeline);
@@ -118,6 +122,14 @@ bool Pipeline::ScheduleParallel(shared_ptr<Event> &event) {
 	if (!source->ParallelSource()) {
 		return false;
 	}
+	if (sink->RequiresBatchIndex() && !source->SupportsBatchIndex()) {
+		// the sink relies on the order of its input, which is lost when the source is scanned in parallel
+		return false;
+	}
+	if (source->SourceOrderMatters() && !sink->RequiresBatchIndex()) {
+		// the sink cannot restore the order of the source
+		return false;
+	}
 	for (auto &op : operators) {
 		if (!op->ParallelOperator()) {
 			return false;
@@ -187,7 +199,12 @@ void Pipeline::Ready() {
 void Pipeline::Finalize(Event &event) {
 	D_ASSERT(ready);
 	try {
+		// the finalize is part of the work of the sink in the query profile
+		ThreadContext thread(executor.context);
+		thread.profiler.StartOperator(sink);
 		auto sink_state = sink->Finalize(*this, event, executor.context, *sink->sink_state);
+		thread.profiler.EndOperator(nullptr);
+		executor.Flush(thread);
 		sink->sink_state->state = sink_state;
 	} catch (Exception &ex) { // LCOV_EXCL_START
 		executor.PushError(ex.type, ex.what());
@@ -213,6 +230,11 @@ void Pipeline::Print() const {
 	Printer::Print(ToString());
 }
 
+string Pipeline::GetName() const {
+	D_ASSERT(source);
+	return source->GetName() + " -> " + (sink ? sink->GetName() : "RESULT");
+}
+
 vector<PhysicalOperator *> Pipeline::GetOperators() const {
 	vector<PhysicalOperator *> result;
 	D_ASSERT(source);
@@ -16,4 +16,8 @@ void PipelineCompleteEvent::FinalizeFinish() {
 	}
 }
 
+string PipelineCompleteEvent::GetName() const {
+	return "Complete Pipeline";
+}
+
 } // namespace duckdb
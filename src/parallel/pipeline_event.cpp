@@ -15,4 +15,8 @@ void PipelineEvent::Schedule() {
 void PipelineEvent::FinishEvent() {
 }
 
+string PipelineEvent::GetName() const {
+	return "Pipeline " + pipeline->GetName();
+}
+
 } // namespace duckdb
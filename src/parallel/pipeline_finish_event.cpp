@@ -14,4 +14,8 @@ void PipelineFinishEvent::FinishEvent() {
 	pipeline->Finalize(*this);
 }
 
+string PipelineFinishEvent::GetName() const {
+	return "Finalize " + pipeline->GetName();
+}
+
 } // namespace duckdb
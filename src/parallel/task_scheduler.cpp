@@ -28,32 +28,193 @@ typedef duckdb_moodycamel::ConcurrentQueue<unique_ptr<Task>> concurrent_queue_t;
 typedef duckdb_moodycamel::LightweightSemaphore lightweight_semaphore_t;
 
 struct ConcurrentQueue {
+	//! An immutable list of the registered producers, in no particular order
+	struct ProducerList {
+		vector<shared_ptr<QueueProducerToken>> producers;
+	};
+
 	concurrent_queue_t q;
 	lightweight_semaphore_t semaphore;
 
-	void Enqueue(ProducerToken &token, unique_ptr<Task> task);
-	bool DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task);
+	//! The current producer list. Worker threads read it without a lock: adding or removing a producer publishes a new
+	//! list, and the old list is kept alive until no worker thread can be reading it anymore.
+	atomic<ProducerList *> producers;
+	//! The number of worker threads that are reading a producer list
+	atomic<idx_t> active_readers;
+	//! Serializes adding and removing producers, and protects the lists below
+	mutex producers_lock;
+	//! The owner of the current producer list
+	unique_ptr<ProducerList> current_list;
+	//! Replaced producer lists that may still be read by worker threads
+	vector<unique_ptr<ProducerList>> retired_lists;
+	atomic<bool> has_retired_lists;
+	//! The virtual time of the scheduler: the pass of the producer that the last task was taken from
+	atomic<idx_t> global_pass;
+
+	ConcurrentQueue()
+	    : active_readers(0), current_list(make_unique<ProducerList>()), has_retired_lists(false), global_pass(0) {
+		producers = current_list.get();
+	}
+
+	void AddProducer(shared_ptr<QueueProducerToken> token);
+	void RemoveProducer(QueueProducerToken &token);
+	void Enqueue(QueueProducerToken &token, unique_ptr<Task> task);
+	bool DequeueFromProducer(QueueProducerToken &token, unique_ptr<Task> &task);
+	//! Takes a task from the producer with the lowest virtual time that has tasks available, producers with the given
+	//! home node go first
+	bool Dequeue(unique_ptr<Task> &task, idx_t numa_node);
+
+private:
+	//! Publishes a new producer list; must hold the producers_lock
+	void PublishProducers(unique_ptr<ProducerList> new_list);
+	//! Frees the retired producer lists if no worker thread is reading a producer list; must hold the producers_lock
+	void FreeRetiredLists();
+	//! Takes a task from the producer with the lowest virtual time among the producers that (do not) have the given
+	//! home node
+	bool DequeueByPass(ProducerList &list, unique_ptr<Task> &task, idx_t numa_node, bool steal);
 };
 
 struct QueueProducerToken {
-	explicit QueueProducerToken(ConcurrentQueue &queue) : queue_token(queue.q) {
+	QueueProducerToken(ConcurrentQueue &queue, idx_t priority, idx_t numa_node)
+	    : queue_token(queue.q), priority(priority), pass(0), numa_node(numa_node) {
+		D_ASSERT(priority > 0 && priority <= TaskScheduler::MAXIMUM_PRIORITY);
 	}
 
 	duckdb_moodycamel::ProducerToken queue_token;
+	mutex producer_lock;
+	//! The relative share of the worker threads that this producer receives while other producers have tasks too
+	idx_t priority;
+	//! The virtual time of the producer: advanced by (STRIDE / priority) for every task that is taken from it
+	atomic<idx_t> pass;
+	//! The NUMA node whose worker threads prefer the tasks of this producer
+	idx_t numa_node;
 };
 
-void ConcurrentQueue::Enqueue(ProducerToken &token, unique_ptr<Task> task) {
+static void ChargeTask(QueueProducerToken &token) {
+	token.pass += TaskScheduler::STRIDE / token.priority;
+}
+
+//! Raises the virtual time of a producer to at least the given pass
+static void AdvancePass(atomic<idx_t> &pass, idx_t new_pass) {
+	idx_t current = pass;
+	while (current < new_pass && !pass.compare_exchange_weak(current, new_pass)) {
+	}
+}
+
+void ConcurrentQueue::AddProducer(shared_ptr<QueueProducerToken> token) {
+	// new producers start at the current virtual time, so they get their share but do not get ahead of the others
+	token->pass = global_pass.load();
+	lock_guard<mutex> guard(producers_lock);
+	auto new_list = make_unique<ProducerList>(*current_list);
+	new_list->producers.push_back(move(token));
+	PublishProducers(move(new_list));
+}
+
+void ConcurrentQueue::RemoveProducer(QueueProducerToken &token) {
+	lock_guard<mutex> guard(producers_lock);
+	auto new_list = make_unique<ProducerList>();
+	for (auto &producer : current_list->producers) {
+		if (producer.get() != &token) {
+			new_list->producers.push_back(producer);
+		}
+	}
+	PublishProducers(move(new_list));
+}
+
+void ConcurrentQueue::PublishProducers(unique_ptr<ProducerList> new_list) {
+	producers = new_list.get();
+	retired_lists.push_back(move(current_list));
+	current_list = move(new_list);
+	has_retired_lists = true;
+	FreeRetiredLists();
+}
+
+void ConcurrentQueue::FreeRetiredLists() {
+	// a worker thread that starts reading after the new list was published can only see the new list: if no worker
+	// thread is reading right now, nobody can still be reading a retired list
+	if (active_readers == 0) {
+		retired_lists.clear();
+		has_retired_lists = false;
+	}
+}
+
+void ConcurrentQueue::Enqueue(QueueProducerToken &token, unique_ptr<Task> task) {
+	// a producer that was idle does not get to catch up on the time it did not use
+	AdvancePass(token.pass, global_pass);
 	lock_guard<mutex> producer_lock(token.producer_lock);
-	if (q.enqueue(token.token->queue_token, move(task))) {
+	if (q.enqueue(token.queue_token, move(task))) {
 		semaphore.signal();
 	} else {
 		throw InternalException("Could not schedule task!");
 	}
 }
 
-bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
+bool ConcurrentQueue::DequeueFromProducer(QueueProducerToken &token, unique_ptr<Task> &task) {
 	lock_guard<mutex> producer_lock(token.producer_lock);
-	return q.try_dequeue_from_producer(token.token->queue_token, task);
+	if (!q.try_dequeue_from_producer(token.queue_token, task)) {
+		return false;
+	}
+	ChargeTask(token);
+	return true;
+}
+
+bool ConcurrentQueue::DequeueByPass(ProducerList &list, unique_ptr<Task> &task, idx_t numa_node, bool steal) {
+	// visit the producers in order of (pass, address) by repeatedly selecting the lowest one after the previously
+	// visited producer. Usually the first producer has tasks available, so this is a single pass over the list.
+	// The passes change while we look at them: a producer may be skipped or visited twice, which only affects the
+	// fairness of this single dequeue, and the order strictly increases so the loop terminates.
+	QueueProducerToken *previous = nullptr;
+	idx_t previous_pass = 0;
+	while (true) {
+		QueueProducerToken *best = nullptr;
+		idx_t best_pass = 0;
+		for (auto &producer_p : list.producers) {
+			auto producer = producer_p.get();
+			if ((producer->numa_node == numa_node) == steal) {
+				continue;
+			}
+			idx_t pass = producer->pass;
+			if (previous && (pass < previous_pass || (pass == previous_pass && producer <= previous))) {
+				continue;
+			}
+			if (!best || pass < best_pass || (pass == best_pass && producer < best)) {
+				best = producer;
+				best_pass = pass;
+			}
+		}
+		if (!best) {
+			return false;
+		}
+		{
+			lock_guard<mutex> producer_lock(best->producer_lock);
+			if (q.try_dequeue_from_producer(best->queue_token, task)) {
+				AdvancePass(global_pass, best_pass);
+				ChargeTask(*best);
+				return true;
+			}
+		}
+		previous = best;
+		previous_pass = best_pass;
+	}
+}
+
+bool ConcurrentQueue::Dequeue(unique_ptr<Task> &task, idx_t numa_node) {
+	active_readers++;
+	auto &list = *producers.load();
+	// first look for local work, then steal work from the other nodes
+	bool found = DequeueByPass(list, task, numa_node, false) || DequeueByPass(list, task, numa_node, true);
+	if (--active_readers == 0 && has_retired_lists) {
+		// we were the last reader: free the retired lists, unless another thread is adding or removing a producer
+		unique_lock<mutex> guard(producers_lock, std::try_to_lock);
+		if (guard.owns_lock()) {
+			FreeRetiredLists();
+		}
+	}
+	if (found) {
+		return true;
+	}
+	// tasks of producers that were already destroyed are still executed
+	return q.try_dequeue(task);
 }
 
 #else
@@ -61,16 +222,20 @@ struct ConcurrentQueue {
 	std::queue<std::unique_ptr<Task>> q;
 	mutex qlock;
 
-	void Enqueue(ProducerToken &token, unique_ptr<Task> task);
-	bool DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task);
+	void AddProducer(shared_ptr<QueueProducerToken> token) {
+	}
+	void RemoveProducer(QueueProducerToken &token) {
+	}
+	void Enqueue(QueueProducerToken &token, unique_ptr<Task> task);
+	bool DequeueFromProducer(QueueProducerToken &token, unique_ptr<Task> &task);
 };
 
-void ConcurrentQueue::Enqueue(ProducerToken &token, unique_ptr<Task> task) {
+void ConcurrentQueue::Enqueue(QueueProducerToken &token, unique_ptr<Task> task) {
 	lock_guard<mutex> lock(qlock);
 	q.push(move(task));
 }
 
-bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
+bool ConcurrentQueue::DequeueFromProducer(QueueProducerToken &token, unique_ptr<Task> &task) {
 	lock_guard<mutex> lock(qlock);
 	if (q.empty()) {
 		return false;
@@ -81,19 +246,22 @@ bool ConcurrentQueue::DequeueFromProducer(ProducerToken &token, unique_ptr<Task>
 }
 
 struct QueueProducerToken {
-	QueueProducerToken(ConcurrentQueue &queue) {
+	QueueProducerToken(ConcurrentQueue &queue, idx_t priority, idx_t numa_node) {
 	}
 };
 #endif
 
-ProducerToken::ProducerToken(TaskScheduler &scheduler, unique_ptr<QueueProducerToken> token)
+ProducerToken::ProducerToken(TaskScheduler &scheduler, shared_ptr<QueueProducerToken> token)
     : scheduler(scheduler), token(move(token)) {
 }
 
 ProducerToken::~ProducerToken() {
+	scheduler.RemoveProducer(*this);
 }
 
-TaskScheduler::TaskScheduler(DatabaseInstance &db) : db(db), queue(make_unique<ConcurrentQueue>()) {
+TaskScheduler::TaskScheduler(DatabaseInstance &db)
+    : db(db), queue(make_unique<ConcurrentQueue>()),
+      topology(make_shared<NumaTopology>(NumaTopology::SingleNode())), next_producer_node(0) {
 }
 
 TaskScheduler::~TaskScheduler() {
@@ -110,28 +278,34 @@ TaskScheduler &TaskScheduler::GetScheduler(DatabaseInstance &db) {
 	return db.GetScheduler();
 }
 
-unique_ptr<ProducerToken> TaskScheduler::CreateProducer() {
-	auto token = make_unique<QueueProducerToken>(*queue);
+unique_ptr<ProducerToken> TaskScheduler::CreateProducer(idx_t priority) {
+	auto numa_node = next_producer_node++ % NumaNodeCount();
+	auto token = make_shared<QueueProducerToken>(*queue, priority, numa_node);
+	queue->AddProducer(token);
 	return make_unique<ProducerToken>(*this, move(token));
 }
 
+void TaskScheduler::RemoveProducer(ProducerToken &token) {
+	queue->RemoveProducer(*token.token);
+}
+
 void TaskScheduler::ScheduleTask(ProducerToken &token, unique_ptr<Task> task) {
 	// Enqueue a task for the given producer token and signal any sleeping threads
-	queue->Enqueue(token, move(task));
+	queue->Enqueue(*token.token, move(task));
 }
 
 bool TaskScheduler::GetTaskFromProducer(ProducerToken &token, unique_ptr<Task> &task) {
-	return queue->DequeueFromProducer(token, task);
+	return queue->DequeueFromProducer(*token.token, task);
 }
 
-void TaskScheduler::ExecuteForever(atomic<bool> *marker) {
+void TaskScheduler::ExecuteForever(atomic<bool> *marker, idx_t numa_node) {
 #ifndef DUCKDB_NO_THREADS
 	unique_ptr<Task> task;
 	// loop until the marker is set to false
 	while (*marker) {
 		// wait for a signal with a timeout; the timeout allows us to periodically check
 		queue->semaphore.wait();
-		if (queue->q.try_dequeue(task)) {
+		if (queue->Dequeue(task, numa_node)) {
 			task->Execute(TaskExecutionMode::PROCESS_ALL);
 			task.reset();
 		}
@@ -146,7 +320,7 @@ void TaskScheduler::ExecuteTasks(idx_t max_tasks) {
 	unique_ptr<Task> task;
 	for (idx_t i = 0; i < max_tasks; i++) {
 		queue->semaphore.wait(TASK_TIMEOUT_USECS);
-		if (!queue->q.try_dequeue(task)) {
+		if (!queue->Dequeue(task, 0)) {
 			return;
 		}
 		try {
@@ -162,8 +336,14 @@ void TaskScheduler::ExecuteTasks(idx_t max_tasks) {
 }
 
 #ifndef DUCKDB_NO_THREADS
-static void ThreadExecuteTasks(TaskScheduler *scheduler, atomic<bool> *marker) {
-	scheduler->ExecuteForever(marker);
+static void ThreadExecuteTasks(TaskScheduler *scheduler, atomic<bool> *marker,
+                               shared_ptr<const NumaTopology> topology, idx_t numa_node) {
+	if (topology->NodeCount() > 1) {
+		// pinning is best-effort: with the threads spread over the nodes, memory allocated and first touched by a
+		// thread (e.g. its hash tables and sorted runs) is placed on the node of that thread by the operating system
+		topology->PinCurrentThread(numa_node);
+	}
+	scheduler->ExecuteForever(marker, numa_node);
 }
 #endif
 
@@ -172,6 +352,28 @@ int32_t TaskScheduler::NumberOfThreads() {
 	return threads.size() + config.external_threads + 1;
 }
 
+void TaskScheduler::SetNumaNodes(int64_t numa_nodes) {
+	auto new_topology = make_shared<NumaTopology>(NumaTopology::FromSetting(numa_nodes));
+#ifndef DUCKDB_NO_THREADS
+	// restart the background threads so they are pinned to the new topology
+	auto thread_count = threads.size() + 1;
+	SetThreadsInternal(1);
+	{
+		lock_guard<mutex> guard(topology_lock);
+		topology = move(new_topology);
+	}
+	SetThreadsInternal(thread_count);
+#else
+	lock_guard<mutex> guard(topology_lock);
+	topology = move(new_topology);
+#endif
+}
+
+idx_t TaskScheduler::NumaNodeCount() {
+	lock_guard<mutex> guard(topology_lock);
+	return topology->NodeCount();
+}
+
 void TaskScheduler::SetThreads(int32_t n) {
 #ifndef DUCKDB_NO_THREADS
 	if (n < 1) {
@@ -208,10 +410,18 @@ void TaskScheduler::SetThreadsInternal(int32_t n) {
 	if (threads.size() < new_thread_count) {
 		// we are increasing the number of threads: launch them and run tasks on them
 		idx_t create_new_threads = new_thread_count - threads.size();
+		shared_ptr<const NumaTopology> thread_topology;
+		{
+			lock_guard<mutex> guard(topology_lock);
+			thread_topology = topology;
+		}
 		for (idx_t i = 0; i < create_new_threads; i++) {
 			// launch a thread and assign it a cancellation marker
 			auto marker = unique_ptr<atomic<bool>>(new atomic<bool>(true));
-			auto worker_thread = make_unique<thread>(ThreadExecuteTasks, this, marker.get());
+			// spread the threads evenly over the NUMA nodes
+			auto numa_node = threads.size() % thread_topology->NodeCount();
+			auto worker_thread =
+			    make_unique<thread>(ThreadExecuteTasks, this, marker.get(), thread_topology, numa_node);
 			auto thread_wrapper = make_unique<SchedulerThread>(move(worker_thread));
 
 			threads.push_back(move(thread_wrapper));
@@ -4,7 +4,9 @@
 
 namespace duckdb {
 
-ThreadContext::ThreadContext(ClientContext &context) : profiler(QueryProfiler::Get(context).IsEnabled()) {
+ThreadContext::ThreadContext(ClientContext &context)
+    : profiler(QueryProfiler::Get(context).IsEnabled(), QueryProfiler::Get(context).HardwareCountersEnabled(),
+               &QueryProfiler::Get(context)) {
 }
 
 } // namespace duckdb
@@ -6,8 +6,14 @@ namespace duckdb {
 unique_ptr<VacuumStatement> Transformer::TransformVacuum(duckdb_libpgquery::PGNode *node) {
 	auto stmt = reinterpret_cast<duckdb_libpgquery::PGVacuumStmt *>(node);
 	D_ASSERT(stmt);
-	(void)stmt;
 	auto result = make_unique<VacuumStatement>();
+	result->info->vacuum = stmt->options & duckdb_libpgquery::PG_VACOPT_VACUUM;
+	if (stmt->relation) {
+		auto qname = TransformQualifiedName(stmt->relation);
+		result->info->has_table = true;
+		result->info->schema = qname.schema;
+		result->info->table = qname.name;
+	}
 	return result;
 }
 
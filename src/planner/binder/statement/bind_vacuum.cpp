@@ -1,6 +1,9 @@
 #include "duckdb/planner/binder.hpp"
 #include "duckdb/parser/statement/vacuum_statement.hpp"
 #include "duckdb/planner/operator/logical_simple.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 
 namespace duckdb {
 
@@ -8,6 +11,20 @@ BoundStatement Binder::Bind(VacuumStatement &stmt) {
 	BoundStatement result;
 	result.names = {"Success"};
 	result.types = {LogicalType::BOOLEAN};
+	auto &info = *stmt.info;
+	if (info.vacuum) {
+		if (info.has_table) {
+			// resolve the table now, so a missing table is reported at bind time
+			auto &catalog = Catalog::GetCatalog(context);
+			auto table = catalog.GetEntry<TableCatalogEntry>(context, info.schema, info.table);
+			info.schema = table->schema->name;
+			if (!table->temporary) {
+				this->read_only = false;
+			}
+		} else {
+			this->read_only = false;
+		}
+	}
 	result.plan = make_unique<LogicalSimple>(LogicalOperatorType::LOGICAL_VACUUM, move(stmt.info));
 	return result;
 }
@@ -2,11 +2,27 @@
 
 #include "duckdb/common/allocator.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/thread_metrics.hpp"
 #include "duckdb/parallel/concurrentqueue.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 
 namespace duckdb {
 
+//! Charges the memory of a block that was just loaded to the memory account of the current thread (if any)
+static void ChargeMemory(shared_ptr<MemoryAccount> &account, idx_t size) {
+	account = ThreadMetrics::Get().memory_account;
+	if (account) {
+		account->Reserve(size);
+	}
+}
+
+//! Releases memory of a block from the account it was charged to (if any)
+static void ReleaseMemory(shared_ptr<MemoryAccount> &account, idx_t size) {
+	if (account) {
+		account->Release(size);
+	}
+}
+
 BlockHandle::BlockHandle(DatabaseInstance &db, block_id_t block_id_p)
     : db(db), readers(0), block_id(block_id_p), buffer(nullptr), eviction_timestamp(0), can_destroy(false) {
 	eviction_timestamp = 0;
@@ -30,6 +46,7 @@ BlockHandle::~BlockHandle() {
 		// the block is still loaded in memory: erase it
 		buffer.reset();
 		buffer_manager.current_memory -= memory_usage;
+		ReleaseMemory(memory_account, memory_usage);
 	}
 	buffer_manager.UnregisterBlock(block_id, can_destroy);
 }
@@ -73,6 +90,8 @@ void BlockHandle::Unload() {
 	}
 	buffer.reset();
 	buffer_manager.current_memory -= memory_usage;
+	ReleaseMemory(memory_account, memory_usage);
+	memory_account.reset();
 	state = BlockState::BLOCK_UNLOADED;
 }
 
@@ -161,8 +180,9 @@ void BufferManager::SetTemporaryDirectory(string new_dir) {
 }
 
 BufferManager::BufferManager(DatabaseInstance &db, string tmp, idx_t maximum_memory)
-    : db(db), current_memory(0), maximum_memory(maximum_memory), temp_directory(move(tmp)),
-      queue(make_unique<EvictionQueue>()), temporary_id(MAXIMUM_BLOCK) {
+    : db(db), current_memory(0), maximum_memory(maximum_memory), peak_memory(0), temporary_bytes_written(0),
+      temporary_bytes_read(0), temp_directory(move(tmp)), queue(make_unique<EvictionQueue>()),
+      temporary_id(MAXIMUM_BLOCK) {
 }
 
 BufferManager::~BufferManager() {
@@ -207,6 +227,7 @@ shared_ptr<BlockHandle> BufferManager::ConvertToPersistent(BlockManager &block_m
 	// move the data from the old block into data for the new block
 	new_block->state = BlockState::BLOCK_LOADED;
 	new_block->buffer = make_unique<Block>(*old_block->buffer, block_id);
+	new_block->memory_account = move(old_block->memory_account);
 
 	// clear the old buffer and unload it
 	old_handle.reset();
@@ -235,7 +256,9 @@ shared_ptr<BlockHandle> BufferManager::RegisterMemory(idx_t block_size, bool can
 	auto buffer = make_unique<ManagedBuffer>(db, block_size, can_destroy, temp_id);
 
 	// create a new block pointer for this block
-	return make_shared<BlockHandle>(db, temp_id, move(buffer), can_destroy, block_size);
+	auto handle = make_shared<BlockHandle>(db, temp_id, move(buffer), can_destroy, block_size);
+	ChargeMemory(handle->memory_account, alloc_size);
+	return handle;
 }
 
 unique_ptr<BufferHandle> BufferManager::Allocate(idx_t block_size) {
@@ -257,9 +280,13 @@ void BufferManager::ReAllocate(shared_ptr<BlockHandle> &handle, idx_t block_size
 			throw OutOfMemoryException("failed to resize block from %lld to %lld%s", handle->memory_usage, alloc_size,
 			                           InMemoryWarning());
 		}
+		if (handle->memory_account) {
+			handle->memory_account->Reserve(required_memory);
+		}
 	} else {
 		// no need to evict blocks
 		current_memory -= idx_t(-required_memory);
+		ReleaseMemory(handle->memory_account, idx_t(-required_memory));
 	}
 
 	// resize and adjust current memory
@@ -276,10 +303,16 @@ unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
 		if (handle->state == BlockState::BLOCK_LOADED) {
 			// the block is loaded, increment the reader count and return a pointer to the handle
 			handle->readers++;
+			ThreadMetrics::Get().pin_hits++;
 			return handle->Load(handle);
 		}
+		if (handle->can_destroy && handle->block_id >= MAXIMUM_BLOCK) {
+			// the buffer was destroyed when it was evicted: there is nothing to load
+			return nullptr;
+		}
 		required_memory = handle->memory_usage;
 	}
+	ThreadMetrics::Get().pin_misses++;
 	// evict blocks until we have space for the current block
 	if (!EvictBlocks(required_memory, maximum_memory)) {
 		throw OutOfMemoryException("failed to pin block of size %lld%s", required_memory, InMemoryWarning());
@@ -296,6 +329,7 @@ unique_ptr<BufferHandle> BufferManager::Pin(shared_ptr<BlockHandle> &handle) {
 	// now we can actually load the current block
 	D_ASSERT(handle->readers == 0);
 	handle->readers = 1;
+	ChargeMemory(handle->memory_account, required_memory);
 	return handle->Load(handle);
 }
 
@@ -341,6 +375,10 @@ bool BufferManager::EvictBlocks(idx_t extra_memory, idx_t memory_limit) {
 		// release the memory and mark the block as unloaded
 		handle->Unload();
 	}
+	idx_t memory = current_memory;
+	idx_t peak = peak_memory;
+	while (memory > peak && !peak_memory.compare_exchange_weak(peak, memory)) {
+	}
 	return true;
 }
 
@@ -423,6 +461,8 @@ void BufferManager::WriteTemporaryBuffer(ManagedBuffer &buffer) {
 	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE);
 	handle->Write(&buffer.size, sizeof(idx_t), 0);
 	buffer.Write(*handle, sizeof(idx_t));
+	temporary_bytes_written += sizeof(idx_t) + buffer.AllocSize();
+	ThreadMetrics::Get().bytes_spilled += sizeof(idx_t) + buffer.AllocSize();
 }
 
 unique_ptr<FileBuffer> BufferManager::ReadTemporaryBuffer(block_id_t id) {
@@ -438,6 +478,8 @@ unique_ptr<FileBuffer> BufferManager::ReadTemporaryBuffer(block_id_t id) {
 	// now allocate a buffer of this size and read the data into that buffer
 	auto buffer = make_unique<ManagedBuffer>(db, block_size, false, id);
 	buffer->Read(*handle, sizeof(idx_t));
+	temporary_bytes_read += sizeof(idx_t) + buffer->AllocSize();
+	ThreadMetrics::Get().bytes_reloaded += sizeof(idx_t) + buffer->AllocSize();
 
 	handle.reset();
 	DeleteTemporaryFile(id);
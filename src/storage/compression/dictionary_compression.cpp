@@ -113,6 +113,8 @@ struct DictionaryCompressionStorage {
 	static void StringScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result);
 	static void StringFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id, Vector &result,
 	                           idx_t result_idx);
+	static bool StringFilter(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SelectionVector &sel,
+	                         idx_t &approved_tuple_count, const TableFilter &filter);
 
 	static bool HasEnoughSpace(idx_t current_count, idx_t index_count, idx_t dict_size,
 	                           bitpacking_width_t packing_width);
@@ -417,9 +419,13 @@ void DictionaryCompressionStorage::FinalizeCompress(CompressionState &state_p) {
 struct CompressedStringScanState : public StringScanState {
 	unique_ptr<BufferHandle> handle;
 	buffer_ptr<Vector> dictionary;
+	idx_t dictionary_size;
 	bitpacking_width_t current_width;
 	buffer_ptr<SelectionVector> sel_vec;
 	idx_t sel_vec_size = 0;
+	//! The filter that was last evaluated against the dictionary, and which of the dictionary entries pass it
+	const TableFilter *entry_filter = nullptr;
+	vector<bool> entry_passes;
 };
 
 unique_ptr<SegmentScanState> DictionaryCompressionStorage::StringInitScan(ColumnSegment &segment) {
@@ -439,6 +445,7 @@ unique_ptr<SegmentScanState> DictionaryCompressionStorage::StringInitScan(Column
 	auto index_buffer_ptr = (uint32_t *)(baseptr + index_buffer_offset);
 
 	state->dictionary = make_buffer<Vector>(segment.type, index_buffer_count);
+	state->dictionary_size = index_buffer_count;
 	auto dict_child_data = FlatVector::GetData<string_t>(*(state->dictionary));
 
 	for (uint32_t i = 0; i < index_buffer_count; i++) {
@@ -470,13 +477,10 @@ void DictionaryCompressionStorage::StringScanPartial(ColumnSegment &segment, Col
 	auto base_data = (data_ptr_t)(baseptr + DICTIONARY_HEADER_SIZE);
 	auto result_data = FlatVector::GetData<string_t>(result);
 
-	if (!ALLOW_DICT_VECTORS || scan_count != STANDARD_VECTOR_SIZE ||
-	    start % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE != 0) {
-		// Emit regular vector
-
-		// Handling non-bitpacking-group-aligned start values;
-		idx_t start_offset = start % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE;
+	// Handling non-bitpacking-group-aligned start values;
+	idx_t start_offset = start % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE;
 
+	if (!ALLOW_DICT_VECTORS || start_offset != 0) {
 		// We will scan in blocks of BITPACKING_ALGORITHM_GROUP_SIZE, so we may scan some extra values.
 		idx_t decompress_count = BitpackingPrimitives::RoundUpToAlgorithmGroupSize(scan_count + start_offset);
 
@@ -492,6 +496,15 @@ void DictionaryCompressionStorage::StringScanPartial(ColumnSegment &segment, Col
 		BitpackingPrimitives::UnPackBuffer<sel_t>((data_ptr_t)sel_vec_ptr, src, decompress_count,
 		                                          scan_state.current_width);
 
+		if (ALLOW_DICT_VECTORS) {
+			// Unaligned scan of an entire vector: emit a dict vector with its own selection vector
+			SelectionVector sel(scan_count);
+			memcpy(sel.data(), sel_vec_ptr + start_offset, scan_count * sizeof(sel_t));
+			result.Dictionary(*(scan_state.dictionary), scan_state.dictionary_size, sel, scan_count);
+			return;
+		}
+
+		// Emit regular vector
 		for (idx_t i = 0; i < scan_count; i++) {
 			// Lookup dict offset in index buffer
 			auto string_number = scan_state.sel_vec->get_index(i + start_offset);
@@ -502,7 +515,6 @@ void DictionaryCompressionStorage::StringScanPartial(ColumnSegment &segment, Col
 
 	} else {
 		D_ASSERT(start % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE == 0);
-		D_ASSERT(scan_count == STANDARD_VECTOR_SIZE);
 		D_ASSERT(result_offset == 0);
 
 		idx_t decompress_count = BitpackingPrimitives::RoundUpToAlgorithmGroupSize(scan_count);
@@ -513,14 +525,42 @@ void DictionaryCompressionStorage::StringScanPartial(ColumnSegment &segment, Col
 			scan_state.sel_vec = make_buffer<SelectionVector>(decompress_count);
 		}
 
-		// Scanning 1024 values, emitting a dict vector
+		// Scanning an entire vector, emitting a dict vector
 		data_ptr_t dst = (data_ptr_t)(scan_state.sel_vec->data());
 		data_ptr_t src = (data_ptr_t)&base_data[(start * scan_state.current_width) / 8];
 
-		BitpackingPrimitives::UnPackBuffer<sel_t>(dst, src, scan_count, scan_state.current_width);
+		BitpackingPrimitives::UnPackBuffer<sel_t>(dst, src, decompress_count, scan_state.current_width);
+
+		result.Dictionary(*(scan_state.dictionary), scan_state.dictionary_size, *scan_state.sel_vec, scan_count);
+	}
+}
 
-		result.Slice(*(scan_state.dictionary), *scan_state.sel_vec, scan_count);
+bool DictionaryCompressionStorage::StringFilter(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count,
+                                                SelectionVector &sel, idx_t &approved_tuple_count,
+                                                const TableFilter &filter) {
+	auto &scan_state = (CompressedStringScanState &)*state.scan_state;
+	if (scan_state.entry_filter != &filter) {
+		// the entries that pass are computed once for every filter that is evaluated on the segment
+		scan_state.entry_passes.clear();
+		scan_state.entry_filter = &filter;
 	}
+
+	// unpack the dictionary indices of the rows, without moving the scan forward
+	auto start = segment.GetRelativeIndex(state.row_index);
+	auto baseptr = scan_state.handle->node->buffer + segment.GetBlockOffset();
+	auto base_data = (data_ptr_t)(baseptr + DICTIONARY_HEADER_SIZE);
+	idx_t start_offset = start % BitpackingPrimitives::BITPACKING_ALGORITHM_GROUP_SIZE;
+	idx_t decompress_count = BitpackingPrimitives::RoundUpToAlgorithmGroupSize(scan_count + start_offset);
+	SelectionVector entries(decompress_count);
+	data_ptr_t src = &base_data[((start - start_offset) * scan_state.current_width) / 8];
+	BitpackingPrimitives::UnPackBuffer<sel_t>((data_ptr_t)entries.data(), src, decompress_count,
+	                                          scan_state.current_width);
+
+	// select the rows that reference an entry that passes the filter
+	ColumnSegment::FilterDictionarySelection(sel, approved_tuple_count, entries, start_offset,
+	                                         *scan_state.dictionary, scan_state.dictionary_size, filter,
+	                                         scan_state.entry_passes);
+	return true;
 }
 
 void DictionaryCompressionStorage::StringScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count,
@@ -637,13 +677,15 @@ uint16_t DictionaryCompressionStorage::GetStringLength(uint32_t *index_buffer_pt
 // Get Function
 //===--------------------------------------------------------------------===//
 CompressionFunction DictionaryCompressionFun::GetFunction(PhysicalType data_type) {
-	return CompressionFunction(
+	CompressionFunction function(
 	    CompressionType::COMPRESSION_DICTIONARY, data_type, DictionaryCompressionStorage ::StringInitAnalyze,
 	    DictionaryCompressionStorage::StringAnalyze, DictionaryCompressionStorage::StringFinalAnalyze,
 	    DictionaryCompressionStorage::InitCompression, DictionaryCompressionStorage::Compress,
 	    DictionaryCompressionStorage::FinalizeCompress, DictionaryCompressionStorage::StringInitScan,
 	    DictionaryCompressionStorage::StringScan, DictionaryCompressionStorage::StringScanPartial<false>,
 	    DictionaryCompressionStorage::StringFetchRow, UncompressedFunctions::EmptySkip);
+	function.filter = DictionaryCompressionStorage::StringFilter;
+	return function;
 }
 
 bool DictionaryCompressionFun::TypeIsSupported(PhysicalType type) {
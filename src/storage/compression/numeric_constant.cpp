@@ -84,6 +84,26 @@ void ConstantFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row
 	ConstantFillFunction<T>(segment, result, result_idx, 1);
 }
 
+//===--------------------------------------------------------------------===//
+// Filter
+//===--------------------------------------------------------------------===//
+template <class T>
+bool ConstantFilterFunction(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SelectionVector &sel,
+                            idx_t &approved_tuple_count, const TableFilter &filter) {
+	auto &nstats = (NumericStatistics &)*segment.stats.statistics;
+
+	// evaluate the filter once for the entire segment
+	Vector constant(segment.type, 1);
+	FlatVector::GetData<T>(constant)[0] = nstats.min.GetValueUnsafe<T>();
+	SelectionVector constant_sel;
+	idx_t constant_count = 1;
+	ColumnSegment::FilterSelection(constant_sel, constant, filter, constant_count, FlatVector::Validity(constant));
+	if (constant_count == 0) {
+		approved_tuple_count = 0;
+	}
+	return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Get Function
 //===--------------------------------------------------------------------===//
@@ -96,9 +116,11 @@ CompressionFunction ConstantGetFunctionValidity(PhysicalType data_type) {
 
 template <class T>
 CompressionFunction ConstantGetFunction(PhysicalType data_type) {
-	return CompressionFunction(CompressionType::COMPRESSION_CONSTANT, data_type, nullptr, nullptr, nullptr, nullptr,
-	                           nullptr, nullptr, ConstantInitScan, ConstantScanFunction<T>, ConstantScanPartial<T>,
-	                           ConstantFetchRow<T>, UncompressedFunctions::EmptySkip);
+	CompressionFunction function(CompressionType::COMPRESSION_CONSTANT, data_type, nullptr, nullptr, nullptr, nullptr,
+	                             nullptr, nullptr, ConstantInitScan, ConstantScanFunction<T>, ConstantScanPartial<T>,
+	                             ConstantFetchRow<T>, UncompressedFunctions::EmptySkip);
+	function.filter = ConstantFilterFunction<T>;
+	return function;
 }
 
 CompressionFunction ConstantFun::GetFunction(PhysicalType data_type) {
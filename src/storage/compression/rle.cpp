@@ -323,6 +323,64 @@ void RLEScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, V
 	RLEScanPartial<T>(segment, state, scan_count, result, 0);
 }
 
+//===--------------------------------------------------------------------===//
+// Filter
+//===--------------------------------------------------------------------===//
+template <class T>
+bool RLEFilter(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, SelectionVector &sel,
+               idx_t &approved_tuple_count, const TableFilter &filter) {
+	auto &scan_state = (RLEScanState<T> &)*state.scan_state;
+
+	auto data = scan_state.handle->node->buffer + segment.GetBlockOffset();
+	auto data_pointer = (T *)(data + RLEConstants::RLE_HEADER_SIZE);
+	auto index_pointer = (rle_count_t *)(data + scan_state.rle_count_offset);
+
+	// gather the values of the runs that overlap with the vector, without moving the scan forward
+	Vector run_values(segment.type, scan_count);
+	auto run_data = FlatVector::GetData<T>(run_values);
+	vector<idx_t> run_ends;
+	idx_t entry_pos = scan_state.entry_pos;
+	idx_t position_in_entry = scan_state.position_in_entry;
+	idx_t row_idx = 0;
+	while (row_idx < scan_count) {
+		run_data[run_ends.size()] = data_pointer[entry_pos];
+		row_idx += MinValue<idx_t>(index_pointer[entry_pos] - position_in_entry, scan_count - row_idx);
+		run_ends.push_back(row_idx);
+		entry_pos++;
+		position_in_entry = 0;
+	}
+
+	// evaluate the filter once per run
+	SelectionVector run_sel;
+	idx_t run_count = run_ends.size();
+	ColumnSegment::FilterSelection(run_sel, run_values, filter, run_count, FlatVector::Validity(run_values));
+	if (run_count == run_ends.size()) {
+		// all runs pass the filter
+		return true;
+	}
+	vector<bool> row_passes(scan_count, false);
+	for (idx_t i = 0; i < run_count; i++) {
+		auto run_idx = run_sel.get_index(i);
+		idx_t run_start = run_idx == 0 ? 0 : run_ends[run_idx - 1];
+		for (idx_t row = run_start; row < run_ends[run_idx]; row++) {
+			row_passes[row] = true;
+		}
+	}
+
+	// remove the rows that are in runs that do not pass the filter
+	SelectionVector new_sel(approved_tuple_count);
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		if (row_passes[idx]) {
+			new_sel.set_index(result_count++, idx);
+		}
+	}
+	sel.Initialize(new_sel);
+	approved_tuple_count = result_count;
+	return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Fetch
 //===--------------------------------------------------------------------===//
@@ -342,9 +400,11 @@ void RLEFetchRow(ColumnSegment &segment, ColumnFetchState &state, row_t row_id,
 //===--------------------------------------------------------------------===//
 template <class T>
 CompressionFunction GetRLEFunction(PhysicalType data_type) {
-	return CompressionFunction(CompressionType::COMPRESSION_RLE, data_type, RLEInitAnalyze<T>, RLEAnalyze<T>,
-	                           RLEFinalAnalyze<T>, RLEInitCompression<T>, RLECompress<T>, RLEFinalizeCompress<T>,
-	                           RLEInitScan<T>, RLEScan<T>, RLEScanPartial<T>, RLEFetchRow<T>, RLESkip<T>);
+	CompressionFunction function(CompressionType::COMPRESSION_RLE, data_type, RLEInitAnalyze<T>, RLEAnalyze<T>,
+	                             RLEFinalAnalyze<T>, RLEInitCompression<T>, RLECompress<T>, RLEFinalizeCompress<T>,
+	                             RLEInitScan<T>, RLEScan<T>, RLEScanPartial<T>, RLEFetchRow<T>, RLESkip<T>);
+	function.filter = RLEFilter<T>;
+	return function;
 }
 
 CompressionFunction RLEFun::GetFunction(PhysicalType type) {
@@ -337,10 +337,29 @@ void ValidityScanPartial(ColumnSegment &segment, ColumnScanState &state, idx_t s
 #endif
 }
 
+//! Whether or not all rows in the range [start, start + count) of the segment are valid
+static bool ValidityRangeIsValid(validity_t *input_data, idx_t start, idx_t count) {
+	ValidityMask mask(input_data);
+	for (idx_t i = 0; i < count; i++) {
+		if (!mask.RowIsValidUnsafe(start + i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void ValidityScan(ColumnSegment &segment, ColumnScanState &state, idx_t scan_count, Vector &result) {
+	auto start = segment.GetRelativeIndex(state.row_index);
+	if (result.GetVectorType() == VectorType::DICTIONARY_VECTOR) {
+		// only flatten dictionary vectors if there are NULL values in the scanned range
+		auto &scan_state = (ValidityScanState &)*state.scan_state;
+		auto buffer_ptr = scan_state.handle->node->buffer + segment.GetBlockOffset();
+		if (ValidityRangeIsValid((validity_t *)buffer_ptr, start, scan_count)) {
+			return;
+		}
+	}
 	result.Normalify(scan_count);
 
-	auto start = segment.GetRelativeIndex(state.row_index);
 	if (start % ValidityMask::BITS_PER_VALUE == 0) {
 		auto &scan_state = (ValidityScanState &)*state.scan_state;
 
@@ -6,6 +6,7 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/planner/constraints/list.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/storage/storage_manager.hpp"
@@ -14,6 +15,8 @@
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
+#include "duckdb/storage/table/column_checkpoint_state.hpp"
+#include "duckdb/parallel/task_counter.hpp"
 #include "duckdb/storage/table/standard_column_data.hpp"
 
 #include "duckdb/common/chrono.hpp"
@@ -23,7 +26,7 @@ namespace duckdb {
 DataTable::DataTable(DatabaseInstance &db, const string &schema, const string &table,
                      vector<ColumnDefinition> column_definitions_p, unique_ptr<PersistentTableData> data)
     : info(make_shared<DataTableInfo>(db, schema, table)), column_definitions(move(column_definitions_p)), db(db),
-      total_rows(0), is_root(true) {
+      total_rows(0), direct_append_transaction(MAX_TRANSACTION_ID), is_root(true) {
 	// initialize the table with the existing data from disk, if any
 	this->row_groups = make_shared<SegmentTree>();
 	auto types = GetTypes();
@@ -62,7 +65,8 @@ void DataTable::AppendRowGroup(idx_t start_row) {
 }
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition &new_column, Expression *default_value)
-    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()), is_root(true) {
+    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()),
+      direct_append_transaction(MAX_TRANSACTION_ID), is_root(true) {
 	for (auto &column_def : parent.column_definitions) {
 		column_definitions.emplace_back(column_def.Copy());
 	}
@@ -113,7 +117,8 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, ColumnDefinition
 }
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_column)
-    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()), is_root(true) {
+    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()),
+      direct_append_transaction(MAX_TRANSACTION_ID), is_root(true) {
 	// prevent any new tuples from being added to the parent
 	lock_guard<mutex> parent_lock(parent.append_lock);
 
@@ -162,7 +167,8 @@ DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t removed_co
 
 DataTable::DataTable(ClientContext &context, DataTable &parent, idx_t changed_idx, const LogicalType &target_type,
                      vector<column_t> bound_columns, Expression &cast_expr)
-    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()), is_root(true) {
+    : info(parent.info), db(parent.db), total_rows(parent.total_rows.load()),
+      direct_append_transaction(MAX_TRANSACTION_ID), is_root(true) {
 	// prevent any tuples from being added to the parent
 	lock_guard<mutex> lock(append_lock);
 	for (auto &column_def : parent.column_definitions) {
@@ -617,6 +623,20 @@ void DataTable::VerifyAppendConstraints(TableCatalogEntry &table, ClientContext
 	}
 }
 
+static bool HasNestedColumns(DataChunk &chunk) {
+	for (auto &vector : chunk.data) {
+		switch (vector.GetType().InternalType()) {
+		case PhysicalType::LIST:
+		case PhysicalType::STRUCT:
+		case PhysicalType::MAP:
+			return true;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
 void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk) {
 	if (chunk.size() == 0) {
 		return;
@@ -633,11 +653,64 @@ void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChu
 	// verify any constraints on the new chunk
 	VerifyAppendConstraints(table, context, chunk);
 
-	// append to the transaction local data
 	auto &transaction = Transaction::GetTransaction(context);
+	if (CanAppendDirect(context, transaction)) {
+		// bulk load: write the chunk straight into the row groups of the table
+		// note that the chunk is sliced by Append if it crosses a row group boundary
+		idx_t append_count = chunk.size();
+		TableAppendState append_state;
+		InitializeAppend(transaction, append_state, append_count);
+		if (HasNestedColumns(chunk)) {
+			// lists can share the entries of their child vector (e.g. the result of a CASE), but the storage expects
+			// the child entries of consecutive lists to be consecutive: copying the chunk lays them out that way
+			DataChunk copy;
+			copy.Initialize(chunk.GetTypes());
+			chunk.Copy(copy);
+			Append(transaction, copy, append_state);
+		} else {
+			Append(transaction, chunk, append_state);
+		}
+		transaction.PushAppend(this, append_state.row_start, append_count);
+		return;
+	}
+	// append to the transaction local data
 	transaction.storage.Append(this, chunk);
 }
 
+bool DataTable::CanAppendDirect(ClientContext &context, Transaction &transaction) {
+	// appending to the base table directly is only safe if the transaction consists of only this statement:
+	// later statements in the same transaction (e.g. ALTER TABLE) expect the appended rows in the local storage
+	if (!context.transaction.IsAutoCommit()) {
+		return false;
+	}
+	// indexes are verified against the local storage before being appended to at commit time
+	if (!info->indexes.Empty()) {
+		return false;
+	}
+	// preserve the order of any rows that were already appended to the local storage
+	if (transaction.storage.Find(this)) {
+		return false;
+	}
+	// only one transaction at a time can append directly: the rows of concurrent bulk loads would interleave, and the
+	// rows of a failed bulk load could then not be truncated from the end of the table
+	// the other transactions append to their local storage instead
+	auto owner = direct_append_transaction.load();
+	if (owner == transaction.transaction_id) {
+		return true;
+	}
+	if (owner != MAX_TRANSACTION_ID ||
+	    !direct_append_transaction.compare_exchange_strong(owner, transaction.transaction_id)) {
+		return false;
+	}
+	transaction.direct_appends.push_back(this);
+	return true;
+}
+
+void DataTable::EndDirectAppend(Transaction &transaction) {
+	auto owner = transaction.transaction_id;
+	direct_append_transaction.compare_exchange_strong(owner, MAX_TRANSACTION_ID);
+}
+
 void DataTable::InitializeAppend(Transaction &transaction, TableAppendState &state, idx_t append_count) {
 	// obtain the append lock for this table
 	state.append_lock = unique_lock<mutex>(append_lock);
@@ -784,6 +857,7 @@ void DataTable::RevertAppendInternal(idx_t start_row, idx_t count) {
 		// they will never be used by any other transaction and will essentially leave a gap
 		// this situation is rare, and as such we don't care about optimizing it (yet?)
 		// it only happens if C1 appends a lot of data -> C2 appends a lot of data -> C1 rolls back
+		// direct appends are serialized per table, so C2 can only be the commit of a transaction-local append here
 		return;
 	}
 	// adjust the cardinality
@@ -1267,6 +1341,64 @@ unique_ptr<BaseStatistics> DataTable::GetStatistics(ClientContext &context, colu
 //===--------------------------------------------------------------------===//
 // Checkpoint
 //===--------------------------------------------------------------------===//
+//! The shared state of the tasks that checkpoint the columns of a table
+struct CheckpointTaskState {
+	explicit CheckpointTaskState(TaskScheduler &scheduler) : task_counter(scheduler) {
+	}
+
+	TaskCounter task_counter;
+	//! The first error that occurred in any of the tasks
+	mutex error_lock;
+	ExceptionType error_type = ExceptionType::INVALID;
+	string error_message;
+
+	void PushError(ExceptionType type, const string &message) {
+		lock_guard<mutex> guard(error_lock);
+		if (error_message.empty()) {
+			error_type = type;
+			error_message = message;
+		}
+	}
+};
+
+//! Analyzes and compresses a single column of a run of consecutive row groups
+class CheckpointColumnTask : public Task {
+public:
+	CheckpointColumnTask(CheckpointTaskState &state, TableDataWriter &writer, vector<RowGroup *> row_groups,
+	                     idx_t column_idx, vector<unique_ptr<ColumnCheckpointState> *> results, bool reuse_choices)
+	    : state(state), writer(writer), row_groups(move(row_groups)), column_idx(column_idx), results(move(results)),
+	      reuse_choices(reuse_choices) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		try {
+			// the compression methods are only reused within the run: which row group a choice comes from does not
+			// depend on the order in which the tasks are executed
+			ColumnCompressionChoices previous_choices;
+			for (idx_t i = 0; i < row_groups.size(); i++) {
+				*results[i] =
+				    row_groups[i]->CheckpointColumn(writer, column_idx, reuse_choices ? &previous_choices : nullptr);
+			}
+		} catch (Exception &ex) {
+			state.PushError(ex.type, ex.what());
+		} catch (std::exception &ex) {
+			state.PushError(ExceptionType::UNKNOWN_TYPE, ex.what());
+		} catch (...) { // LCOV_EXCL_START
+			state.PushError(ExceptionType::UNKNOWN_TYPE, "Unknown exception in checkpoint!");
+		} // LCOV_EXCL_STOP
+		state.task_counter.FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+private:
+	CheckpointTaskState &state;
+	TableDataWriter &writer;
+	vector<RowGroup *> row_groups;
+	idx_t column_idx;
+	vector<unique_ptr<ColumnCheckpointState> *> results;
+	bool reuse_choices;
+};
+
 BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
 	// checkpoint each individual row group
 	// FIXME: we might want to combine adjacent row groups in case they have had deletions...
@@ -1275,13 +1407,47 @@ BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
 		global_stats.push_back(BaseStatistics::CreateEmpty(column_definitions[i].type));
 	}
 
+	vector<RowGroup *> row_group_list;
 	auto row_group = (RowGroup *)row_groups->GetRootSegment();
-	vector<RowGroupPointer> row_group_pointers;
 	while (row_group) {
-		auto pointer = row_group->Checkpoint(writer, global_stats);
-		row_group_pointers.push_back(move(pointer));
+		row_group_list.push_back(row_group);
 		row_group = (RowGroup *)row_group->next.get();
 	}
+
+	// analyze and compress the columns of all row groups in parallel
+	// block allocation is serialized by the checkpoint manager, the metadata is written below in row group order
+	vector<vector<unique_ptr<ColumnCheckpointState>>> states(row_group_list.size());
+	for (auto &row_group_states : states) {
+		row_group_states.resize(column_definitions.size());
+	}
+	{
+		// if compression methods are reused, a task checkpoints a column of a fixed run of row groups in order
+		bool reuse_choices = DBConfig::GetConfig(db).compression_reuse_choice;
+		idx_t run_size = reuse_choices ? CHECKPOINT_REUSE_RUN_SIZE : 1;
+		CheckpointTaskState task_state(TaskScheduler::GetScheduler(db));
+		for (idx_t run_start = 0; run_start < row_group_list.size(); run_start += run_size) {
+			idx_t run_end = MinValue<idx_t>(run_start + run_size, row_group_list.size());
+			vector<RowGroup *> run(row_group_list.begin() + run_start, row_group_list.begin() + run_end);
+			for (idx_t column_idx = 0; column_idx < column_definitions.size(); column_idx++) {
+				vector<unique_ptr<ColumnCheckpointState> *> results;
+				for (idx_t row_group_idx = run_start; row_group_idx < run_end; row_group_idx++) {
+					results.push_back(&states[row_group_idx][column_idx]);
+				}
+				task_state.task_counter.AddTask(make_unique<CheckpointColumnTask>(task_state, writer, run, column_idx,
+				                                                                  move(results), reuse_choices));
+			}
+		}
+		task_state.task_counter.Finish();
+		if (!task_state.error_message.empty()) {
+			throw Exception(task_state.error_type, task_state.error_message);
+		}
+	}
+
+	vector<RowGroupPointer> row_group_pointers;
+	for (idx_t row_group_idx = 0; row_group_idx < row_group_list.size(); row_group_idx++) {
+		auto pointer = row_group_list[row_group_idx]->WriteToDisk(writer, states[row_group_idx], global_stats);
+		row_group_pointers.push_back(move(pointer));
+	}
 	// store the current position in the metadata writer
 	// this is where the row groups for this table start
 	auto &meta_writer = writer.GetMetaWriter();
@@ -1298,6 +1464,155 @@ BlockPointer DataTable::Checkpoint(TableDataWriter &writer) {
 	return pointer;
 }
 
+//===--------------------------------------------------------------------===//
+// Vacuum
+//===--------------------------------------------------------------------===//
+bool DataTable::Vacuum(Transaction &transaction) {
+	lock_guard<mutex> lock(append_lock);
+	if (!is_root) {
+		return false;
+	}
+	vector<RowGroup *> row_group_list;
+	vector<idx_t> visible_counts;
+	auto row_group = (RowGroup *)row_groups->GetRootSegment();
+	while (row_group) {
+		row_group_list.push_back(row_group);
+		visible_counts.push_back(row_group->GetVisibleRowCount(transaction));
+		row_group = (RowGroup *)row_group->next.get();
+	}
+	// find the first row group that is worth rewriting: either a sizeable part of its rows is deleted, or it fits
+	// together with the next row group into a single row group
+	// row ids are dense, so every row group after it has to be rewritten as well
+	idx_t rewrite_idx = row_group_list.size();
+	for (idx_t i = 0; i < row_group_list.size(); i++) {
+		idx_t deleted_count = row_group_list[i]->count - visible_counts[i];
+		bool many_deletes = deleted_count > 0 && deleted_count * VACUUM_DELETE_RATIO >= row_group_list[i]->count;
+		bool can_merge =
+		    i + 1 < row_group_list.size() && visible_counts[i] + visible_counts[i + 1] <= RowGroup::ROW_GROUP_SIZE;
+		if (many_deletes || can_merge) {
+			rewrite_idx = i;
+			break;
+		}
+	}
+	if (rewrite_idx == row_group_list.size()) {
+		return false;
+	}
+
+	// scan the visible rows of the row groups that are rewritten, and append them to a new set of row groups
+	auto types = GetTypes();
+	vector<column_t> column_ids;
+	for (idx_t i = 0; i < types.size(); i++) {
+		column_ids.push_back(i);
+	}
+	// the indexes refer to the row ids, which are changed by compacting the table: the rewritten rows are moved to
+	// their new row ids in every index. Deleted rows were already removed from the indexes when their deletes were
+	// cleaned up, so the indexes contain exactly the rows that are scanned here.
+	bool has_indexes = !info->indexes.Empty();
+	auto scan_types = types;
+	if (has_indexes) {
+		column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+		scan_types.push_back(LogicalType::ROW_TYPE);
+	}
+	TableScanState scan_state;
+	InitializeScanWithOffset(scan_state, column_ids, row_group_list[rewrite_idx]->start, total_rows);
+
+	vector<unique_ptr<RowGroup>> new_row_groups;
+	TableAppendState append_state;
+	RowGroup *current_row_group = nullptr;
+	idx_t next_start = row_group_list[rewrite_idx]->start;
+	DataChunk scan_chunk;
+	scan_chunk.Initialize(scan_types);
+	DataChunk chunk;
+	chunk.InitializeEmpty(types);
+	Vector new_row_ids(LogicalType::ROW_TYPE);
+	while (true) {
+		scan_chunk.Reset();
+		ScanBaseTable(transaction, scan_chunk, scan_state);
+		if (scan_chunk.size() == 0) {
+			break;
+		}
+		for (idx_t i = 0; i < types.size(); i++) {
+			chunk.data[i].Reference(scan_chunk.data[i]);
+		}
+		chunk.SetCardinality(scan_chunk);
+		if (has_indexes) {
+			// the rows of the chunk are appended in order, starting at next_start
+			auto &old_row_ids = scan_chunk.data[types.size()];
+			VectorOperations::GenerateSequence(new_row_ids, chunk.size(), next_start, 1);
+			info->indexes.Scan([&](Index &index) {
+				index.Delete(chunk, old_row_ids);
+				if (!index.Append(chunk, new_row_ids)) {
+					throw InternalException("VACUUM failed to move the rows of an index to their new row ids");
+				}
+				return false;
+			});
+		}
+		idx_t remaining = chunk.size();
+		while (remaining > 0) {
+			if (!current_row_group || current_row_group->count == RowGroup::ROW_GROUP_SIZE) {
+				auto new_row_group = make_unique<RowGroup>(db, *info, next_start, 0);
+				new_row_group->InitializeEmpty(types);
+				new_row_group->InitializeAppend(append_state.row_group_append_state);
+				current_row_group = new_row_group.get();
+				new_row_groups.push_back(move(new_row_group));
+			}
+			idx_t append_count = MinValue<idx_t>(remaining, RowGroup::ROW_GROUP_SIZE - current_row_group->count);
+			current_row_group->Append(append_state.row_group_append_state, chunk, append_count);
+			current_row_group->count += append_count;
+			next_start += append_count;
+			remaining -= append_count;
+			if (remaining > 0) {
+				// the row group is full: continue with the rest of the chunk in the next row group
+				SelectionVector sel(STANDARD_VECTOR_SIZE);
+				for (idx_t i = 0; i < remaining; i++) {
+					sel.set_index(i, append_count + i);
+				}
+				chunk.Slice(sel, remaining);
+			}
+		}
+	}
+	if (rewrite_idx == 0 && new_row_groups.empty()) {
+		// every row of the table was deleted: a table always has at least one row group
+		auto new_row_group = make_unique<RowGroup>(db, *info, 0, 0);
+		new_row_group->InitializeEmpty(types);
+		new_row_groups.push_back(move(new_row_group));
+	}
+
+	// the blocks of the replaced row groups can be reused after the next checkpoint
+	for (idx_t i = rewrite_idx; i < row_group_list.size(); i++) {
+		row_group_list[i]->CommitDrop();
+	}
+	{
+		lock_guard<mutex> tree_lock(row_groups->node_lock);
+		row_groups->nodes.erase(row_groups->nodes.begin() + rewrite_idx, row_groups->nodes.end());
+		if (rewrite_idx == 0) {
+			row_groups->root_node.reset();
+		} else {
+			row_group_list[rewrite_idx - 1]->next.reset();
+		}
+		for (auto &new_row_group : new_row_groups) {
+			row_groups->AppendSegment(move(new_row_group));
+		}
+	}
+	total_rows = next_start;
+	// the deleted rows were dropped, and no other transaction can see them
+	info->cardinality = next_start;
+
+	// the deleted rows no longer contribute to the statistics of the table
+	lock_guard<mutex> stats_guard(stats_lock);
+	for (idx_t i = 0; i < types.size(); i++) {
+		column_stats[i] = BaseStatistics::CreateEmpty(types[i]);
+	}
+	row_group = (RowGroup *)row_groups->GetRootSegment();
+	while (row_group) {
+		for (idx_t i = 0; i < types.size(); i++) {
+			column_stats[i]->Merge(*row_group->GetStatistics(i));
+		}
+		row_group = (RowGroup *)row_group->next.get();
+	}
+	return true;
+}
+
 void DataTable::CommitDropColumn(idx_t index) {
 	auto segment = (RowGroup *)row_groups->GetRootSegment();
 	while (segment) {
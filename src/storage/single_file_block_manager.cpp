@@ -221,6 +221,7 @@ bool SingleFileBlockManager::IsRootBlock(block_id_t root) {
 }
 
 block_id_t SingleFileBlockManager::GetFreeBlockId() {
+	lock_guard<mutex> guard(block_lock);
 	block_id_t block;
 	if (!free_list.empty()) {
 		// free list is non empty
@@ -236,6 +237,7 @@ block_id_t SingleFileBlockManager::GetFreeBlockId() {
 
 void SingleFileBlockManager::MarkBlockAsModified(block_id_t block_id) {
 	D_ASSERT(block_id >= 0);
+	lock_guard<mutex> guard(block_lock);
 
 	// check if the block is a multi-use block
 	auto entry = multi_use_blocks.find(block_id);
@@ -253,6 +255,7 @@ void SingleFileBlockManager::MarkBlockAsModified(block_id_t block_id) {
 }
 
 void SingleFileBlockManager::IncreaseBlockReferenceCount(block_id_t block_id) {
+	lock_guard<mutex> guard(block_lock);
 	D_ASSERT(free_list.find(block_id) == free_list.end());
 	auto entry = multi_use_blocks.find(block_id);
 	if (entry != multi_use_blocks.end()) {
@@ -336,6 +339,14 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	// set the iteration count
 	header.iteration = ++iteration_count;
 
+	// blocks that were already free before this checkpoint are not used by the previous header either
+	// if they are at the end of the file, we can drop them from the file entirely
+	idx_t previous_block_count = max_block;
+	while (!free_list.empty() && *free_list.rbegin() == max_block - 1) {
+		free_list.erase(std::prev(free_list.end()));
+		max_block--;
+	}
+
 	vector<block_id_t> free_list_blocks = GetFreeListBlocks();
 
 	// now handle the free list
@@ -396,6 +407,10 @@ void SingleFileBlockManager::WriteHeader(DatabaseHeader header) {
 	active_header = 1 - active_header;
 	//! Ensure the header write ends up on disk
 	handle->Sync();
+	if ((idx_t)max_block < previous_block_count) {
+		// the new header no longer references the blocks at the end of the file: truncate them
+		handle->Truncate(BLOCK_START + max_block * Storage::BLOCK_ALLOC_SIZE);
+	}
 }
 
 } // namespace duckdb
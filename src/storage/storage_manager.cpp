@@ -1,4 +1,5 @@
 #include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/block_manager.hpp"
 #include "duckdb/storage/checkpoint_manager.hpp"
 #include "duckdb/storage/in_memory_block_manager.hpp"
 #include "duckdb/storage/single_file_block_manager.hpp"
@@ -141,4 +142,32 @@ void StorageManager::CreateCheckpoint(bool delete_wal, bool force_checkpoint) {
 	}
 }
 
+void StorageManager::VacuumCheckpoint() {
+	if (InMemory() || read_only || !wal.initialized) {
+		return;
+	}
+	// write the compacted tables: this frees the blocks of the row groups they replaced
+	{
+		CheckpointManager checkpointer(db);
+		checkpointer.CreateCheckpoint();
+	}
+	auto &block_manager = BlockManager::GetBlockManager(db);
+	idx_t used_blocks = block_manager.TotalBlocks() - block_manager.FreeBlocks();
+	if (used_blocks == block_manager.TotalBlocks()) {
+		// no holes in the file
+		return;
+	}
+	// rewrite all data stored past the number of blocks that are in use: new blocks are taken from the start of the
+	// free list, so the data moves into the holes at the start of the file
+	{
+		CheckpointManager checkpointer(db);
+		checkpointer.relocate_block_threshold = used_blocks;
+		checkpointer.CreateCheckpoint();
+	}
+	// blocks only become free once the header of the checkpoint that stopped using them has been written
+	// checkpoint one more time so that the moved blocks are truncated from the end of the file
+	CheckpointManager checkpointer(db);
+	checkpointer.CreateCheckpoint();
+}
+
 } // namespace duckdb
@@ -21,6 +21,20 @@ ColumnCheckpointState::ColumnCheckpointState(RowGroup &row_group, ColumnData &co
 ColumnCheckpointState::~ColumnCheckpointState() {
 }
 
+void ColumnCheckpointState::AssignVectorStatistics(ColumnSegment &segment) {
+	segment.stats.vector_statistics.clear();
+	idx_t segment_start = segment.start - row_group.start;
+	idx_t segment_end = segment_start + segment.count;
+	idx_t vector_idx = (segment_start + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	for (; vector_idx < vector_stats.size(); vector_idx++) {
+		idx_t vector_end = MinValue<idx_t>((vector_idx + 1) * STANDARD_VECTOR_SIZE, vector_stats_count);
+		if (vector_end > segment_end) {
+			break;
+		}
+		segment.stats.vector_statistics.push_back(vector_stats[vector_idx]->Copy());
+	}
+}
+
 void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_t segment_size) {
 	D_ASSERT(segment_size <= Storage::BLOCK_SIZE);
 	auto tuple_count = segment->count.load();
@@ -30,6 +44,7 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 
 	// merge the segment stats into the global stats
 	global_stats->Merge(*segment->stats.statistics);
+	AssignVectorStatistics(*segment);
 
 	// get the buffer of the segment and pin it
 	auto &db = column_data.GetDatabase();
@@ -39,6 +54,9 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 
 	bool block_is_constant = segment->stats.statistics->IsConstant();
 
+	// columns are compressed in parallel, but the segments are placed into blocks one at a time
+	lock_guard<mutex> block_guard(checkpoint_manager.block_lock);
+
 	block_id_t block_id = INVALID_BLOCK;
 	uint32_t offset_in_block = 0;
 	bool need_to_write = true;
@@ -88,6 +106,9 @@ void ColumnCheckpointState::FlushSegment(unique_ptr<ColumnSegment> segment, idx_
 	data_pointer.tuple_count = tuple_count;
 	data_pointer.compression_type = segment->function->type;
 	data_pointer.statistics = segment->stats.statistics->Copy();
+	for (auto &stats : segment->stats.vector_statistics) {
+		data_pointer.vector_statistics.push_back(stats->Copy());
+	}
 
 	if (need_to_write) {
 		if (partial_block) {
@@ -125,6 +146,11 @@ void ColumnCheckpointState::FlushToDisk() {
 		meta_writer.Write<uint32_t>(data_pointer.block_pointer.offset);
 		meta_writer.Write<CompressionType>(data_pointer.compression_type);
 		data_pointer.statistics->Serialize(meta_writer);
+		meta_writer.Write<idx_t>(STANDARD_VECTOR_SIZE);
+		meta_writer.Write<idx_t>(data_pointer.vector_statistics.size());
+		for (auto &stats : data_pointer.vector_statistics) {
+			stats->Serialize(meta_writer);
+		}
 	}
 }
 
@@ -4,6 +4,7 @@
 #include "duckdb/storage/data_pointer.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
 #include "duckdb/planner/table_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/storage/table/struct_column_data.hpp"
 #include "duckdb/storage/table/list_column_data.hpp"
@@ -15,7 +16,8 @@
 namespace duckdb {
 
 ColumnData::ColumnData(DataTableInfo &info, idx_t column_index, idx_t start_row, LogicalType type, ColumnData *parent)
-    : info(info), column_index(column_index), start(start_row), type(move(type)), parent(parent) {
+    : info(info), column_index(column_index), start(start_row), type(move(type)), parent(parent),
+      has_updates(false) {
 }
 
 ColumnData::~ColumnData() {
@@ -55,7 +57,8 @@ void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx)
 	state.initialized = false;
 }
 
-idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remaining) {
+void ColumnData::BeginScanVector(ColumnScanState &state) {
+	state.previous_states.clear();
 	if (!state.initialized) {
 		D_ASSERT(state.current);
 		state.current->InitializeScan(state);
@@ -66,6 +69,10 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 	if (state.internal_index < state.row_index) {
 		state.current->Skip(state);
 	}
+}
+
+idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remaining) {
+	BeginScanVector(state);
 	D_ASSERT(state.current->type == type);
 	idx_t initial_remaining = remaining;
 	while (remaining > 0) {
@@ -73,6 +80,10 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 		         state.row_index <= state.current->start + state.current->count);
 		idx_t scan_count = MinValue<idx_t>(remaining, state.current->start + state.current->count - state.row_index);
 		idx_t result_offset = initial_remaining - remaining;
+		if (scan_count != initial_remaining && result.GetVectorType() != VectorType::FLAT_VECTOR) {
+			// partial scans write into a flat vector: e.g. the validity of a column that was scanned as a dictionary
+			result.Normalify(initial_remaining);
+		}
 		state.current->Scan(state, scan_count, result, result_offset, scan_count == initial_remaining);
 
 		state.row_index += scan_count;
@@ -81,6 +92,8 @@ idx_t ColumnData::ScanVector(ColumnScanState &state, Vector &result, idx_t remai
 			if (!state.current->next) {
 				break;
 			}
+			// keep the previous segment pinned: the result can still reference its data
+			state.previous_states.push_back(move(state.scan_state));
 			state.current = (ColumnSegment *)state.current->next.get();
 			state.current->InitializeScan(state);
 			state.segment_checked = false;
@@ -152,9 +165,89 @@ idx_t ColumnData::ScanCount(ColumnScanState &state, Vector &result, idx_t count)
 	return ScanVector(state, result, count);
 }
 
+//! Removes the rows that are NULL from the selection
+static void FilterNullSelection(Vector &result, idx_t scan_count, SelectionVector &sel, idx_t &count) {
+	VectorData vdata;
+	result.Orrify(scan_count, vdata);
+	if (vdata.validity.AllValid()) {
+		return;
+	}
+	SelectionVector new_sel(count);
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = sel.get_index(i);
+		if (vdata.validity.RowIsValid(vdata.sel->get_index(idx))) {
+			new_sel.set_index(result_count++, idx);
+		}
+	}
+	sel.Initialize(new_sel);
+	count = result_count;
+}
+
+//! Whether or not a filter can be evaluated on the compressed data: the compressed data does not include the validity
+//! of the rows, which is fine as long as the filter never passes for NULL values
+static bool FilterRejectsNulls(const TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		return true;
+	case TableFilterType::CONJUNCTION_AND:
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction = (ConjunctionFilter &)filter;
+		for (auto &child_filter : conjunction.child_filters) {
+			if (!FilterRejectsNulls(*child_filter)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+bool ColumnData::FilterCompressed(ColumnScanState &state, SelectionVector &sel, idx_t &approved_tuple_count,
+                                  const TableFilter &filter) {
+	if (!state.current || !state.current->function->filter || !FilterRejectsNulls(filter)) {
+		return false;
+	}
+	if (has_updates) {
+		// the compressed data does not reflect the updates
+		return false;
+	}
+	// the vector has to be stored entirely within the current segment
+	auto segment_end = state.current->start + state.current->count;
+	if (state.row_index + STANDARD_VECTOR_SIZE > segment_end && state.current->next) {
+		return false;
+	}
+	D_ASSERT(state.row_index < segment_end);
+	idx_t scan_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, segment_end - state.row_index);
+	BeginScanVector(state);
+	return state.current->Filter(state, scan_count, sel, approved_tuple_count, filter);
+}
+
 void ColumnData::Select(Transaction &transaction, idx_t vector_index, ColumnScanState &state, Vector &result,
                         SelectionVector &sel, idx_t &count, const TableFilter &filter) {
+	if (FilterCompressed(state, sel, count, filter)) {
+		if (count == 0) {
+			// none of the rows can pass the filter: skip scanning the vector entirely
+			Skip(state);
+			return;
+		}
+		// the filter was evaluated on the compressed data, which does not include the validity of the rows
+		idx_t scan_count = Scan(transaction, vector_index, state, result);
+		FilterNullSelection(result, scan_count, sel, count);
+		return;
+	}
 	idx_t scan_count = Scan(transaction, vector_index, state, result);
+	if (result.GetVectorType() == VectorType::DICTIONARY_VECTOR &&
+	    DictionaryVector::DictionarySize(result) < scan_count) {
+		// evaluate the filter once for every dictionary entry instead of once for every row
+		vector<bool> entry_passes;
+		ColumnSegment::FilterDictionarySelection(sel, count, DictionaryVector::SelVector(result), 0,
+		                                         DictionaryVector::Child(result),
+		                                         DictionaryVector::DictionarySize(result), filter, entry_passes);
+		return;
+	}
 	result.Normalify(scan_count);
 	ColumnSegment::FilterSelection(sel, result, filter, count, FlatVector::Validity(result));
 }
@@ -171,6 +264,38 @@ void ColumnData::FilterScanCommitted(idx_t vector_index, ColumnScanState &state,
 	result.Slice(sel, count);
 }
 
+bool ColumnData::CheckVectorZonemap(ColumnScanState &state, TableFilter &filter) {
+	auto segment = state.current;
+	if (segment && state.row_index >= segment->start + segment->count) {
+		// the previous vector ended exactly at the end of the current segment
+		segment = (ColumnSegment *)segment->next.get();
+	}
+	if (!segment || segment->stats.vector_statistics.empty()) {
+		return true;
+	}
+	if (has_updates) {
+		// the statistics do not reflect the updates
+		return true;
+	}
+	// the statistics only cover the vectors that are stored entirely within the segment
+	idx_t vector_start = state.row_index - start;
+	idx_t segment_start = segment->start - start;
+	idx_t segment_end = segment_start + segment->count;
+	if (vector_start % STANDARD_VECTOR_SIZE != 0 || vector_start < segment_start ||
+	    (vector_start + STANDARD_VECTOR_SIZE > segment_end && segment->next)) {
+		return true;
+	}
+	idx_t vector_idx =
+	    vector_start / STANDARD_VECTOR_SIZE - (segment_start + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	auto &vector_stats = segment->stats.vector_statistics;
+	if (vector_idx >= vector_stats.size()) {
+		return true;
+	}
+	auto prune_result = filter.CheckStatistics(*vector_stats[vector_idx]);
+	return prune_result != FilterPropagateResult::FILTER_ALWAYS_FALSE &&
+	       prune_result != FilterPropagateResult::FILTER_FALSE_OR_NULL;
+}
+
 void ColumnData::Skip(ColumnScanState &state, idx_t count) {
 	state.Next(count);
 }
@@ -302,6 +427,7 @@ void ColumnData::Update(Transaction &transaction, idx_t column_index, Vector &up
 	lock_guard<mutex> update_guard(update_lock);
 	if (!updates) {
 		updates = make_unique<UpdateSegment>(*this);
+		has_updates = true;
 	}
 	Vector base_vector(type);
 	ColumnScanState state;
@@ -389,12 +515,22 @@ void ColumnData::DeserializeColumn(Deserializer &source) {
 		data_pointer.block_pointer.offset = source.Read<uint32_t>();
 		data_pointer.compression_type = source.Read<CompressionType>();
 		data_pointer.statistics = BaseStatistics::Deserialize(source, type);
+		auto vector_size = source.Read<idx_t>();
+		auto vector_stats_count = source.Read<idx_t>();
+		for (idx_t i = 0; i < vector_stats_count; i++) {
+			data_pointer.vector_statistics.push_back(BaseStatistics::Deserialize(source, type));
+		}
+		if (vector_size != STANDARD_VECTOR_SIZE) {
+			// the vector statistics were written with a different vector size: they cannot be used
+			data_pointer.vector_statistics.clear();
+		}
 
 		// create a persistent segment
 		auto segment = ColumnSegment::CreatePersistentSegment(
 		    GetDatabase(), data_pointer.block_pointer.block_id, data_pointer.block_pointer.offset, type,
 		    data_pointer.row_start, data_pointer.tuple_count, data_pointer.compression_type,
 		    move(data_pointer.statistics));
+		segment->stats.vector_statistics = move(data_pointer.vector_statistics);
 		data.AppendSegment(move(segment));
 	}
 }
@@ -2,16 +2,42 @@
 #include "duckdb/main/config.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/checkpoint/table_data_writer.hpp"
 #include "duckdb/parser/column_definition.hpp"
+#include "duckdb/storage/statistics/numeric_statistics.hpp"
+#include "duckdb/storage/statistics/string_statistics.hpp"
+
 namespace duckdb {
 
+//! Whether or not the statistics of a type can be used to prune vectors with table filters
+static bool TypeSupportsVectorStatistics(const LogicalType &type) {
+	switch (type.InternalType()) {
+	case PhysicalType::INT8:
+	case PhysicalType::INT16:
+	case PhysicalType::INT32:
+	case PhysicalType::INT64:
+	case PhysicalType::INT128:
+	case PhysicalType::UINT8:
+	case PhysicalType::UINT16:
+	case PhysicalType::UINT32:
+	case PhysicalType::UINT64:
+	case PhysicalType::FLOAT:
+	case PhysicalType::DOUBLE:
+	case PhysicalType::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
 ColumnDataCheckpointer::ColumnDataCheckpointer(ColumnData &col_data_p, RowGroup &row_group_p,
                                                ColumnCheckpointState &state_p, ColumnCheckpointInfo &checkpoint_info_p)
     : col_data(col_data_p), row_group(row_group_p), state(state_p),
       is_validity(GetType().id() == LogicalTypeId::VALIDITY),
       intermediate(is_validity ? LogicalType::BOOLEAN : GetType(), true, is_validity),
-      checkpoint_info(checkpoint_info_p) {
+      checkpoint_info(checkpoint_info_p), gather_vector_stats(false), vector_count(0) {
 	auto &config = DBConfig::GetConfig(GetDatabase());
+	gather_vector_stats = config.vector_statistics && !is_validity && TypeSupportsVectorStatistics(GetType());
 	compression_functions = config.GetCompressionFunctions(GetType().InternalType());
 }
 
@@ -35,26 +61,66 @@ ColumnCheckpointState &ColumnDataCheckpointer::GetCheckpointState() {
 	return state;
 }
 
-void ColumnDataCheckpointer::ScanSegments(const std::function<void(Vector &, idx_t)> &callback) {
+void ColumnDataCheckpointer::ScanSegments(const std::function<void(Vector &, idx_t)> &callback,
+                                          const std::function<bool(idx_t)> &scan_vector_filter) {
 	Vector scan_vector(intermediate.GetType(), nullptr);
+	idx_t vector_index = 0;
 	for (auto segment = (ColumnSegment *)owned_segment.get(); segment; segment = (ColumnSegment *)segment->next.get()) {
 		ColumnScanState scan_state;
 		scan_state.current = segment;
 		segment->InitializeScan(scan_state);
+		scan_state.internal_index = segment->start;
 
 		for (idx_t base_row_index = 0; base_row_index < segment->count; base_row_index += STANDARD_VECTOR_SIZE) {
+			if (scan_vector_filter && !scan_vector_filter(vector_index++)) {
+				continue;
+			}
 			scan_vector.Reference(intermediate);
 
 			idx_t count = MinValue<idx_t>(segment->count - base_row_index, STANDARD_VECTOR_SIZE);
 			scan_state.row_index = segment->start + base_row_index;
+			if (scan_state.internal_index < scan_state.row_index) {
+				// vectors were skipped
+				segment->Skip(scan_state);
+			}
 
 			col_data.CheckpointScan(segment, scan_state, row_group.start, count, scan_vector);
+			scan_state.internal_index = scan_state.row_index + count;
 
 			callback(scan_vector, count);
 		}
 	}
 }
 
+//! The path of a (nested) column from the table, e.g. the validity of the second child of a struct column
+static string GetColumnPath(ColumnData &column) {
+	string result;
+	for (auto current = &column; current; current = current->parent) {
+		result += std::to_string(current->column_index) + ":" + LogicalTypeIdToString(current->type.id()) + "/";
+	}
+	return result;
+}
+
+bool ColumnDataCheckpointer::GetPreviousCompression(CompressionType &result) {
+	if (!checkpoint_info.previous_choices) {
+		return false;
+	}
+	auto &methods = checkpoint_info.previous_choices->methods;
+	auto entry = methods.find(GetColumnPath(col_data));
+	if (entry == methods.end()) {
+		return false;
+	}
+	result = entry->second;
+	return true;
+}
+
+void ColumnDataCheckpointer::SetPreviousCompression(idx_t compression_idx) {
+	if (!checkpoint_info.previous_choices || compression_idx == DConstants::INVALID_INDEX) {
+		return;
+	}
+	checkpoint_info.previous_choices->methods[GetColumnPath(col_data)] = compression_functions[compression_idx]->type;
+}
+
 void ForceCompression(vector<CompressionFunction *> &compression_functions, CompressionType compression_type) {
 	// On of the force_compression flags has been set
 	// check if this compression method is available
@@ -88,38 +154,69 @@ unique_ptr<AnalyzeState> ColumnDataCheckpointer::DetectBestCompressionMethod(idx
 	    config.force_compression != CompressionType::COMPRESSION_AUTO) {
 		ForceCompression(compression_functions, config.force_compression);
 	}
-	// set up the analyze states for each compression method
-	vector<unique_ptr<AnalyzeState>> analyze_states;
-	analyze_states.reserve(compression_functions.size());
-	for (idx_t i = 0; i < compression_functions.size(); i++) {
-		if (!compression_functions[i]) {
-			analyze_states.push_back(nullptr);
-			continue;
+	idx_t candidate_count = 0;
+	for (auto &function : compression_functions) {
+		if (function) {
+			candidate_count++;
+		}
+	}
+	CompressionType previous_type;
+	if (candidate_count > 1 && config.compression_reuse_choice && GetPreviousCompression(previous_type)) {
+		// reuse the method chosen for the previous row group of this column, unless it cannot compress this data
+		auto analyze_state = AnalyzeSingleMethod(previous_type, compression_idx);
+		if (analyze_state) {
+			return analyze_state;
 		}
-		analyze_states.push_back(compression_functions[i]->init_analyze(col_data, col_data.type.InternalType()));
 	}
 
-	// scan over all the segments and run the analyze step
-	ScanSegments([&](Vector &scan_vector, idx_t count) {
-		for (idx_t i = 0; i < compression_functions.size(); i++) {
-			if (!compression_functions[i]) {
-				continue;
-			}
-			auto success = compression_functions[i]->analyze(*analyze_states[i], scan_vector, count);
-			if (!success) {
-				// could not use this compression function on this data set
-				// erase it
-				compression_functions[i] = nullptr;
-				analyze_states[i].reset();
+	idx_t sample_stride = 1;
+	if (candidate_count > 1 && config.compression_sample_rate < 1) {
+		sample_stride = MaxValue<idx_t>(idx_t(1 / config.compression_sample_rate + 0.5), 1);
+	}
+	vector<unique_ptr<AnalyzeState>> analyze_states;
+	AnalyzeVectors(compression_functions, analyze_states, sample_stride, false);
+
+	// now that we have passed over the data, we need to figure out the best method
+	// we do this using the final_analyze method
+	idx_t best_score;
+	idx_t second_best_score;
+	compression_idx = ChooseCompressionMethod(analyze_states, best_score, second_best_score);
+	if (sample_stride > 1 && compression_idx != DConstants::INVALID_INDEX) {
+		// the method was chosen on a sample, but compression requires a method that can compress every vector: the
+		// analysis of the sample is continued with the vectors outside of it
+		auto confidence_score = double(best_score) * (1 + config.compression_confidence_threshold);
+		bool confident = second_best_score == NumericLimits<idx_t>::Maximum() ||
+		                 double(second_best_score) >= confidence_score;
+		if (confident) {
+			// the method won by a large enough margin: only analyze the remaining vectors with that method
+			vector<CompressionFunction *> functions(compression_functions.size(), nullptr);
+			functions[compression_idx] = compression_functions[compression_idx];
+			AnalyzeVectors(functions, analyze_states, sample_stride, true);
+			if (functions[compression_idx]) {
+				compression_functions[compression_idx]->final_analyze(*analyze_states[compression_idx]);
+				SetPreviousCompression(compression_idx);
+				return move(analyze_states[compression_idx]);
 			}
+			// the method cannot compress the vectors outside the sample
+			compression_functions[compression_idx] = nullptr;
+			analyze_states[compression_idx].reset();
 		}
-	});
+		// choose between the remaining methods on all vectors
+		AnalyzeVectors(compression_functions, analyze_states, sample_stride, true);
+		compression_idx = ChooseCompressionMethod(analyze_states, best_score, second_best_score);
+	}
+	SetPreviousCompression(compression_idx);
+	if (compression_idx == DConstants::INVALID_INDEX) {
+		return nullptr;
+	}
+	return move(analyze_states[compression_idx]);
+}
 
-	// now that we have passed over all the data, we need to figure out the best method
-	// we do this using the final_analyze method
-	unique_ptr<AnalyzeState> state;
-	compression_idx = DConstants::INVALID_INDEX;
-	idx_t best_score = NumericLimits<idx_t>::Maximum();
+idx_t ColumnDataCheckpointer::ChooseCompressionMethod(vector<unique_ptr<AnalyzeState>> &analyze_states,
+                                                      idx_t &best_score, idx_t &second_best_score) {
+	idx_t compression_idx = DConstants::INVALID_INDEX;
+	best_score = NumericLimits<idx_t>::Maximum();
+	second_best_score = NumericLimits<idx_t>::Maximum();
 	for (idx_t i = 0; i < compression_functions.size(); i++) {
 		if (!compression_functions[i]) {
 			continue;
@@ -127,11 +224,78 @@ unique_ptr<AnalyzeState> ColumnDataCheckpointer::DetectBestCompressionMethod(idx
 		auto score = compression_functions[i]->final_analyze(*analyze_states[i]);
 		if (score < best_score) {
 			compression_idx = i;
+			second_best_score = best_score;
 			best_score = score;
-			state = move(analyze_states[i]);
+		} else if (score < second_best_score) {
+			second_best_score = score;
 		}
 	}
-	return state;
+	return compression_idx;
+}
+
+void ColumnDataCheckpointer::AnalyzeVectors(vector<CompressionFunction *> &functions,
+                                            vector<unique_ptr<AnalyzeState>> &analyze_states, idx_t sample_stride,
+                                            bool skip_sample) {
+	if (analyze_states.empty()) {
+		// set up the analyze states for each compression method
+		analyze_states.reserve(functions.size());
+		for (idx_t i = 0; i < functions.size(); i++) {
+			if (!functions[i]) {
+				analyze_states.push_back(nullptr);
+				continue;
+			}
+			analyze_states.push_back(functions[i]->init_analyze(col_data, col_data.type.InternalType()));
+		}
+	}
+
+	// scan over the vectors inside (or outside) the sample and run the analyze step, the other vectors are not scanned
+	std::function<bool(idx_t)> scan_vector_filter;
+	if (sample_stride > 1) {
+		scan_vector_filter = [&](idx_t vector_index) {
+			return (vector_index % sample_stride == 0) != skip_sample;
+		};
+	}
+	ScanSegments(
+	    [&](Vector &scan_vector, idx_t count) {
+		    for (idx_t i = 0; i < functions.size(); i++) {
+			    if (!functions[i]) {
+				    continue;
+			    }
+			    auto success = functions[i]->analyze(*analyze_states[i], scan_vector, count);
+			    if (!success) {
+				    // could not use this compression function on this data set
+				    // erase it
+				    functions[i] = nullptr;
+				    analyze_states[i].reset();
+			    }
+		    }
+	    },
+	    scan_vector_filter);
+}
+
+unique_ptr<AnalyzeState> ColumnDataCheckpointer::AnalyzeSingleMethod(CompressionType type, idx_t &compression_idx) {
+	vector<CompressionFunction *> functions(compression_functions.size(), nullptr);
+	compression_idx = DConstants::INVALID_INDEX;
+	for (idx_t i = 0; i < compression_functions.size(); i++) {
+		if (compression_functions[i] && compression_functions[i]->type == type) {
+			functions[i] = compression_functions[i];
+			compression_idx = i;
+		}
+	}
+	if (compression_idx == DConstants::INVALID_INDEX) {
+		return nullptr;
+	}
+	vector<unique_ptr<AnalyzeState>> analyze_states;
+	AnalyzeVectors(functions, analyze_states, 1, false);
+	if (!functions[compression_idx]) {
+		// the method cannot compress all vectors: it can not be used for this column at all
+		compression_functions[compression_idx] = nullptr;
+		compression_idx = DConstants::INVALID_INDEX;
+		return nullptr;
+	}
+	// the analyze step has to be finalized before compressing, like in a regular analysis
+	compression_functions[compression_idx]->final_analyze(*analyze_states[compression_idx]);
+	return move(analyze_states[compression_idx]);
 }
 
 void ColumnDataCheckpointer::WriteToDisk() {
@@ -164,14 +328,122 @@ void ColumnDataCheckpointer::WriteToDisk() {
 	// now that we have analyzed the compression functions we can start writing to disk
 	auto best_function = compression_functions[compression_idx];
 	auto compress_state = best_function->init_compression(*this, move(analyze_state));
-	ScanSegments(
-	    [&](Vector &scan_vector, idx_t count) { best_function->compress(*compress_state, scan_vector, count); });
+	ScanSegments([&](Vector &scan_vector, idx_t count) {
+		// the vector statistics are gathered before compressing, as compressing can flush segments
+		UpdateVectorStatistics(scan_vector, count);
+		best_function->compress(*compress_state, scan_vector, count);
+	});
+	FlushVectorStatistics();
 	best_function->compress_finalize(*compress_state);
 
 	// now we actually write the data to disk
 	owned_segment.reset();
 }
 
+template <class T>
+static void UpdateNumericVectorStatistics(SegmentStatistics &stats, VectorData &vdata, idx_t offset, idx_t count) {
+	auto data = (T *)vdata.data;
+	auto &validity_stats = (ValidityStatistics &)*stats.statistics->validity_stats;
+	for (idx_t i = offset; i < offset + count; i++) {
+		auto idx = vdata.sel->get_index(i);
+		if (!vdata.validity.RowIsValid(idx)) {
+			validity_stats.has_null = true;
+			continue;
+		}
+		validity_stats.has_no_null = true;
+		NumericStatistics::Update<T>(stats, data[idx]);
+	}
+}
+
+static void UpdateStringVectorStatistics(SegmentStatistics &stats, VectorData &vdata, idx_t offset, idx_t count) {
+	auto data = (string_t *)vdata.data;
+	auto &string_stats = (StringStatistics &)*stats.statistics;
+	auto &validity_stats = (ValidityStatistics &)*stats.statistics->validity_stats;
+	for (idx_t i = offset; i < offset + count; i++) {
+		auto idx = vdata.sel->get_index(i);
+		if (!vdata.validity.RowIsValid(idx)) {
+			validity_stats.has_null = true;
+			continue;
+		}
+		validity_stats.has_no_null = true;
+		string_stats.Update(data[idx]);
+	}
+}
+
+void ColumnDataCheckpointer::UpdateVectorStatistics(Vector &scan_vector, idx_t count) {
+	if (!gather_vector_stats) {
+		return;
+	}
+	VectorData vdata;
+	scan_vector.Orrify(count, vdata);
+	idx_t offset = 0;
+	while (offset < count) {
+		if (!vector_stats) {
+			vector_stats = make_unique<SegmentStatistics>(GetType());
+			auto &validity_stats = (ValidityStatistics &)*vector_stats->statistics->validity_stats;
+			validity_stats.has_null = false;
+			validity_stats.has_no_null = false;
+		}
+		// the scanned vectors are not necessarily aligned with the vectors of the row group
+		idx_t update_count = MinValue<idx_t>(count - offset, STANDARD_VECTOR_SIZE - vector_count);
+		switch (GetType().InternalType()) {
+		case PhysicalType::INT8:
+			UpdateNumericVectorStatistics<int8_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::INT16:
+			UpdateNumericVectorStatistics<int16_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::INT32:
+			UpdateNumericVectorStatistics<int32_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::INT64:
+			UpdateNumericVectorStatistics<int64_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::INT128:
+			UpdateNumericVectorStatistics<hugeint_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::UINT8:
+			UpdateNumericVectorStatistics<uint8_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::UINT16:
+			UpdateNumericVectorStatistics<uint16_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::UINT32:
+			UpdateNumericVectorStatistics<uint32_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::UINT64:
+			UpdateNumericVectorStatistics<uint64_t>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::FLOAT:
+			UpdateNumericVectorStatistics<float>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::DOUBLE:
+			UpdateNumericVectorStatistics<double>(*vector_stats, vdata, offset, update_count);
+			break;
+		case PhysicalType::VARCHAR:
+			UpdateStringVectorStatistics(*vector_stats, vdata, offset, update_count);
+			break;
+		default:
+			throw InternalException("Unsupported type for vector statistics");
+		}
+		offset += update_count;
+		vector_count += update_count;
+		if (vector_count == STANDARD_VECTOR_SIZE) {
+			FlushVectorStatistics();
+		}
+	}
+}
+
+void ColumnDataCheckpointer::FlushVectorStatistics() {
+	if (!vector_stats) {
+		return;
+	}
+	state.vector_stats.push_back(move(vector_stats->statistics));
+	state.vector_stats_count += vector_count;
+	vector_stats.reset();
+	vector_count = 0;
+}
+
 bool ColumnDataCheckpointer::HasChanges() {
 	for (auto segment = (ColumnSegment *)owned_segment.get(); segment; segment = (ColumnSegment *)segment->next.get()) {
 		if (segment->segment_type == ColumnSegmentType::TRANSIENT) {
@@ -179,6 +451,11 @@ bool ColumnDataCheckpointer::HasChanges() {
 			return true;
 		} else {
 			// persistent segment; check if there were any updates or deletions in this segment
+			auto &checkpoint_manager = state.writer.GetCheckpointManager();
+			if (segment->GetBlockId() >= checkpoint_manager.relocate_block_threshold) {
+				// the segment is moved to another block
+				return true;
+			}
 			idx_t start_row_idx = segment->start - row_group.start;
 			idx_t end_row_idx = start_row_idx + segment->count;
 			if (col_data.updates && col_data.updates->HasUpdates(start_row_idx, end_row_idx)) {
@@ -206,6 +483,9 @@ void ColumnDataCheckpointer::WritePersistentSegments() {
 		pointer.tuple_count = segment->count;
 		pointer.compression_type = segment->function->type;
 		pointer.statistics = segment->stats.statistics->Copy();
+		for (auto &stats : segment->stats.vector_statistics) {
+			pointer.vector_statistics.push_back(stats->Copy());
+		}
 
 		// merge the persistent stats into the global column stats
 		state.global_stats->Merge(*segment->stats.statistics);
@@ -99,6 +99,14 @@ void ColumnSegment::ScanPartial(ColumnScanState &state, idx_t scan_count, Vector
 	function->scan_partial(*this, state, scan_count, result, result_offset);
 }
 
+bool ColumnSegment::Filter(ColumnScanState &state, idx_t scan_count, SelectionVector &sel, idx_t &approved_tuple_count,
+                           const TableFilter &filter) {
+	if (!function->filter) {
+		return false;
+	}
+	return function->filter(*this, state, scan_count, sel, approved_tuple_count, filter);
+}
+
 //===--------------------------------------------------------------------===//
 // Fetch
 //===--------------------------------------------------------------------===//
@@ -450,4 +458,33 @@ idx_t ColumnSegment::FilterSelection(SelectionVector &sel, Vector &result, const
 	}
 }
 
+
+void ColumnSegment::FilterDictionarySelection(SelectionVector &sel, idx_t &approved_tuple_count,
+                                              const SelectionVector &entries, idx_t entry_offset, Vector &dictionary,
+                                              idx_t dictionary_size, const TableFilter &filter,
+                                              vector<bool> &entry_passes) {
+	if (entry_passes.empty()) {
+		// evaluate the filter once for every entry in the dictionary
+		D_ASSERT(dictionary.GetVectorType() == VectorType::FLAT_VECTOR);
+		SelectionVector entry_sel;
+		idx_t entry_count = dictionary_size;
+		FilterSelection(entry_sel, dictionary, filter, entry_count, FlatVector::Validity(dictionary));
+		entry_passes.resize(dictionary_size, false);
+		for (idx_t i = 0; i < entry_count; i++) {
+			entry_passes[entry_sel.get_index(i)] = true;
+		}
+	}
+	// now select the rows that reference any of the entries that pass
+	SelectionVector new_sel(approved_tuple_count);
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		if (entry_passes[entries.get_index(entry_offset + idx)]) {
+			new_sel.set_index(result_count++, idx);
+		}
+	}
+	sel.Initialize(new_sel);
+	approved_tuple_count = result_count;
+}
+
 } // namespace duckdb
@@ -107,6 +107,8 @@ idx_t ListColumnData::ScanCount(ColumnScanState &state, Vector &result, idx_t co
 		D_ASSERT(child_entry.GetType().InternalType() == PhysicalType::STRUCT ||
 		         state.child_states[1].row_index + child_scan_count <= child_column->GetMaxEntry());
 		child_column->ScanCount(state.child_states[1], child_entry, child_scan_count);
+		// the child of a list vector is always flat
+		child_entry.Normalify(child_scan_count);
 	}
 
 	ListVector::SetListSize(result, child_scan_count);
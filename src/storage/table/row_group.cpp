@@ -7,6 +7,7 @@
 #include "duckdb/storage/table/standard_column_data.hpp"
 #include "duckdb/storage/table/update_segment.hpp"
 #include "duckdb/common/chrono.hpp"
+#include "duckdb/common/thread_metrics.hpp"
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/checkpoint/table_data_writer.hpp"
@@ -277,7 +278,15 @@ bool RowGroup::CheckZonemapSegments(RowGroupScanState &state) {
 			return false;
 		}
 	}
-
+	// check the statistics of the individual vector
+	for (auto &entry : state.parent.table_filters->filters) {
+		auto column_idx = entry.first;
+		auto base_column_idx = column_ids[column_idx];
+		if (!columns[base_column_idx]->CheckVectorZonemap(state.column_scans[column_idx], *entry.second)) {
+			NextVector(state);
+			return false;
+		}
+	}
 	return true;
 }
 
@@ -300,6 +309,7 @@ void RowGroup::TemplatedScan(Transaction *transaction, RowGroupScanState &state,
 		if (!CheckZonemapSegments(state)) {
 			continue;
 		}
+		ThreadMetrics::Get().rows_scanned += max_count;
 		// second, scan the version chunk manager to figure out which tuples to load for this transaction
 		idx_t count;
 		SelectionVector valid_sel(STANDARD_VECTOR_SIZE);
@@ -361,6 +371,11 @@ void RowGroup::TemplatedScan(Transaction *transaction, RowGroupScanState &state,
 				for (idx_t i = 0; i < table_filters->filters.size(); i++) {
 					auto tf_idx = adaptive_filter->permutation[i];
 					auto col_idx = column_ids[tf_idx];
+					if (approved_tuple_count == 0) {
+						// no rows remain: there is no need to scan the remaining filter columns
+						columns[col_idx]->Skip(state.column_scans[tf_idx]);
+						continue;
+					}
 					columns[col_idx]->Select(*transaction, state.vector_index, state.column_scans[tf_idx],
 					                         result.data[tf_idx], sel, approved_tuple_count,
 					                         *table_filters->filters[tf_idx]);
@@ -472,6 +487,19 @@ idx_t RowGroup::GetCommittedSelVector(transaction_t start_time, transaction_t tr
 	return info->GetCommittedSelVector(start_time, transaction_id, sel_vector, max_count);
 }
 
+idx_t RowGroup::GetVisibleRowCount(Transaction &transaction) {
+	if (!version_info) {
+		return count;
+	}
+	idx_t visible_count = 0;
+	SelectionVector sel_vector(STANDARD_VECTOR_SIZE);
+	for (idx_t vector_idx = 0; vector_idx * STANDARD_VECTOR_SIZE < count; vector_idx++) {
+		auto max_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - vector_idx * STANDARD_VECTOR_SIZE);
+		visible_count += GetSelVector(transaction, vector_idx, sel_vector, max_count);
+	}
+	return visible_count;
+}
+
 bool RowGroup::Fetch(Transaction &transaction, idx_t row) {
 	D_ASSERT(row < this->count);
 	lock_guard<mutex> lock(row_group_lock);
@@ -576,8 +604,7 @@ void RowGroup::RevertAppend(idx_t row_group_start) {
 	Verify();
 }
 
-void RowGroup::InitializeAppend(Transaction &transaction, RowGroupAppendState &append_state,
-                                idx_t remaining_append_count) {
+void RowGroup::InitializeAppend(RowGroupAppendState &append_state) {
 	append_state.row_group = this;
 	append_state.offset_in_row_group = this->count;
 	// for each column, initialize the append state
@@ -585,6 +612,11 @@ void RowGroup::InitializeAppend(Transaction &transaction, RowGroupAppendState &a
 	for (idx_t i = 0; i < columns.size(); i++) {
 		columns[i]->InitializeAppend(append_state.states[i]);
 	}
+}
+
+void RowGroup::InitializeAppend(Transaction &transaction, RowGroupAppendState &append_state,
+                                idx_t remaining_append_count) {
+	InitializeAppend(append_state);
 	// append the version info for this row_group
 	idx_t append_count = MinValue<idx_t>(remaining_append_count, RowGroup::ROW_GROUP_SIZE - this->count);
 	AppendVersionInfo(transaction, this->count, append_count, transaction.transaction_id);
@@ -652,20 +684,30 @@ RowGroupPointer RowGroup::Checkpoint(TableDataWriter &writer, vector<unique_ptr<
 
 	// checkpoint the individual columns of the row group
 	for (idx_t column_idx = 0; column_idx < columns.size(); column_idx++) {
-		auto &column = columns[column_idx];
-		ColumnCheckpointInfo checkpoint_info {writer.GetColumnCompressionType(column_idx)};
-		auto checkpoint_state = column->Checkpoint(*this, writer, checkpoint_info);
-		D_ASSERT(checkpoint_state);
+		states.push_back(CheckpointColumn(writer, column_idx));
+	}
+	return WriteToDisk(writer, states, global_stats);
+}
 
-		auto stats = checkpoint_state->GetStatistics();
-		D_ASSERT(stats);
+unique_ptr<ColumnCheckpointState> RowGroup::CheckpointColumn(TableDataWriter &writer, idx_t column_idx,
+                                                             ColumnCompressionChoices *previous_choices) {
+	auto &column = columns[column_idx];
+	ColumnCheckpointInfo checkpoint_info(writer.GetColumnCompressionType(column_idx), previous_choices);
+	auto checkpoint_state = column->Checkpoint(*this, writer, checkpoint_info);
+	D_ASSERT(checkpoint_state);
+	return checkpoint_state;
+}
 
+RowGroupPointer RowGroup::WriteToDisk(TableDataWriter &writer, vector<unique_ptr<ColumnCheckpointState>> &states,
+                                      vector<unique_ptr<BaseStatistics>> &global_stats) {
+	D_ASSERT(states.size() == columns.size());
+	for (idx_t column_idx = 0; column_idx < states.size(); column_idx++) {
+		auto stats = states[column_idx]->GetStatistics();
+		D_ASSERT(stats);
 		global_stats[column_idx]->Merge(*stats);
-		states.push_back(move(checkpoint_state));
 	}
 
 	// construct the row group pointer and write the column meta data to disk
-	D_ASSERT(states.size() == columns.size());
 	RowGroupPointer row_group_pointer;
 	row_group_pointer.row_start = start;
 	row_group_pointer.tuple_count = count;
@@ -235,6 +235,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 		}
 		// mark the tuples as committed
 		info->table->CommitAppend(commit_id, info->start_row, info->count);
+		info->table->info->last_commit_id = commit_id;
 		break;
 	}
 	case UndoFlags::DELETE_TUPLE: {
@@ -245,6 +246,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 		}
 		// mark the tuples as committed
 		info->vinfo->CommitDelete(commit_id, info->rows, info->count);
+		info->table->info->last_commit_id = commit_id;
 		break;
 	}
 	case UndoFlags::UPDATE_TUPLE: {
@@ -254,6 +256,7 @@ void CommitState::CommitEntry(UndoFlags type, data_ptr_t data) {
 			WriteUpdate(info);
 		}
 		info->version_number = commit_id;
+		info->segment->column_data.GetTableInfo().last_commit_id = commit_id;
 		break;
 	}
 	default:
@@ -53,6 +53,12 @@ void Transaction::PushDelete(DataTable *table, ChunkVectorInfo *vinfo, row_t row
 }
 
 void Transaction::PushAppend(DataTable *table, idx_t start_row, idx_t row_count) {
+	auto last_append = (AppendInfo *)undo_buffer.GetLastEntry(UndoFlags::INSERT_TUPLE);
+	if (last_append && last_append->table == table && last_append->start_row + last_append->count == start_row) {
+		// this append directly follows the previous one: extend it instead of creating a new entry
+		last_append->count += row_count;
+		return;
+	}
 	auto append_info = (AppendInfo *)undo_buffer.CreateEntry(UndoFlags::INSERT_TUPLE, sizeof(AppendInfo));
 	append_info->table = table;
 	append_info->start_row = start_row;
@@ -86,6 +92,18 @@ bool Transaction::AutomaticCheckpoint(DatabaseInstance &db) {
 	return expected_wal_size > config.checkpoint_wal_size;
 }
 
+void Transaction::Rollback() noexcept {
+	undo_buffer.Rollback();
+	EndDirectAppends();
+}
+
+void Transaction::EndDirectAppends() noexcept {
+	for (auto &table : direct_appends) {
+		table->EndDirectAppend(*this);
+	}
+	direct_appends.clear();
+}
+
 string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool checkpoint) noexcept {
 	this->commit_id = commit_id;
 	auto &storage_manager = StorageManager::GetStorageManager(db);
@@ -111,6 +129,7 @@ string Transaction::Commit(DatabaseInstance &db, transaction_t commit_id, bool c
 		}
 		storage.Commit(commit_state, *this, log, commit_id);
 		undo_buffer.Commit(iterator_state, log, commit_id);
+		EndDirectAppends();
 		if (log) {
 			// commit any sequences that were used to the WAL
 			for (auto &entry : sequence_usage) {
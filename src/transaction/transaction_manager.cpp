@@ -5,7 +5,9 @@
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -159,6 +161,41 @@ void TransactionManager::Checkpoint(ClientContext &context, bool force) {
 	storage.CreateCheckpoint();
 }
 
+void TransactionManager::Vacuum(ClientContext &context, const vector<TableCatalogEntry *> &tables) {
+	// vacuuming changes the row ids of the tables and throws away version info, no other transaction can be using it
+	auto lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	if (thread_is_checkpointing) {
+		throw TransactionException("Cannot VACUUM: another thread is checkpointing right now");
+	}
+	CheckpointLock checkpoint_lock(*this);
+	checkpoint_lock.Lock();
+	lock.reset();
+
+	vector<ClientLockWrapper> client_locks;
+	LockClients(client_locks, context);
+
+	lock = make_unique<lock_guard<mutex>>(transaction_lock);
+	auto current = &Transaction::GetTransaction(context);
+	if (current->ChangesMade()) {
+		throw TransactionException("Cannot VACUUM: the current transaction has transaction local changes");
+	}
+	// unlike a checkpoint this also applies to in-memory databases
+	bool other_transactions = !recently_committed_transactions.empty() || !old_transactions.empty();
+	for (auto &transaction : active_transactions) {
+		if (transaction.get() != current) {
+			other_transactions = true;
+		}
+	}
+	if (other_transactions) {
+		throw TransactionException("Cannot VACUUM: there are other transactions");
+	}
+	for (auto &table : tables) {
+		table->storage->Vacuum(*current);
+	}
+	auto &storage = StorageManager::GetStorageManager(context);
+	storage.VacuumCheckpoint();
+}
+
 bool TransactionManager::CanCheckpoint(Transaction *current) {
 	auto &storage_manager = StorageManager::GetStorageManager(db);
 	if (storage_manager.InMemory()) {
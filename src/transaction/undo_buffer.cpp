@@ -21,7 +21,7 @@ static idx_t AlignLength(idx_t len) {
 	return (len + 7) / 8 * 8;
 }
 
-UndoBuffer::UndoBuffer() {
+UndoBuffer::UndoBuffer() : last_type(UndoFlags::EMPTY_ENTRY), last_entry(nullptr) {
 	head = make_unique<UndoChunk>(0);
 	tail = head.get();
 }
@@ -63,7 +63,13 @@ data_ptr_t UndoBuffer::CreateEntry(UndoFlags type, idx_t len) {
 		new_chunk->next = move(head);
 		head = move(new_chunk);
 	}
-	return head->WriteEntry(type, len);
+	last_type = type;
+	last_entry = head->WriteEntry(type, len);
+	return last_entry;
+}
+
+data_ptr_t UndoBuffer::GetLastEntry(UndoFlags type) {
+	return last_type == type ? last_entry : nullptr;
 }
 
 template <class T>
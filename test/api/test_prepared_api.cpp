@@ -1,5 +1,6 @@
 #include "catch.hpp"
 #include "test_helpers.hpp"
+#include "duckdb/main/prepared_statement_cache.hpp"
 
 using namespace duckdb;
 using namespace std;
@@ -475,3 +476,94 @@ TEST_CASE("Test ambiguous prepared statement parameter types", "[api]") {
 	result = prep->Execute("hello");
 	REQUIRE(CHECK_COLUMN(result, 0, {"hello"}));
 }
+
+TEST_CASE("Test sharing plans of prepared statements between connections", "[api]") {
+	unique_ptr<QueryResult> result;
+	DBConfig config;
+	config.prepared_statement_cache_size = 4;
+	DuckDB db(nullptr, &config);
+	Connection con(db);
+	Connection con2(db);
+	auto &cache = db.instance->GetPreparedStatementCache();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE a (i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (11), (12), (13)"));
+
+	// the plan is returned to the cache when the prepared statement is destroyed
+	auto prepared = con.Prepare("SELECT COUNT(*) FROM a WHERE i>$1");
+	REQUIRE(prepared->success);
+	auto plan = prepared->data.get();
+	result = prepared->Execute(11);
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	prepared.reset();
+	REQUIRE(cache.Count() == 1);
+
+	// another connection preparing the same query (modulo whitespace and comments) reuses the plan
+	prepared = con2.Prepare("SELECT  COUNT(*)\tFROM a /* comment */ WHERE i>$1  ");
+	REQUIRE(prepared->success);
+	REQUIRE(prepared->data.get() == plan);
+	REQUIRE(cache.Count() == 0);
+	// while the plan is in use it cannot be handed out again
+	auto prepared2 = con.Prepare("SELECT COUNT(*) FROM a WHERE i>$1");
+	REQUIRE(prepared2->data.get() != plan);
+	result = prepared->Execute(12);
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	result = prepared2->Execute(10);
+	REQUIRE(CHECK_COLUMN(result, 0, {3}));
+	prepared.reset();
+	prepared2.reset();
+	REQUIRE(cache.Count() == 2);
+
+	// string literals are not normalized
+	result = con.Query("SELECT COUNT(*) FROM a WHERE i::VARCHAR<>'1  1' AND i>$1", 11);
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	result = con.Query("SELECT COUNT(*) FROM a WHERE i::VARCHAR<>'1 1' AND i>$1", 11);
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	REQUIRE(cache.Count() == 4);
+
+	// the cache evicts plans beyond its capacity
+	result = con.Query("SELECT SUM(i) FROM a WHERE i>$1", 11);
+	REQUIRE(CHECK_COLUMN(result, 0, {25}));
+	REQUIRE(cache.Count() == 3);
+
+	// catalog changes invalidate the cached plans
+	REQUIRE_NO_FAIL(con.Query("ALTER TABLE a ADD COLUMN j INTEGER"));
+	prepared = con2.Prepare("SELECT * FROM a WHERE i>$1");
+	REQUIRE(cache.Count() == 0);
+	prepared.reset();
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE b (k INTEGER)"));
+	prepared = con2.Prepare("SELECT * FROM a WHERE i>$1");
+	result = prepared->Execute(12);
+	REQUIRE(CHECK_COLUMN(result, 0, {13}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value()}));
+	prepared.reset();
+	REQUIRE(cache.Count() == 1);
+
+	// temporary tables of a connection can shadow the tables the cached plans were bound to
+	REQUIRE_NO_FAIL(con2.Query("CREATE TEMPORARY TABLE a (x VARCHAR)"));
+	REQUIRE_NO_FAIL(con2.Query("INSERT INTO a VALUES ('temp')"));
+	prepared = con.Prepare("SELECT COUNT(*) FROM a WHERE i>$1");
+	result = prepared->Execute(12);
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	prepared.reset();
+	prepared = con2.Prepare("SELECT * FROM a");
+	REQUIRE(prepared->success);
+	result = prepared->Execute();
+	REQUIRE(CHECK_COLUMN(result, 0, {"temp"}));
+	prepared.reset();
+	result = con2.Query("SELECT COUNT(*) FROM a WHERE i>$1", 12);
+	REQUIRE_FAIL(result);
+	result = con.Query("SELECT COUNT(*) FROM a WHERE i>$1", 12);
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+
+	// changing a global setting clears the cache
+	REQUIRE(cache.Count() > 0);
+	REQUIRE_NO_FAIL(con.Query("SET default_order='desc'"));
+	REQUIRE(cache.Count() == 0);
+	result = con.Query("SELECT i FROM a WHERE i>$1 ORDER BY i", 11);
+	REQUIRE(CHECK_COLUMN(result, 0, {13, 12}));
+	REQUIRE_NO_FAIL(con.Query("SET prepared_statement_cache_size=0"));
+	result = con.Query("SELECT i FROM a WHERE i>$1 ORDER BY i", 11);
+	REQUIRE(CHECK_COLUMN(result, 0, {13, 12}));
+	REQUIRE(cache.Count() == 0);
+}
@@ -1,7 +1,9 @@
 #include "catch.hpp"
 #include "test_helpers.hpp"
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 using namespace duckdb;
 using namespace std;
@@ -23,3 +25,25 @@ TEST_CASE("Test query profiler", "[api]") {
 	output = con.GetProfilingInformation(ProfilerPrintFormat::JSON);
 	REQUIRE(output.size() > 0);
 }
+
+TEST_CASE("Test the memory and I/O metrics in the JSON output of the query profiler", "[api]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto profiling_output = TestCreatePath("profiler_metrics.json");
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA enable_profiling='json'"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA profiling_output='" + profiling_output + "'"));
+	REQUIRE_NO_FAIL(con.Query("SELECT i FROM range(100000) tbl(i) ORDER BY i DESC LIMIT 1"));
+
+	// the profiler writes its output when the query finishes
+	ifstream file(profiling_output);
+	stringstream buffer;
+	buffer << file.rdbuf();
+	auto output = buffer.str();
+	REQUIRE(output.find("\"TOP_N\"") != string::npos);
+	REQUIRE(output.find("\"peak_memory\":") != string::npos);
+	REQUIRE(output.find("\"bytes_spilled\":") != string::npos);
+	REQUIRE(output.find("\"bytes_reloaded\":") != string::npos);
+	REQUIRE(output.find("\"pin_hits\":") != string::npos);
+	REQUIRE(output.find("\"bytes_read\":") != string::npos);
+}
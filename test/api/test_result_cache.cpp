@@ -0,0 +1,151 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb/main/result_cache.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+TEST_CASE("Test caching the results of repeated queries", "[api]") {
+	unique_ptr<QueryResult> result;
+	DBConfig config;
+	config.result_cache_size = 1 << 20;
+	DuckDB db(nullptr, &config);
+	Connection con(db);
+	Connection con2(db);
+	auto &cache = db.instance->GetResultCache();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE a (i INTEGER, s VARCHAR)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (11, 'hello'), (12, 'world'), (13, NULL)"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE b (j INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO b VALUES (1)"));
+
+	// the result is cached, and returned to any connection running the same query
+	result = con.Query("SELECT i, s FROM a ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {11, 12, 13}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"hello", "world", Value()}));
+	REQUIRE(cache.Count() == 1);
+	result = con2.Query("SELECT  i, s\tFROM a /* comment */ ORDER BY i ");
+	REQUIRE(CHECK_COLUMN(result, 0, {11, 12, 13}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"hello", "world", Value()}));
+	REQUIRE(result->names == vector<string> {"i", "s"});
+	REQUIRE(cache.Count() == 1);
+
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE(cache.Count() == 2);
+
+	// a commit to a table invalidates the results that depend on it, but not the other results
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (14, 'x')"));
+	result = con2.Query("SELECT i, s FROM a ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {11, 12, 13, 14}));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	REQUIRE(cache.Count() == 2);
+
+	REQUIRE_NO_FAIL(con.Query("UPDATE a SET i=i+1 WHERE i=14"));
+	result = con2.Query("SELECT i, s FROM a ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {11, 12, 13, 15}));
+	REQUIRE_NO_FAIL(con.Query("DELETE FROM a WHERE i=15"));
+	result = con2.Query("SELECT i, s FROM a ORDER BY i");
+	REQUIRE(CHECK_COLUMN(result, 0, {11, 12, 13}));
+
+	// joins depend on all of the tables they scan
+	result = con.Query("SELECT i + j FROM a, b ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {12, 13, 14}));
+	REQUIRE_NO_FAIL(con.Query("UPDATE b SET j=2"));
+	result = con.Query("SELECT i + j FROM a, b ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {13, 14, 15}));
+
+	// uncommitted changes are only visible to the transaction that made them
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO b VALUES (3)"));
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+
+	// a transaction that started before a commit does not see its result
+	REQUIRE_NO_FAIL(con2.Query("BEGIN TRANSACTION"));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO b VALUES (10)"));
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {15}));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	REQUIRE_NO_FAIL(con2.Query("COMMIT"));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {15}));
+
+	// temporary tables can shadow the tables that a cached result was computed from
+	REQUIRE_NO_FAIL(con2.Query("CREATE TEMPORARY TABLE b (j INTEGER)"));
+	result = con2.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value()}));
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {15}));
+	REQUIRE_NO_FAIL(con2.Query("DROP TABLE b"));
+
+	// catalog changes invalidate all results
+	REQUIRE(cache.Count() > 0);
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE c (k INTEGER)"));
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {15}));
+	REQUIRE(cache.Count() == 1);
+
+	// results that do not only depend on the contents of the tables are not cached
+	REQUIRE_NO_FAIL(con.Query("CREATE SEQUENCE seq"));
+	cache.Clear();
+	result = con.Query("SELECT random() < 2 FROM b LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {true}));
+	result = con.Query("SELECT now() IS NOT NULL");
+	REQUIRE(CHECK_COLUMN(result, 0, {true}));
+	result = con.Query("SELECT * FROM range(3)");
+	REQUIRE(CHECK_COLUMN(result, 0, {0, 1, 2}));
+	result = con.Query("SELECT nextval('seq') FROM b ORDER BY 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {1, 2, 3}));
+	REQUIRE(cache.Count() == 0);
+	result = con.Query("SELECT age(TIMESTAMP '2000-01-01') > INTERVAL 1 DAY, current_schema() FROM b LIMIT 1");
+	REQUIRE(CHECK_COLUMN(result, 0, {true}));
+	REQUIRE(CHECK_COLUMN(result, 1, {"main"}));
+	result = con.Query("SELECT txid_current() >= 0");
+	REQUIRE(CHECK_COLUMN(result, 0, {true}));
+	REQUIRE(cache.Count() == 0);
+
+	// queries that fail to parse do not leave the transaction of the lookup open
+	REQUIRE_FAIL(con.Query("SELEC 42"));
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+
+	// results larger than the cache are not cached
+	result = con.Query("SELECT i::VARCHAR || repeat('x', 1000) FROM range(2000) t(i)");
+	REQUIRE(result->success);
+	REQUIRE_NO_FAIL(
+	    con.Query("CREATE TABLE big AS SELECT i::VARCHAR || repeat('x', 1000) AS v FROM range(2000) t(i)"));
+	result = con.Query("SELECT * FROM big");
+	REQUIRE(result->success);
+	REQUIRE(cache.Count() == 0);
+
+	// the least recently used results are evicted when the cache is full
+	REQUIRE_NO_FAIL(con.Query("SET result_cache_size='64KB'"));
+	for (idx_t i = 0; i < 10; i++) {
+		result = con.Query("SELECT v FROM big WHERE v LIKE '" + to_string(i) + "%' ORDER BY v LIMIT 10");
+		REQUIRE(result->success);
+		REQUIRE(cache.CachedBytes() <= 64000);
+	}
+	REQUIRE(cache.Count() > 0);
+	REQUIRE(cache.Count() < 10);
+	result = con.Query("SELECT COUNT(*) FROM big WHERE v LIKE '9%'");
+	REQUIRE(CHECK_COLUMN(result, 0, {111}));
+
+	// the cache can be disabled
+	REQUIRE_NO_FAIL(con.Query("SET result_cache_size='0B'"));
+	REQUIRE(cache.Count() == 0);
+	result = con.Query("SELECT SUM(j) FROM b");
+	REQUIRE(CHECK_COLUMN(result, 0, {15}));
+	REQUIRE(cache.Count() == 0);
+}
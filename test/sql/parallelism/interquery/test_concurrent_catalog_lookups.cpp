@@ -0,0 +1,132 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace duckdb;
+using namespace std;
+
+#define CONCURRENT_LOOKUP_THREAD_COUNT 4
+#define CONCURRENT_LOOKUP_ITERATIONS   20
+
+static void LookupTables(DuckDB *db, atomic<bool> *finished, bool *correct) {
+	Connection con(*db);
+	*correct = true;
+	while (!*finished) {
+		// the stable table is always found, the table that is being recreated is either found or not
+		auto result = con.Query("SELECT COUNT(*) FROM stable");
+		if (!CHECK_COLUMN(result, 0, {3})) {
+			*correct = false;
+		}
+		result = con.Query("SELECT SUM(i) FROM churn");
+		if (result->success && !CHECK_COLUMN(result, 0, {6})) {
+			*correct = false;
+		}
+		// within a transaction, lookups always see the same version of the catalog
+		con.Query("BEGIN TRANSACTION");
+		auto first = con.Query("SELECT SUM(i) FROM churn");
+		auto second = con.Query("SELECT SUM(i) FROM churn");
+		con.Query("COMMIT");
+		if (first->success != second->success) {
+			*correct = false;
+		}
+	}
+}
+
+TEST_CASE("Concurrent catalog lookups while tables are created and dropped", "[interquery]") {
+	DuckDB db(nullptr);
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE stable AS SELECT * FROM range(3) tbl(i)"));
+
+	atomic<bool> finished(false);
+	bool correct[CONCURRENT_LOOKUP_THREAD_COUNT];
+	thread threads[CONCURRENT_LOOKUP_THREAD_COUNT];
+	for (idx_t i = 0; i < CONCURRENT_LOOKUP_THREAD_COUNT; i++) {
+		threads[i] = thread(LookupTables, &db, &finished, correct + i);
+	}
+	for (idx_t i = 0; i < CONCURRENT_LOOKUP_ITERATIONS; i++) {
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE churn AS SELECT * FROM range(4) tbl(i)"));
+		REQUIRE_NO_FAIL(con.Query("ALTER TABLE churn RENAME TO churn_renamed"));
+		REQUIRE_NO_FAIL(con.Query("ALTER TABLE churn_renamed RENAME TO churn"));
+		REQUIRE_NO_FAIL(con.Query("DROP TABLE churn"));
+	}
+	finished = true;
+	for (idx_t i = 0; i < CONCURRENT_LOOKUP_THREAD_COUNT; i++) {
+		threads[i].join();
+		REQUIRE(correct[i]);
+	}
+}
+
+TEST_CASE("Catalog lookups see the catalog as of the start of the transaction", "[interquery]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	Connection con2(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT 42 AS i"));
+	// warm up the lookups of both connections
+	result = con2.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {42}));
+
+	// a table dropped after our transaction started is still visible to us
+	REQUIRE_NO_FAIL(con2.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con2.Query("SELECT 1"));
+	REQUIRE_NO_FAIL(con.Query("DROP TABLE integers"));
+	result = con2.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {42}));
+	REQUIRE_FAIL(con.Query("SELECT * FROM integers"));
+	REQUIRE_NO_FAIL(con2.Query("COMMIT"));
+	REQUIRE_FAIL(con2.Query("SELECT * FROM integers"));
+
+	// a table created after our transaction started is not
+	REQUIRE_NO_FAIL(con2.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con2.Query("SELECT 1"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT 84 AS i"));
+	result = con.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {84}));
+	REQUIRE_FAIL(con2.Query("SELECT * FROM integers"));
+	REQUIRE_NO_FAIL(con2.Query("ROLLBACK"));
+	result = con2.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {84}));
+
+	// uncommitted drops are only visible to the transaction that made them
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con.Query("DROP TABLE integers"));
+	REQUIRE_FAIL(con.Query("SELECT * FROM integers"));
+	result = con2.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {84}));
+	REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+	result = con.Query("SELECT * FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {84}));
+}
+
+TEST_CASE("Catalog lookups after many names were created and dropped", "[interquery]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	Connection con2(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE stable AS SELECT 42 AS i"));
+	// dropped names and rolled back names are removed from the lookup index, which is rebuilt along the way
+	for (idx_t i = 0; i < 200; i++) {
+		auto name = "dropped_" + to_string(i);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE " + name + " AS SELECT " + to_string(i) + " AS i"));
+		result = con2.Query("SELECT i FROM " + name);
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::INTEGER(i)}));
+		REQUIRE_NO_FAIL(con.Query("DROP TABLE " + name));
+		REQUIRE_FAIL(con2.Query("SELECT i FROM " + name));
+
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE rolled_back_" + to_string(i) + " AS SELECT 1 AS i"));
+		REQUIRE_NO_FAIL(con.Query("ROLLBACK"));
+
+		result = con2.Query("SELECT i FROM stable");
+		REQUIRE(CHECK_COLUMN(result, 0, {42}));
+	}
+	REQUIRE_FAIL(con2.Query("SELECT * FROM rolled_back_0"));
+	// removed names can be created again
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE dropped_0 AS SELECT 84 AS i"));
+	result = con2.Query("SELECT i FROM dropped_0");
+	REQUIRE(CHECK_COLUMN(result, 0, {84}));
+}
@@ -112,3 +112,51 @@ TEST_CASE("Concurrent append", "[interquery][.]") {
 	REQUIRE(CHECK_COLUMN(result, 1,
 	                     {Value::BIGINT(3 * CONCURRENT_APPEND_THREAD_COUNT * CONCURRENT_APPEND_INSERT_ELEMENTS)}));
 }
+
+static constexpr int CONCURRENT_BULK_INSERT_ROWS = 300000;
+
+static void bulk_insert(DuckDB *db, bool fail, bool *success) {
+	Connection con(*db);
+	// the failing insert hits a NULL in its last row, after most of its rows have been appended
+	auto result = con.Query("INSERT INTO integers SELECT CASE WHEN i = " +
+	                        to_string(fail ? CONCURRENT_BULK_INSERT_ROWS - 1 : -1) + " THEN NULL ELSE i END FROM range(" +
+	                        to_string(CONCURRENT_BULK_INSERT_ROWS) + ") t(i)");
+	*success = result->success;
+}
+
+TEST_CASE("Concurrent bulk inserts of which one is rolled back", "[interquery]") {
+	unique_ptr<QueryResult> result;
+	auto db_path = TestCreatePath("concurrent_bulk_insert.db");
+	DeleteDatabase(db_path);
+	{
+		DuckDB db(db_path);
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER NOT NULL)"));
+
+		for (idx_t iteration = 1; iteration <= 3; iteration++) {
+			bool succeeded = false, failed = true;
+			thread succeeding_insert(bulk_insert, &db, false, &succeeded);
+			thread failing_insert(bulk_insert, &db, true, &failed);
+			succeeding_insert.join();
+			failing_insert.join();
+			REQUIRE(succeeded);
+			REQUIRE(!failed);
+
+			// only the rows of the successful inserts are visible
+			result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+			REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(iteration * CONCURRENT_BULK_INSERT_ROWS)}));
+			REQUIRE(CHECK_COLUMN(result, 1,
+			                     {Value::HUGEINT(iteration * CONCURRENT_BULK_INSERT_ROWS *
+			                                     (CONCURRENT_BULK_INSERT_ROWS - 1) / 2)}));
+		}
+		REQUIRE_NO_FAIL(con.Query("CHECKPOINT"));
+	}
+	// the rows of the failed inserts do not come back when the database is reloaded
+	DuckDB db(db_path);
+	Connection con(db);
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(3 * CONCURRENT_BULK_INSERT_ROWS)}));
+	REQUIRE(CHECK_COLUMN(result, 1,
+	                     {Value::HUGEINT(3 * idx_t(CONCURRENT_BULK_INSERT_ROWS) * (CONCURRENT_BULK_INSERT_ROWS - 1) / 2)}));
+	DeleteDatabase(db_path);
+}
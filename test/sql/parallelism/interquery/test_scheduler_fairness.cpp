@@ -0,0 +1,77 @@
+#include "catch.hpp"
+#include "test_helpers.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+using namespace duckdb;
+using namespace std;
+
+class CountingTask : public Task {
+public:
+	explicit CountingTask(idx_t &count) : count(count) {
+	}
+
+	TaskExecutionResult Execute(TaskExecutionMode mode) override {
+		count++;
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+private:
+	idx_t &count;
+};
+
+TEST_CASE("Producers receive a share of the tasks proportional to their priority", "[interquery]") {
+	DBConfig config;
+	// no background threads: all tasks are executed by ExecuteTasks in the order the scheduler picks them
+	config.maximum_threads = 1;
+	DuckDB db(nullptr, &config);
+	auto &scheduler = TaskScheduler::GetScheduler(*db.instance);
+
+	idx_t low_count = 0;
+	idx_t high_count = 0;
+	auto low = scheduler.CreateProducer(1);
+	auto high = scheduler.CreateProducer(3);
+	for (idx_t i = 0; i < 100; i++) {
+		scheduler.ScheduleTask(*low, make_unique<CountingTask>(low_count));
+		scheduler.ScheduleTask(*high, make_unique<CountingTask>(high_count));
+	}
+	// while both producers have tasks, the high priority producer gets three times as many of them
+	scheduler.ExecuteTasks(40);
+	REQUIRE(low_count + high_count == 40);
+	REQUIRE(low_count >= 9);
+	REQUIRE(low_count <= 11);
+
+	// once the high priority producer runs out of tasks, the low priority producer gets all threads
+	scheduler.ExecuteTasks(160);
+	REQUIRE(low_count == 100);
+	REQUIRE(high_count == 100);
+}
+
+TEST_CASE("A producer that was idle does not get ahead of the other producers", "[interquery]") {
+	DBConfig config;
+	config.maximum_threads = 1;
+	DuckDB db(nullptr, &config);
+	auto &scheduler = TaskScheduler::GetScheduler(*db.instance);
+
+	idx_t busy_count = 0;
+	idx_t idle_count = 0;
+	auto busy = scheduler.CreateProducer(1);
+	auto idle = scheduler.CreateProducer(1);
+	for (idx_t i = 0; i < 100; i++) {
+		scheduler.ScheduleTask(*busy, make_unique<CountingTask>(busy_count));
+	}
+	scheduler.ExecuteTasks(50);
+	REQUIRE(busy_count == 50);
+
+	// the idle producer is not credited for the 50 tasks it did not use: from now on, both get half of the tasks
+	for (idx_t i = 0; i < 100; i++) {
+		scheduler.ScheduleTask(*idle, make_unique<CountingTask>(idle_count));
+	}
+	scheduler.ExecuteTasks(20);
+	REQUIRE(busy_count >= 59);
+	REQUIRE(busy_count <= 61);
+	REQUIRE(idle_count + busy_count == 70);
+
+	scheduler.ExecuteTasks(130);
+	REQUIRE(busy_count == 100);
+	REQUIRE(idle_count == 100);
+}